@@ -18,13 +18,16 @@
 #include <stl2/detail/algorithm/adjacent_find.hpp>
 #include <stl2/detail/algorithm/all_of.hpp>
 #include <stl2/detail/algorithm/any_of.hpp>
+#include <stl2/detail/algorithm/async.hpp>
 #include <stl2/detail/algorithm/binary_search.hpp>
+#include <stl2/detail/algorithm/bitpack.hpp>
 #include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/copy_backward.hpp>
 #include <stl2/detail/algorithm/copy_if.hpp>
 #include <stl2/detail/algorithm/copy_n.hpp>
 #include <stl2/detail/algorithm/count.hpp>
 #include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/delta_encode.hpp>
 #include <stl2/detail/algorithm/equal.hpp>
 #include <stl2/detail/algorithm/equal_range.hpp>
 #include <stl2/detail/algorithm/fill.hpp>
@@ -61,6 +64,7 @@
 #include <stl2/detail/algorithm/next_permutation.hpp>
 #include <stl2/detail/algorithm/none_of.hpp>
 #include <stl2/detail/algorithm/nth_element.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
 #include <stl2/detail/algorithm/partial_sort.hpp>
 #include <stl2/detail/algorithm/partial_sort_copy.hpp>
 #include <stl2/detail/algorithm/partition.hpp>
@@ -69,6 +73,7 @@
 #include <stl2/detail/algorithm/pop_heap.hpp>
 #include <stl2/detail/algorithm/prev_permutation.hpp>
 #include <stl2/detail/algorithm/push_heap.hpp>
+#include <stl2/detail/algorithm/reduce.hpp>
 #include <stl2/detail/algorithm/remove.hpp>
 #include <stl2/detail/algorithm/remove_copy.hpp>
 #include <stl2/detail/algorithm/remove_copy_if.hpp>
@@ -88,14 +93,20 @@
 #include <stl2/detail/algorithm/set_symmetric_difference.hpp>
 #include <stl2/detail/algorithm/set_union.hpp>
 #include <stl2/detail/algorithm/shuffle.hpp>
+#include <stl2/detail/algorithm/shuffle_n.hpp>
 #include <stl2/detail/algorithm/sort.hpp>
 #include <stl2/detail/algorithm/sort_heap.hpp>
 #include <stl2/detail/algorithm/stable_partition.hpp>
 #include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/algorithm/streamvbyte_encode.hpp>
+#include <stl2/detail/algorithm/string_sort.hpp>
 #include <stl2/detail/algorithm/swap_ranges.hpp>
 #include <stl2/detail/algorithm/transform.hpp>
 #include <stl2/detail/algorithm/unique.hpp>
 #include <stl2/detail/algorithm/unique_copy.hpp>
 #include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/algorithm/utf8_transcode.hpp>
+#include <stl2/detail/algorithm/utf8_validate.hpp>
+#include <stl2/detail/algorithm/varint_encode.hpp>
 
 #endif
@@ -0,0 +1,307 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_ASYNC_HPP
+#define STL2_DETAIL_ALGORITHM_ASYNC_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/copy_if.hpp>
+#include <stl2/detail/algorithm/reduce.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Asynchronous algorithms [Extension]
+//
+// ext::async::sort(args...) and friends take the same arguments as their
+// synchronous namesakes, optionally preceded by an executor, and return
+// at once with an operation that completes when the algorithm has run on
+// the executor - by default a thread pool shared by the library. An
+// operation is awaitable, resuming the awaiting coroutine on the thread
+// that finished the work; it can also be waited for with get().
+//
+// Ranges passed as lvalues are referenced, and must outlive the
+// operation; every other argument is moved or copied into it.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext::async {
+		// A move-only nullary function to be run by an executor.
+		class task {
+		private:
+			struct base {
+				virtual ~base() = default;
+				virtual void run() = 0;
+			};
+
+			template<class F>
+			struct impl final : base {
+				F f_;
+				explicit impl(F&& f) : f_(std::move(f)) {}
+				void run() override { f_(); }
+			};
+
+			std::unique_ptr<base> impl_;
+		public:
+			template<class F>
+			requires (!same_as<__uncvref<F>, task>) && invocable<std::decay_t<F>&> &&
+				move_constructible<std::decay_t<F>>
+			explicit task(F&& f)
+			: impl_{std::make_unique<impl<std::decay_t<F>>>(std::decay_t<F>(std::forward<F>(f)))} {}
+
+			void operator()() { impl_->run(); }
+		};
+
+		template<class E>
+		META_CONCEPT executor = requires(E& e, task t) {
+			e.execute(std::move(t));
+		};
+
+		// A fixed set of threads that run tasks in submission order. The
+		// destructor runs the tasks already submitted, then joins.
+		class thread_pool {
+		private:
+			std::mutex m_;
+			std::condition_variable cv_;
+			std::deque<task> queue_;
+			bool stop_ = false;
+			std::vector<std::thread> threads_;
+
+			void work() noexcept {
+				std::unique_lock lock{m_};
+				for (;;) {
+					cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+					if (queue_.empty()) return;
+					auto t = std::move(queue_.front());
+					queue_.pop_front();
+					lock.unlock();
+					t();
+					lock.lock();
+				}
+			}
+
+			void shutdown() noexcept {
+				{
+					std::lock_guard lock{m_};
+					stop_ = true;
+				}
+				cv_.notify_all();
+				for (auto& t : threads_) {
+					t.join();
+				}
+			}
+		public:
+			// Zero threads means std::thread::hardware_concurrency().
+			explicit thread_pool(unsigned threads = 0) {
+				if (!threads) threads = std::thread::hardware_concurrency();
+				if (!threads) threads = 1;
+				threads_.reserve(threads);
+				try {
+					for (unsigned i = 0; i < threads; ++i) {
+						threads_.emplace_back([this] { work(); });
+					}
+				} catch (...) {
+					shutdown();
+					throw;
+				}
+			}
+
+			thread_pool(const thread_pool&) = delete;
+			thread_pool& operator=(const thread_pool&) = delete;
+
+			~thread_pool() { shutdown(); }
+
+			void execute(task t) {
+				{
+					std::lock_guard lock{m_};
+					queue_.push_back(std::move(t));
+				}
+				cv_.notify_one();
+			}
+		};
+
+		inline thread_pool& default_pool() {
+			static thread_pool pool;
+			return pool;
+		}
+	} // namespace ext::async
+
+	namespace detail {
+		// The result of an asynchronous operation, shared by the operation
+		// and the task computing it. waiter_ is null while the work is
+		// pending, the address of a suspended coroutine once one awaits it,
+		// and this once the result is ready.
+		template<class T>
+		class __async_state {
+		private:
+			std::atomic<void*> waiter_{nullptr};
+			std::optional<T> value_;
+			std::exception_ptr error_;
+
+			void* done() noexcept { return this; }
+
+			void complete() noexcept {
+				auto* w = waiter_.exchange(done(), std::memory_order_acq_rel);
+				waiter_.notify_all();
+				if (w) std::coroutine_handle<>::from_address(w).resume();
+			}
+		public:
+			template<class F>
+			void run(F& f) noexcept {
+				try {
+					value_.emplace(f());
+				} catch (...) {
+					error_ = std::current_exception();
+				}
+				complete();
+			}
+
+			// The task was destroyed without running.
+			void abandon() noexcept {
+				error_ = std::make_exception_ptr(
+					std::future_error{std::future_errc::broken_promise});
+				complete();
+			}
+
+			bool ready() noexcept {
+				return waiter_.load(std::memory_order_acquire) == done();
+			}
+
+			// Registers h to be resumed on completion; false if the result
+			// is already ready.
+			bool suspend(std::coroutine_handle<> h) noexcept {
+				void* expected = nullptr;
+				return waiter_.compare_exchange_strong(expected, h.address(),
+					std::memory_order_acq_rel, std::memory_order_acquire);
+			}
+
+			void wait() noexcept {
+				for (auto* w = waiter_.load(std::memory_order_acquire); w != done();
+					w = waiter_.load(std::memory_order_acquire))
+				{
+					waiter_.wait(w, std::memory_order_acquire);
+				}
+			}
+
+			T get() {
+				wait();
+				if (error_) std::rethrow_exception(error_);
+				return std::move(*value_);
+			}
+		};
+
+		template<class T, class F>
+		struct __async_job {
+			std::shared_ptr<__async_state<T>> state_;
+			F f_;
+
+			__async_job(std::shared_ptr<__async_state<T>> state, F&& f)
+			: state_{std::move(state)}, f_(std::move(f)) {}
+			__async_job(__async_job&&) = default;
+			__async_job& operator=(__async_job&&) = delete;
+
+			~__async_job() {
+				if (state_) state_->abandon();
+			}
+
+			void operator()() {
+				auto state = std::move(state_);
+				state->run(f_);
+			}
+		};
+
+		// Lvalue ranges are captured by reference; everything else by value.
+		template<class T>
+		using __async_capture_t = meta::if_c<std::is_lvalue_reference_v<T> &&
+			range<T>, T, std::decay_t<T>>;
+	} // namespace detail
+
+	namespace ext::async {
+		template<class T>
+		class operation {
+		private:
+			std::shared_ptr<detail::__async_state<T>> state_;
+		public:
+			operation() = default;
+			explicit operation(std::shared_ptr<detail::__async_state<T>> state) noexcept
+			: state_{std::move(state)} {}
+
+			bool valid() const noexcept { return state_ != nullptr; }
+			bool ready() const noexcept {
+				STL2_EXPECT(valid());
+				return state_->ready();
+			}
+			void wait() const noexcept {
+				STL2_EXPECT(valid());
+				state_->wait();
+			}
+			// Waits for the result, then returns it or rethrows the exception
+			// that ended the algorithm. At most once.
+			T get() {
+				STL2_EXPECT(valid());
+				return state_->get();
+			}
+
+			bool await_ready() const noexcept { return ready(); }
+			bool await_suspend(std::coroutine_handle<> h) noexcept {
+				return state_->suspend(h);
+			}
+			T await_resume() { return get(); }
+		};
+
+		template<class Fn>
+		struct __async_fn {
+			template<executor E, class... Args>
+			requires invocable<const Fn&, detail::__async_capture_t<Args>...>
+			operation<invoke_result_t<const Fn&, detail::__async_capture_t<Args>...>>
+			operator()(E& e, Args&&... args) const {
+				using T = invoke_result_t<const Fn&, detail::__async_capture_t<Args>...>;
+				auto state = std::make_shared<detail::__async_state<T>>();
+				auto f = [args = std::tuple<detail::__async_capture_t<Args>...>(
+					std::forward<Args>(args)...)]() mutable -> T {
+					return std::apply(Fn{}, std::move(args));
+				};
+				e.execute(task{detail::__async_job<T, decltype(f)>{state, std::move(f)}});
+				return operation<T>{std::move(state)};
+			}
+
+			template<class... Args>
+			requires invocable<const Fn&, detail::__async_capture_t<Args>...>
+			operation<invoke_result_t<const Fn&, detail::__async_capture_t<Args>...>>
+			operator()(Args&&... args) const {
+				return (*this)(default_pool(), std::forward<Args>(args)...);
+			}
+		};
+
+		inline constexpr __async_fn<__sort_fn> sort{};
+		inline constexpr __async_fn<__stable_sort_fn> stable_sort{};
+		inline constexpr __async_fn<__transform_fn> transform{};
+		inline constexpr __async_fn<ext::__reduce_fn> reduce{};
+		inline constexpr __async_fn<__copy_if_fn> copy_if{};
+	} // namespace ext::async
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -41,6 +41,43 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), end(r), value, static_cast<Comp&&>(comp),
 				static_cast<Proj&&>(proj));
 		}
+
+		// Extension: with a three-way comparator, the search stops at the
+		// first equivalent element it probes.
+		template<forward_iterator I, sentinel_for<I> S, class T, class Comp,
+			class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*, projected<I, Proj>>
+		constexpr bool operator()(I first, S last, const T& value, Comp comp,
+			Proj proj = {}) const
+		{
+			auto dist = distance(first, std::move(last));
+			while (0 < dist) {
+				auto half = dist / 2;
+				auto middle = next(first, half);
+				auto c = detail::__compare_3way(comp,
+					__stl2::invoke(proj, *middle), value);
+				if (c < 0) {
+					first = std::move(middle);
+					++first;
+					dist -= half + 1;
+				} else if (c > 0) {
+					dist = half;
+				} else {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		template<forward_range R, class T, class Comp, class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*,
+			projected<iterator_t<R>, Proj>>
+		constexpr bool operator()(R&& r, const T& value, Comp comp,
+			Proj proj = {}) const
+		{
+			return (*this)(begin(r), end(r), value, static_cast<Comp&&>(comp),
+				static_cast<Proj&&>(proj));
+		}
 	};
 
 	inline constexpr __binary_search_fn binary_search{};
@@ -0,0 +1,92 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_BITPACK_HPP
+#define STL2_DETAIL_ALGORITHM_BITPACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// bitpack [Extension]
+//
+// Writes each integer of the input, less base, as a bits-wide field of a
+// little-endian bit string: field i occupies bits [i * bits, (i + 1) *
+// bits), numbering from the least significant bit of the first byte. The
+// bits of the last byte past the last field are zero. n fields need
+// bitpack_bytes(n, bits) bytes. (See views::ext::bitunpacked.)
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		constexpr std::ptrdiff_t bitpack_bytes(std::ptrdiff_t n, int bits) noexcept {
+			return (n * bits + 7) / 8;
+		}
+
+		template<class I, class O>
+		using bitpack_result = __in_out_result<I, O>;
+
+		struct __bitpack_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, weakly_incrementable O>
+			requires std::is_integral_v<iter_value_t<I>> &&
+				(sizeof(iter_value_t<I>) <= 8) &&
+				indirectly_writable<O, unsigned char>
+			constexpr bitpack_result<I, O>
+			operator()(I first, S last, int bits, O result,
+				iter_value_t<I> base = 0) const
+			{
+				using U = std::make_unsigned_t<iter_value_t<I>>;
+				STL2_EXPECT(0 <= bits && bits <= std::numeric_limits<U>::digits);
+				unsigned cur = 0;
+				int used = 0;
+				for (; first != last; ++first) {
+					auto v = static_cast<std::uint64_t>(
+						static_cast<U>(static_cast<U>(*first) - static_cast<U>(base)));
+					STL2_EXPECT(bits >= 64 || (v >> bits) == 0);
+					for (int r = bits; r > 0;) {
+						const int k = 8 - used < r ? 8 - used : r;
+						cur |= static_cast<unsigned>(v & ((1u << k) - 1)) << used;
+						v >>= k;
+						used += k;
+						r -= k;
+						if (used == 8) {
+							*result = static_cast<unsigned char>(cur);
+							++result;
+							cur = 0;
+							used = 0;
+						}
+					}
+				}
+				if (used != 0) {
+					*result = static_cast<unsigned char>(cur);
+					++result;
+				}
+				return {std::move(first), std::move(result)};
+			}
+
+			template<input_range R, weakly_incrementable O>
+			requires std::is_integral_v<range_value_t<R>> &&
+				(sizeof(range_value_t<R>) <= 8) &&
+				indirectly_writable<O, unsigned char>
+			constexpr bitpack_result<safe_iterator_t<R>, O>
+			operator()(R&& r, int bits, O result, range_value_t<R> base = 0) const {
+				return (*this)(begin(r), end(r), bits, std::move(result), base);
+			}
+		};
+
+		inline constexpr __bitpack_fn bitpack{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
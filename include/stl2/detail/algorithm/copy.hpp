@@ -12,7 +12,12 @@
 #ifndef STL2_DETAIL_ALGORITHM_COPY_HPP
 #define STL2_DETAIL_ALGORITHM_COPY_HPP
 
+#include <memory>
+
 #include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/iterator/block_unpack.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -28,6 +33,35 @@ STL2_OPEN_NAMESPACE {
 		requires indirectly_copyable<I, O>
 		constexpr copy_result<I, O>
 		operator()(I first, S last, O result) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					auto [i, o] = (*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), std::move(result));
+					return {I{std::move(i)}, std::move(o)};
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto [i, o] = (*this)(base, base + first.count(), std::move(result));
+				return {ext::recounted(first, i, i - base), std::move(o)};
+			}
+			if constexpr (_BlockUnpackable<I, S>) {
+				if constexpr (contiguous_iterator<O> &&
+					same_as<iter_value_t<O>, iter_value_t<I>>)
+				{
+					if (first == last) return {std::move(first), std::move(result)};
+					const auto n = last - first;
+					first.unpack(last, std::addressof(*result));
+					return {std::move(last), result + n};
+				} else {
+					__for_each_unpacked(first, last, [&](const auto* p, auto n) {
+						for (decltype(n) i = 0; i < n; ++i, (void) ++result) {
+							*result = p[i];
+						}
+					});
+					return {std::move(last), std::move(result)};
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = *first;
 			}
@@ -50,6 +84,35 @@ STL2_OPEN_NAMESPACE {
 			requires indirectly_copyable<I, O>
 			constexpr copy_result<I, O>
 			operator()(I first, S last, O result) const {
+				if constexpr (_PeelableCommon<I, S>) {
+					if (ext::peelable(first, last)) {
+						auto [i, o] = (*this)(ext::peel_iterator(first),
+							ext::peel_sentinel(last), std::move(result));
+						return {I{std::move(i)}, std::move(o)};
+					}
+				}
+				if constexpr (_ContiguousCounted<I, S>) {
+					auto base = first.base();
+					auto [i, o] = (*this)(base, base + first.count(), std::move(result));
+					return {ext::recounted(first, i, i - base), std::move(o)};
+				}
+				if constexpr (_BlockUnpackable<I, S>) {
+					if constexpr (contiguous_iterator<O> &&
+						same_as<iter_value_t<O>, iter_value_t<I>>)
+					{
+						if (first == last) return {std::move(first), std::move(result)};
+						const auto n = last - first;
+						first.unpack(last, std::addressof(*result));
+						return {std::move(last), result + n};
+					} else {
+						__for_each_unpacked(first, last, [&](const auto* p, auto n) {
+							for (decltype(n) i = 0; i < n; ++i, (void) ++result) {
+								*result = p[i];
+							}
+						});
+						return {std::move(last), std::move(result)};
+					}
+				}
 				for (; first != last; (void) ++first, (void) ++result) {
 					*result = *first;
 				}
@@ -32,6 +32,16 @@ STL2_OPEN_NAMESPACE {
 			if (n < 0) n = 0;
 			auto norig = n;
 			auto first = ext::uncounted(first_);
+			if constexpr (contiguous_iterator<decltype(first)>) {
+				// Single induction variable: compare against a precomputed end.
+				for (auto last = first + n; first != last; (void) ++first, (void) ++result) {
+					*result = *first;
+				}
+				return {
+					ext::recounted(first_, first, norig),
+					static_cast<O&&>(result)
+				};
+			}
 			for(; n > 0; (void) ++first, (void) ++result, --n) {
 				*result = *first;
 			}
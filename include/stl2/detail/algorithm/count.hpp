@@ -13,6 +13,9 @@
 #define STL2_DETAIL_ALGORITHM_COUNT_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/block_unpack.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -24,6 +27,27 @@ STL2_OPEN_NAMESPACE {
 		requires indirect_relation<equal_to, projected<I, Proj>, const T*>
 		constexpr iter_difference_t<I>
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					return (*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), value, std::move(proj));
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				return (*this)(base, base + first.count(), value, std::move(proj));
+			}
+			if constexpr (_BlockUnpackable<I, S>) {
+				auto k = iter_difference_t<I>{0};
+				__for_each_unpacked(first, last, [&](const auto* p, auto n) {
+					for (decltype(n) i = 0; i < n; ++i) {
+						if (__stl2::invoke(proj, p[i]) == value) {
+							++k;
+						}
+					}
+				});
+				return k;
+			}
 			iter_difference_t<I> n = 0;
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
@@ -12,18 +12,49 @@
 #ifndef STL2_DETAIL_ALGORITHM_COUNT_IF_HPP
 #define STL2_DETAIL_ALGORITHM_COUNT_IF_HPP
 
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/block_unpack.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/concepts.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // count_if [alg.count]
 //
+// The parallel overloads [Extension] call pred concurrently from several
+// threads. Given a stop condition as well, they give up once it is
+// satisfied, polling it before each batch or piece of pol.grain elements,
+// and return the count of the elements they examined.
+//
 STL2_OPEN_NAMESPACE {
 	struct __count_if_fn : private __niebloid {
 		template<input_iterator I, sentinel_for<I> S, class Proj = identity,
 			indirect_unary_predicate<projected<I, Proj>> Pred>
 		constexpr iter_difference_t<I>
 		operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					return (*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), std::move(pred), std::move(proj));
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				return (*this)(base, base + first.count(), std::move(pred),
+					std::move(proj));
+			}
+			if constexpr (_BlockUnpackable<I, S>) {
+				auto k = iter_difference_t<I>{0};
+				__for_each_unpacked(first, last, [&](const auto* p, auto n) {
+					for (decltype(n) i = 0; i < n; ++i) {
+						if (__stl2::invoke(pred, __stl2::invoke(proj, p[i]))) {
+							++k;
+						}
+					}
+				});
+				return k;
+			}
 			auto n = iter_difference_t<I>{0};
 			for (; first != last; ++first) {
 				if (__stl2::invoke(pred, __stl2::invoke(proj, *first))) {
@@ -39,6 +70,56 @@ STL2_OPEN_NAMESPACE {
 		operator()(R&& r, Pred pred, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), __stl2::ref(pred), __stl2::ref(proj));
 		}
+
+		template<input_iterator I, sentinel_for<I> S, class Proj = identity,
+			indirect_unary_predicate<projected<I, Proj>> Pred>
+		requires detail::_Batchable<I>
+		iter_difference_t<I> operator()(const ext::execution::parallel_policy& pol,
+			I first, S last, Pred pred, Proj proj = {}) const
+		{
+			return parallel(pol, std::move(first), std::move(last), pred, proj,
+				detail::__never_stop{});
+		}
+
+		template<input_range R, class Proj = identity,
+			indirect_unary_predicate<projected<iterator_t<R>, Proj>> Pred>
+		requires detail::_Batchable<iterator_t<R>>
+		range_difference_t<R> operator()(const ext::execution::parallel_policy& pol,
+			R&& r, Pred pred, Proj proj = {}) const
+		{
+			return (*this)(pol, begin(r), end(r), __stl2::ref(pred), __stl2::ref(proj));
+		}
+
+		template<ext::stop_condition St, input_iterator I, sentinel_for<I> S,
+			class Proj = identity, indirect_unary_predicate<projected<I, Proj>> Pred>
+		requires detail::_Batchable<I>
+		ext::stoppable_result<iter_difference_t<I>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			I first, S last, Pred pred, Proj proj = {}) const
+		{
+			detail::__shared_stop_poller<St> poll{stop};
+			auto n = parallel(pol, std::move(first), std::move(last), pred, proj, poll);
+			return {n, poll.stopped()};
+		}
+
+		template<ext::stop_condition St, input_range R, class Proj = identity,
+			indirect_unary_predicate<projected<iterator_t<R>, Proj>> Pred>
+		requires detail::_Batchable<iterator_t<R>>
+		ext::stoppable_result<range_difference_t<R>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			R&& r, Pred pred, Proj proj = {}) const
+		{
+			return (*this)(stop, pol, begin(r), end(r), __stl2::ref(pred),
+				__stl2::ref(proj));
+		}
+	private:
+		template<class I, class S, class Pred, class Proj, class Poll>
+		iter_difference_t<I> parallel(const ext::execution::parallel_policy& pol,
+			I first, S last, Pred& pred, Proj& proj, Poll&& poll) const
+		{
+			return detail::__parallel_algorithm<__count_if_fn, I>::run(*this, pol,
+				std::move(first), std::move(last), pred, proj, poll);
+		}
 	};
 
 	inline constexpr __count_if_fn count_if{};
@@ -0,0 +1,64 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_DELTA_ENCODE_HPP
+#define STL2_DETAIL_ALGORITHM_DELTA_ENCODE_HPP
+
+#include <type_traits>
+
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// delta_encode [Extension]
+//
+// Writes the difference of each integer of the input and its predecessor,
+// taking the predecessor of the first to be init. result may equal first,
+// to encode in place. (See views::ext::delta_decode.) Differences wrap
+// modulo 2^N, as in the unsigned type of the same width, so signed values
+// whose difference overflows still round-trip.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class I, class O>
+		using delta_encode_result = __in_out_result<I, O>;
+
+		struct __delta_encode_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, weakly_incrementable O>
+			requires std::is_integral_v<iter_value_t<I>> &&
+				(!same_as<iter_value_t<I>, bool>) &&
+				indirectly_writable<O, iter_value_t<I>>
+			constexpr delta_encode_result<I, O>
+			operator()(I first, S last, O result, iter_value_t<I> init = 0) const {
+				for (auto prev = init; first != last; (void) ++first, (void) ++result) {
+					using U = std::make_unsigned_t<iter_value_t<I>>;
+					const iter_value_t<I> v = *first;
+					*result = static_cast<iter_value_t<I>>(
+						static_cast<U>(static_cast<U>(v) - static_cast<U>(prev)));
+					prev = v;
+				}
+				return {std::move(first), std::move(result)};
+			}
+
+			template<input_range R, weakly_incrementable O>
+			requires std::is_integral_v<range_value_t<R>> &&
+				(!same_as<range_value_t<R>, bool>) &&
+				indirectly_writable<O, range_value_t<R>>
+			constexpr delta_encode_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O result, range_value_t<R> init = 0) const {
+				return (*this)(begin(r), end(r), std::move(result), init);
+			}
+		};
+
+		inline constexpr __delta_encode_fn delta_encode{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -54,6 +54,39 @@ STL2_OPEN_NAMESPACE {
 				}
 				return {first, first};
 			}
+
+			// With a three-way comparator: one comparison per probe until
+			// the first equivalent element, which splits the rest of the
+			// search into a lower and an upper bound.
+			template<forward_iterator I, class T, class Comp, class Proj = identity>
+			requires indirect_three_way_order<Comp, const T*, projected<I, Proj>>
+			constexpr subrange<I>
+			operator()(I first, iter_difference_t<I> dist, const T& value,
+				Comp comp, Proj proj = {}) const {
+				detail::__three_way_less<Comp> less{&comp};
+				while (0 < dist) {
+					auto half = dist / 2;
+					auto middle = next(first, half);
+					auto&& v = *middle;
+					auto c = detail::__compare_3way(comp,
+						__stl2::invoke(proj, std::forward<decltype(v)>(v)), value);
+					if (c < 0) {
+						first = std::move(middle);
+						++first;
+						dist -= half + 1;
+					} else if (c > 0) {
+						dist = half;
+					} else {
+						return {
+							ext::lower_bound_n(std::move(first), half, value,
+								less, __stl2::ref(proj)),
+							ext::upper_bound_n(next(middle), dist - (half + 1),
+								value, less, __stl2::ref(proj))
+						};
+					}
+				}
+				return {first, first};
+			}
 		};
 
 		inline constexpr __equal_range_n_fn equal_range_n{};
@@ -122,6 +155,27 @@ STL2_OPEN_NAMESPACE {
 					__stl2::ref(proj));
 			}
 		}
+
+		// Extension: with a three-way comparator.
+		template<forward_iterator I, sentinel_for<I> S, class T, class Comp,
+			class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*, projected<I, Proj>>
+		constexpr subrange<I> operator()(I first, S last, const T& value,
+			Comp comp, Proj proj = {}) const
+		{
+			auto len = distance(first, std::move(last));
+			return ext::equal_range_n(std::move(first), len, value,
+				__stl2::ref(comp), __stl2::ref(proj));
+		}
+
+		template<forward_range Rng, class T, class Comp, class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*,
+			projected<iterator_t<Rng>, Proj>>
+		constexpr safe_subrange_t<Rng>
+		operator()(Rng&& rng, const T& value, Comp comp, Proj proj = {}) const {
+			return ext::equal_range_n(begin(rng), distance(rng), value,
+				__stl2::ref(comp), __stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __equal_range_fn equal_range{};
@@ -12,6 +12,8 @@
 #ifndef STL2_DETAIL_ALGORITHM_FILL_HPP
 #define STL2_DETAIL_ALGORITHM_FILL_HPP
 
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/concepts.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
@@ -21,6 +23,17 @@ STL2_OPEN_NAMESPACE {
 	struct __fill_fn : private __niebloid {
 		template<class T, output_iterator<const T&> O, sentinel_for<O> S>
 		constexpr O operator()(O first, S last, const T& value) const {
+			if constexpr (_PeelableCommon<O, S>) {
+				if (ext::peelable(first, last)) {
+					return O{(*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), value)};
+				}
+			}
+			if constexpr (_ContiguousCounted<O, S>) {
+				auto base = first.base();
+				auto i = (*this)(base, base + first.count(), value);
+				return ext::recounted(first, i, i - base);
+			}
 			for (; first != last; ++first) {
 				*first = value;
 			}
@@ -13,6 +13,8 @@
 #define STL2_DETAIL_ALGORITHM_FIND_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -24,6 +26,17 @@ STL2_OPEN_NAMESPACE {
 		requires indirect_relation<equal_to, projected<I, Proj>, const T*>
 		constexpr I
 		operator()(I first, S last, const T& value, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					return I{(*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), value, std::move(proj))};
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto i = (*this)(base, base + first.count(), value, std::move(proj));
+				return ext::recounted(first, i, i - base);
+			}
 			for (; first != last; ++first) {
 				if (__stl2::invoke(proj, *first) == value) {
 					break;
@@ -13,6 +13,8 @@
 #define STL2_DETAIL_ALGORITHM_FIND_IF_HPP
 
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -24,6 +26,18 @@ STL2_OPEN_NAMESPACE {
 			indirect_unary_predicate<projected<I, Proj>> Pred>
 		constexpr I
 		operator()(I first, S last, Pred pred, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					return I{(*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), std::move(pred), std::move(proj))};
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto i = (*this)(base, base + first.count(), std::move(pred),
+					std::move(proj));
+				return ext::recounted(first, i, i - base);
+			}
 			for (; first != last; ++first) {
 				if (__stl2::invoke(pred, __stl2::invoke(proj, *first))) {
 					break;
@@ -12,13 +12,25 @@
 #ifndef STL2_DETAIL_ALGORITHM_FOR_EACH_HPP
 #define STL2_DETAIL_ALGORITHM_FOR_EACH_HPP
 
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/block_unpack.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/dangling.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // for_each [alg.foreach]
 //
+// The parallel overloads [Extension] call fun concurrently from several
+// threads. Elements of an input-only range are copied into batches, so
+// fun sees the copies. Given a stop condition as well, they give up once
+// it is satisfied, polling it before each batch or piece of pol.grain
+// elements; fun has then been called for an unspecified subset of the
+// elements, or for input that is not random access, for exactly those
+// before the returned position.
+//
 STL2_OPEN_NAMESPACE {
 	template<class I, class F>
 	using for_each_result = __in_fun_result<I, F>;
@@ -28,6 +40,27 @@ STL2_OPEN_NAMESPACE {
 			indirect_unary_invocable<projected<I, Proj>> F>
 		constexpr for_each_result<I, F>
 		operator()(I first, S last, F fun, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					auto [i, f] = (*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), std::move(fun), std::move(proj));
+					return {I{std::move(i)}, std::move(f)};
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto [i, f] = (*this)(base, base + first.count(), std::move(fun),
+					std::move(proj));
+				return {ext::recounted(first, i, i - base), std::move(f)};
+			}
+			if constexpr (_BlockUnpackable<I, S>) {
+				__for_each_unpacked(first, last, [&](const auto* p, auto n) {
+					for (decltype(n) i = 0; i < n; ++i) {
+						__stl2::invoke(fun, __stl2::invoke(proj, p[i]));
+					}
+				});
+				return {std::move(last), std::move(fun)};
+			}
 			for (; first != last; ++first) {
 				__stl2::invoke(fun, __stl2::invoke(proj, *first));
 			}
@@ -40,6 +73,60 @@ STL2_OPEN_NAMESPACE {
 		operator()(R&& r, F fun, Proj proj = {}) const {
 			return (*this)(begin(r), end(r), std::move(fun), std::move(proj));
 		}
+
+		template<input_iterator I, sentinel_for<I> S, class Proj = identity,
+			indirect_unary_invocable<projected<I, Proj>> F>
+		requires detail::_Batchable<I>
+		for_each_result<I, F>
+		operator()(const ext::execution::parallel_policy& pol, I first, S last,
+			F fun, Proj proj = {}) const
+		{
+			return parallel(pol, std::move(first), std::move(last), std::move(fun),
+				proj, detail::__never_stop{});
+		}
+
+		template<input_range R, class Proj = identity,
+			indirect_unary_invocable<projected<iterator_t<R>, Proj>> F>
+		requires detail::_Batchable<iterator_t<R>>
+		for_each_result<safe_iterator_t<R>, F>
+		operator()(const ext::execution::parallel_policy& pol, R&& r, F fun,
+			Proj proj = {}) const
+		{
+			return (*this)(pol, begin(r), end(r), std::move(fun), std::move(proj));
+		}
+
+		template<ext::stop_condition St, input_iterator I, sentinel_for<I> S,
+			class Proj = identity, indirect_unary_invocable<projected<I, Proj>> F>
+		requires detail::_Batchable<I>
+		ext::stoppable_result<for_each_result<I, F>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			I first, S last, F fun, Proj proj = {}) const
+		{
+			detail::__shared_stop_poller<St> poll{stop};
+			auto r = parallel(pol, std::move(first), std::move(last), std::move(fun),
+				proj, poll);
+			return {std::move(r), poll.stopped()};
+		}
+
+		template<ext::stop_condition St, input_range R, class Proj = identity,
+			indirect_unary_invocable<projected<iterator_t<R>, Proj>> F>
+		requires detail::_Batchable<iterator_t<R>>
+		ext::stoppable_result<for_each_result<safe_iterator_t<R>, F>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			R&& r, F fun, Proj proj = {}) const
+		{
+			auto [res, stopped] = (*this)(stop, pol, begin(r), end(r), std::move(fun),
+				std::move(proj));
+			return {{std::move(res.in), std::move(res.fun)}, stopped};
+		}
+	private:
+		template<class I, class S, class F, class Proj, class Poll>
+		for_each_result<I, F> parallel(const ext::execution::parallel_policy& pol,
+			I first, S last, F fun, Proj& proj, Poll&& poll) const
+		{
+			return detail::__parallel_algorithm<__for_each_fn, I>::run(*this, pol,
+				std::move(first), std::move(last), std::move(fun), proj, poll);
+		}
 	};
 
 	inline constexpr __for_each_fn for_each{};
@@ -54,6 +54,38 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
 				__stl2::ref(comp), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+
+		// Extension: with a three-way comparator.
+		template<input_iterator I1, sentinel_for<I1> S1, input_iterator I2,
+			sentinel_for<I2> S2, class Comp, class Proj1 = identity,
+			class Proj2 = identity>
+		requires ext::indirect_three_way_order<Comp, projected<I1, Proj1>,
+			projected<I2, Proj2>>
+		constexpr bool operator()(I1 first1, S1 last1, I2 first2, S2 last2,
+			Comp comp, Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			while (true) {
+				if (first2 == last2) return true;
+				if (first1 == last1) return false;
+				auto c = detail::__compare_3way(comp,
+					__stl2::invoke(proj1, *first1),
+					__stl2::invoke(proj2, *first2));
+				if (c > 0) return false;
+				if (c == 0) ++first2;
+				++first1;
+			}
+		}
+
+		template<input_range R1, input_range R2, class Comp,
+			class Proj1 = identity, class Proj2 = identity>
+		requires ext::indirect_three_way_order<Comp,
+			projected<iterator_t<R1>, Proj1>, projected<iterator_t<R2>, Proj2>>
+		constexpr bool operator()(R1&& r1, R2&& r2, Comp comp,
+			Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
+				__stl2::ref(comp), __stl2::ref(proj1), __stl2::ref(proj2));
+		}
 	};
 
 	inline constexpr __includes_fn includes{};
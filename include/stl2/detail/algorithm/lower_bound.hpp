@@ -72,6 +72,26 @@ STL2_OPEN_NAMESPACE {
 					__stl2::ref(comp), __stl2::ref(proj));
 			}
 		}
+
+		// Extension: with a three-way comparator.
+		template<forward_iterator I, sentinel_for<I> S, class T, class Comp,
+			class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*, projected<I, Proj>>
+		constexpr I operator()(I first, S last, const T& value, Comp comp,
+			Proj proj = {}) const
+		{
+			return (*this)(std::move(first), std::move(last), value,
+				detail::__three_way_less<Comp>{&comp}, __stl2::ref(proj));
+		}
+
+		template<forward_range R, class T, class Comp, class Proj = identity>
+		requires ext::indirect_three_way_order<Comp, const T*,
+			projected<iterator_t<R>, Proj>>
+		constexpr safe_iterator_t<R>
+		operator()(R&& r, const T& value, Comp comp, Proj proj = {}) const {
+			return (*this)(std::forward<R>(r), value,
+				detail::__three_way_less<Comp>{&comp}, __stl2::ref(proj));
+		}
 	};
 
 	inline constexpr __lower_bound_fn lower_bound{};
@@ -0,0 +1,145 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_PARALLEL_HPP
+#define STL2_DETAIL_ALGORITHM_PARALLEL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/parallel.hpp>
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// The parallel overloads of for_each, transform and count_if [Extension]
+//
+// Each algorithm declares its overloads taking an
+// ext::execution::parallel_policy, and forwards them here; calling one
+// requires this header, which <stl2/algorithm.hpp> includes.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class I>
+		struct __parallel_algorithm<__for_each_fn, I> {
+			template<class S, class F, class Proj, class Poll>
+			static for_each_result<I, F> run(const __for_each_fn& alg,
+				const ext::execution::parallel_policy& pol, I first, S last, F fun,
+				Proj& proj, Poll&& poll)
+			{
+				if constexpr (random_access_iterator<I> && sized_sentinel_for<S, I>) {
+					const auto n = static_cast<std::ptrdiff_t>(last - first);
+					auto chunk = [&](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+						alg(first + lo, first + hi, __stl2::ref(fun), __stl2::ref(proj));
+					};
+					__rethrow_first(__parallel_chunks(pol, n, chunk, poll));
+					return {first + n, std::move(fun)};
+				} else {
+					using batch = __batch_buffer<I>;
+					__parallel_batches<batch>(pol, false,
+						[&](batch& b) { return b.fill(first, last, __grain(pol)); },
+						[&](batch& b) {
+							for (std::size_t i = 0; i < b.size(); ++i) {
+								__stl2::invoke(fun, __stl2::invoke(proj, b[i]));
+							}
+						},
+						[](batch&) {}, poll);
+					return {std::move(first), std::move(fun)};
+				}
+			}
+		};
+
+		template<class I>
+		struct __parallel_algorithm<__transform_fn, I> {
+			template<class S, class O, class F, class Proj, class Poll>
+			static unary_transform_result<I, O> run(const __transform_fn& alg,
+				const ext::execution::parallel_policy& pol, I first, S last, O result,
+				F& op, Proj& proj, Poll&& poll)
+			{
+				if constexpr (random_access_iterator<I> && sized_sentinel_for<S, I> &&
+					random_access_iterator<O>)
+				{
+					const auto n = static_cast<std::ptrdiff_t>(last - first);
+					auto chunk = [&](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+						alg(first + lo, first + hi, result + lo, __stl2::ref(op),
+							__stl2::ref(proj));
+					};
+					__rethrow_first(__parallel_chunks(pol, n, chunk, poll));
+					return {first + n, result + n};
+				} else {
+					using T = __uncvref<indirect_result_t<F&, projected<I, Proj>>>;
+					struct batch {
+						__batch_buffer<I> in;
+						std::vector<T> out;
+					};
+					__parallel_batches<batch>(pol, pol.ordered,
+						[&](batch& b) { return b.in.fill(first, last, __grain(pol)); },
+						[&](batch& b) {
+							b.out.clear();
+							b.out.reserve(b.in.size());
+							for (std::size_t i = 0; i < b.in.size(); ++i) {
+								b.out.emplace_back(__stl2::invoke(op, __stl2::invoke(proj, b.in[i])));
+							}
+						},
+						[&](batch& b) {
+							for (auto& t : b.out) {
+								*result = std::move(t);
+								++result;
+							}
+						}, poll);
+					return {std::move(first), std::move(result)};
+				}
+			}
+		};
+
+		template<class I>
+		struct __parallel_algorithm<__count_if_fn, I> {
+			template<class S, class Pred, class Proj, class Poll>
+			static iter_difference_t<I> run(const __count_if_fn& alg,
+				const ext::execution::parallel_policy& pol, I first, S last, Pred& pred,
+				Proj& proj, Poll&& poll)
+			{
+				using D = iter_difference_t<I>;
+				if constexpr (random_access_iterator<I> && sized_sentinel_for<S, I>) {
+					std::atomic<D> total{0};
+					auto chunk = [&](std::ptrdiff_t lo, std::ptrdiff_t hi) {
+						total += alg(first + lo, first + hi, __stl2::ref(pred),
+							__stl2::ref(proj));
+					};
+					__rethrow_first(__parallel_chunks(pol,
+						static_cast<std::ptrdiff_t>(last - first), chunk, poll));
+					return total.load();
+				} else {
+					struct batch {
+						__batch_buffer<I> in;
+						D count = 0;
+					};
+					D total = 0;
+					__parallel_batches<batch>(pol, false,
+						[&](batch& b) { return b.in.fill(first, last, __grain(pol)); },
+						[&](batch& b) {
+							b.count = 0;
+							for (std::size_t i = 0; i < b.in.size(); ++i) {
+								if (__stl2::invoke(pred, __stl2::invoke(proj, b.in[i]))) {
+									++b.count;
+								}
+							}
+						},
+						[&](batch& b) { total += b.count; }, poll);
+					return total;
+				}
+			}
+		};
+	} // namespace detail
+} STL2_CLOSE_NAMESPACE
+
+#endif
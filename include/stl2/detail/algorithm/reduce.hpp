@@ -0,0 +1,61 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_REDUCE_HPP
+#define STL2_DETAIL_ALGORITHM_REDUCE_HPP
+
+#include <functional>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// reduce [Extension]
+//
+// Folds the projected elements of a range into init with op, from left
+// to right.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class Op, class T, class I>
+		META_CONCEPT _IndirectlyFoldable = movable<T> &&
+			invocable<Op&, T, iter_reference_t<I>> &&
+			assignable_from<T&, invoke_result_t<Op&, T, iter_reference_t<I>>>;
+	} // namespace detail
+
+	namespace ext {
+		struct __reduce_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, movable T,
+				class Op = std::plus<>, class Proj = identity>
+			requires detail::_IndirectlyFoldable<Op, T, projected<I, Proj>>
+			constexpr T operator()(I first, S last, T init, Op op = {},
+				Proj proj = {}) const
+			{
+				for (; first != last; ++first) {
+					init = __stl2::invoke(op, std::move(init),
+						__stl2::invoke(proj, *first));
+				}
+				return init;
+			}
+
+			template<input_range R, movable T, class Op = std::plus<>,
+				class Proj = identity>
+			requires detail::_IndirectlyFoldable<Op, T, projected<iterator_t<R>, Proj>>
+			constexpr T operator()(R&& r, T init, Op op = {}, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), std::move(init), __stl2::ref(op),
+					__stl2::ref(proj));
+			}
+		};
+
+		inline constexpr __reduce_fn reduce{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -25,6 +25,7 @@
 
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/iterator/counted_iterator.hpp>
+#include <stl2/detail/stop_condition.hpp>
 #include <stl2/view/subrange.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
@@ -42,10 +43,12 @@ STL2_OPEN_NAMESPACE {
 			if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2>) {
 				return sized(first1, last1, last1 - first1,
 					first2, last2, last2 - first2,
-					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
+					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2),
+					detail::__never_stop{});
 			} else {
 				return unsized(first1, last1, first2, last2,
-					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
+					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2),
+					detail::__never_stop{});
 			}
 		}
 
@@ -59,25 +62,67 @@ STL2_OPEN_NAMESPACE {
 			if constexpr (sized_range<R1> && sized_range<R2>) {
 				return sized(begin(r1), end(r1), distance(r1),
 					begin(r2), end(r2), distance(r2), __stl2::ref(pred),
-					__stl2::ref(proj1), __stl2::ref(proj2));
+					__stl2::ref(proj1), __stl2::ref(proj2), detail::__never_stop{});
 			} else {
 				return unsized(begin(r1), end(r1), begin(r2), end(r2),
-					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
+					__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2),
+					detail::__never_stop{});
 			}
 		}
+
+		// Extension: gives up once stop is satisfied, polling it every few
+		// thousand candidate positions. If stopped, the result is empty and
+		// begins at the first position not yet tried, where a later search
+		// can resume.
+		template<ext::stop_condition St, forward_iterator I1, sentinel_for<I1> S1,
+			forward_iterator I2, sentinel_for<I2> S2, class Pred = equal_to,
+			class Proj1 = identity, class Proj2 = identity>
+		requires indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
+		ext::stoppable_result<subrange<I1>> operator()(const St& stop, I1 first1,
+			S1 last1, I2 first2, S2 last2, Pred pred = {}, Proj1 proj1 = {},
+			Proj2 proj2 = {}) const
+		{
+			detail::__stop_poller<St> poll{stop};
+			if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2>) {
+				auto r = sized(first1, last1, last1 - first1, first2, last2,
+					last2 - first2, __stl2::ref(pred), __stl2::ref(proj1),
+					__stl2::ref(proj2), poll);
+				return {std::move(r), poll.stopped()};
+			} else {
+				auto r = unsized(first1, last1, first2, last2, __stl2::ref(pred),
+					__stl2::ref(proj1), __stl2::ref(proj2), poll);
+				return {std::move(r), poll.stopped()};
+			}
+		}
+
+		template<ext::stop_condition St, forward_range R1, forward_range R2,
+			class Pred = equal_to, class Proj1 = identity, class Proj2 = identity>
+		requires indirectly_comparable<iterator_t<R1>, iterator_t<R2>,
+			Pred, Proj1, Proj2>
+		ext::stoppable_result<safe_subrange_t<R1>> operator()(const St& stop,
+			R1&& r1, R2&& r2, Pred pred = {}, Proj1 proj1 = {},
+			Proj2 proj2 = {}) const
+		{
+			auto [r, stopped] = (*this)(stop, begin(r1), end(r1), begin(r2), end(r2),
+				__stl2::ref(pred), __stl2::ref(proj1), __stl2::ref(proj2));
+			return {std::move(r), stopped};
+		}
 	private:
 		template<forward_iterator I1, sentinel_for<I1> S1,
 			forward_iterator I2, sentinel_for<I2> S2, class Pred = equal_to,
-			class Proj1 = identity, class Proj2 = identity>
+			class Proj1 = identity, class Proj2 = identity, class Poll>
 		requires indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
 		static constexpr subrange<I1> unsized(I1 first1, S1 last1, I2 first2,
-			S2 last2, Pred pred, Proj1 proj1, Proj2 proj2)
+			S2 last2, Pred pred, Proj1 proj1, Proj2 proj2, Poll&& poll)
 		{
 			if (first2 == last2) {
 				return {first1, first1};
 			}
 
 			for (; first1 != last1; ++first1) {
+				if (poll()) {
+					return {first1, first1};
+				}
 				if (__stl2::invoke(pred, __stl2::invoke(proj1, *first1),
 						__stl2::invoke(proj2, *first2)))
 				{
@@ -103,11 +148,12 @@ STL2_OPEN_NAMESPACE {
 
 		template<forward_iterator I1, sentinel_for<I1> S1,
 			forward_iterator I2, sentinel_for<I2> S2,
-			class Pred, class Proj1, class Proj2>
+			class Pred, class Proj1, class Proj2, class Poll>
 		requires indirectly_comparable<I1, I2, Pred, Proj1, Proj2>
 		static constexpr subrange<I1> sized(const I1 first1_, S1 last1,
 			const iter_difference_t<I1> d1_, I2 first2, S2 last2,
-			const iter_difference_t<I2> d2, Pred pred, Proj1 proj1, Proj2 proj2)
+			const iter_difference_t<I2> d2, Pred pred, Proj1 proj1, Proj2 proj2,
+			Poll&& poll)
 		{
 			if (d2 == 0) {
 				return {first1_, first1_};
@@ -116,6 +162,10 @@ STL2_OPEN_NAMESPACE {
 			auto d1 = d1_;
 			auto first1 = ext::uncounted(first1_);
 			for(; d1 >= d2; ++first1, --d1) {
+				if (poll()) {
+					auto i = ext::recounted(first1_, first1, d1_ - d1);
+					return {i, i};
+				}
 				if (__stl2::invoke(pred, __stl2::invoke(proj1, *first1),
 						__stl2::invoke(proj2, *first2)))
 				{
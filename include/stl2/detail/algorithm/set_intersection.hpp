@@ -15,6 +15,7 @@
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/stop_condition.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // set_intersection [set.intersection]
@@ -63,6 +64,98 @@ STL2_OPEN_NAMESPACE {
 				std::move(result), __stl2::ref(comp), __stl2::ref(proj1),
 				__stl2::ref(proj2));
 		}
+
+		// Extension: with a three-way comparator.
+		template<input_iterator I1, sentinel_for<I1> S1, input_iterator I2,
+			sentinel_for<I2> S2, weakly_incrementable O, class Comp,
+			class Proj1 = identity, class Proj2 = identity>
+		requires ext::three_way_mergeable<I1, I2, O, Comp, Proj1, Proj2>
+		constexpr set_intersection_result<I1, I2, O>
+		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
+			Comp comp, Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			while (bool(first1 != last1) && bool(first2 != last2)) {
+				iter_reference_t<I1>&& v1 = *first1;
+				iter_reference_t<I2>&& v2 = *first2;
+				auto c = detail::__compare_3way(comp,
+					__stl2::invoke(proj1, v1), __stl2::invoke(proj2, v2));
+				if (c < 0) {
+					++first1;
+				} else if (c > 0) {
+					++first2;
+				} else {
+					*result = std::forward<iter_reference_t<I1>>(v1);
+					++result;
+					++first1;
+					++first2;
+				}
+			}
+			return {std::move(first1), std::move(first2), std::move(result)};
+		}
+
+		template<input_range R1, input_range R2, weakly_incrementable O,
+			class Comp, class Proj1 = identity, class Proj2 = identity>
+		requires ext::three_way_mergeable<iterator_t<R1>, iterator_t<R2>, O, Comp,
+			Proj1, Proj2>
+		constexpr set_intersection_result<
+			safe_iterator_t<R1>, safe_iterator_t<R2>, O>
+		operator()(R1&& r1, R2&& r2, O result, Comp comp,
+			Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			return (*this)(begin(r1), end(r1), begin(r2), end(r2),
+				std::move(result), __stl2::ref(comp), __stl2::ref(proj1),
+				__stl2::ref(proj2));
+		}
+
+		// Extension: gives up once stop is satisfied, polling it every few
+		// thousand elements. If stopped, the result says how far the
+		// intersection got; calling set_intersection again from there
+		// finishes it.
+		template<ext::stop_condition St, input_iterator I1, sentinel_for<I1> S1,
+			input_iterator I2, sentinel_for<I2> S2, weakly_incrementable O,
+			class Comp = less, class Proj1 = identity, class Proj2 = identity>
+		requires mergeable<I1, I2, O, Comp, Proj1, Proj2>
+		ext::stoppable_result<set_intersection_result<I1, I2, O>>
+		operator()(const St& stop, I1 first1, S1 last1, I2 first2, S2 last2,
+			O result, Comp comp = {}, Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			detail::__stop_poller<St> poll{stop};
+			while (bool(first1 != last1) && bool(first2 != last2)) {
+				if (poll()) {
+					return {{std::move(first1), std::move(first2), std::move(result)}, true};
+				}
+				iter_reference_t<I1>&& v1 = *first1;
+				iter_reference_t<I2>&& v2 = *first2;
+				auto&& p1 = __stl2::invoke(proj1, v1);
+				auto&& p2 = __stl2::invoke(proj2, v2);
+				if (__stl2::invoke(comp, p1, p2)) {
+					++first1;
+				} else if (__stl2::invoke(comp, p2, p1)) {
+					++first2;
+				} else {
+					*result = std::forward<iter_reference_t<I1>>(v1);
+					++result;
+					++first1;
+					++first2;
+				}
+			}
+			return {{std::move(first1), std::move(first2), std::move(result)}, false};
+		}
+
+		template<ext::stop_condition St, input_range R1, input_range R2,
+			weakly_incrementable O, class Comp = less, class Proj1 = identity,
+			class Proj2 = identity>
+		requires mergeable<iterator_t<R1>, iterator_t<R2>, O, Comp, Proj1, Proj2>
+		ext::stoppable_result<set_intersection_result<
+			safe_iterator_t<R1>, safe_iterator_t<R2>, O>>
+		operator()(const St& stop, R1&& r1, R2&& r2, O result, Comp comp = {},
+			Proj1 proj1 = {}, Proj2 proj2 = {}) const
+		{
+			auto [r, stopped] = (*this)(stop, begin(r1), end(r1), begin(r2), end(r2),
+				std::move(result), __stl2::ref(comp), __stl2::ref(proj1),
+				__stl2::ref(proj2));
+			return {{std::move(r.in1), std::move(r.in2), std::move(r.out)}, stopped};
+		}
 	};
 
 	inline constexpr __set_intersection_fn set_intersection{};
@@ -0,0 +1,67 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_SHUFFLE_N_HPP
+#define STL2_DETAIL_ALGORITHM_SHUFFLE_N_HPP
+
+#include <stl2/random.hpp>
+#include <stl2/detail/randutils.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// shuffle_n [Extension]
+//
+// Performs the first k steps of a Fisher-Yates shuffle: [first, first + k)
+// becomes a uniformly random selection of k elements of [first, last), in
+// uniformly random order, and the rest of the range holds the others in
+// unspecified order. Takes O(k) time; returns first + min(k, last - first).
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		struct __shuffle_n_fn : private __niebloid {
+			template<random_access_iterator I, sized_sentinel_for<I> S,
+				class Gen = detail::default_random_engine&>
+			requires permutable<I> &&
+				uniform_random_bit_generator<std::remove_reference_t<Gen>>
+			constexpr I operator()(I first, S last, iter_difference_t<I> k,
+				Gen&& g = detail::get_random_engine()) const
+			{
+				using D = iter_difference_t<I>;
+				const D n = last - first;
+				if (k > n) k = n;
+				if (k < 0) k = 0;
+				auto dist = std::uniform_int_distribution<D>{};
+				using param_t =
+					typename std::uniform_int_distribution<D>::param_type;
+				for (D i = 0; i < k; ++i) {
+					if (const auto j = dist(g, param_t{i, n - 1}); j != i) {
+						iter_swap(first + i, first + j);
+					}
+				}
+				return first + k;
+			}
+
+			template<random_access_range R,
+				class Gen = detail::default_random_engine&>
+			requires sized_range<R> && permutable<iterator_t<R>> &&
+				uniform_random_bit_generator<std::remove_reference_t<Gen>>
+			constexpr safe_iterator_t<R> operator()(R&& r, range_difference_t<R> k,
+				Gen&& g = detail::get_random_engine()) const
+			{
+				auto first = begin(r);
+				return (*this)(first, first + distance(r), k, std::forward<Gen>(g));
+			}
+		};
+
+		inline constexpr __shuffle_n_fn shuffle_n{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
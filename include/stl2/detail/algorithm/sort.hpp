@@ -35,10 +35,13 @@
 #ifndef STL2_DETAIL_ALGORITHM_SORT_HPP
 #define STL2_DETAIL_ALGORITHM_SORT_HPP
 
+#include <utility>
+
 #include <stl2/detail/algorithm/move_backward.hpp>
 #include <stl2/detail/algorithm/partial_sort.hpp>
 #include <stl2/detail/concepts/callable.hpp>
 #include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/stop_condition.hpp>
 
 ///////////////////////////////////////////////////////////////////////////
 // sort [sort]
@@ -94,7 +97,8 @@ STL2_OPEN_NAMESPACE {
 			if (first == sent) return first;
 			auto last = next(first, static_cast<S&&>(sent));
 			auto n = distance(first, last);
-			introsort_loop(first, last, log2(n) * 2, comp, proj);
+			detail::__never_stop never;
+			introsort_loop(first, last, log2(n) * 2, comp, proj, never);
 			final_insertion_sort(first, last, comp, proj);
 			return last;
 		}
@@ -106,6 +110,59 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
 				static_cast<Proj&&>(proj));
 		}
+
+		// Extension: sorts with a three-way comparator, partitioning into
+		// elements less than, equivalent to, and greater than each pivot
+		// with one comparison per element. Runs of equivalent elements are
+		// never partitioned again.
+		template<random_access_iterator I, sentinel_for<I> S, class Comp,
+			class Proj = identity>
+		requires ext::three_way_sortable<I, Comp, Proj>
+		constexpr I
+		operator()(I first, S sent, Comp comp, Proj proj = {}) const {
+			if (first == sent) return first;
+			auto last = next(first, static_cast<S&&>(sent));
+			auto n = distance(first, last);
+			introsort_3way_loop(first, last, log2(n) * 2, comp, proj);
+			return last;
+		}
+
+		template<random_access_range R, class Comp, class Proj = identity>
+		requires ext::three_way_sortable<iterator_t<R>, Comp, Proj>
+		constexpr safe_iterator_t<R>
+		operator()(R&& r, Comp comp, Proj proj = {}) const {
+			return (*this)(begin(r), end(r), static_cast<Comp&&>(comp),
+				static_cast<Proj&&>(proj));
+		}
+
+		// Extension: gives up once stop is satisfied, polling it as each
+		// partition begins. If stopped, the range holds its original
+		// elements in unspecified order.
+		template<ext::stop_condition St, random_access_iterator I, sentinel_for<I> S,
+			class Comp = less, class Proj = identity>
+		requires sortable<I, Comp, Proj>
+		ext::stoppable_result<I>
+		operator()(const St& stop, I first, S sent, Comp comp = {}, Proj proj = {}) const {
+			auto last = next(first, static_cast<S&&>(sent));
+			if (first == last) return {last, false};
+			detail::__stop_poller<St> poll{stop};
+			if (introsort_loop(first, last, log2(distance(first, last)) * 2, comp,
+				proj, poll))
+			{
+				return {last, true};
+			}
+			final_insertion_sort(first, last, comp, proj);
+			return {last, false};
+		}
+
+		template<ext::stop_condition St, random_access_range R, class Comp = less,
+			class Proj = identity>
+		requires sortable<iterator_t<R>, Comp, Proj>
+		ext::stoppable_result<safe_iterator_t<R>>
+		operator()(const St& stop, R&& r, Comp comp = {}, Proj proj = {}) const {
+			return (*this)(stop, begin(r), end(r), static_cast<Comp&&>(comp),
+				static_cast<Proj&&>(proj));
+		}
 	private:
 		static constexpr std::ptrdiff_t introsort_threshold = 16;
 
@@ -149,20 +206,28 @@ STL2_OPEN_NAMESPACE {
 			}
 		}
 
-		template<random_access_iterator I, class Comp, class Proj>
+		// Returns true if poll said to stop, leaving the range unsorted.
+		template<random_access_iterator I, class Comp, class Proj, class Poll>
 		requires sortable<I, Comp, Proj>
-		static constexpr void
-		introsort_loop(I first, I last, iter_difference_t<I> depth_limit, Comp& comp, Proj& proj)
+		static constexpr bool
+		introsort_loop(I first, I last, iter_difference_t<I> depth_limit, Comp& comp,
+			Proj& proj, Poll& poll)
 		{
 			while (distance(first, last) > introsort_threshold) {
+				if (poll(static_cast<std::ptrdiff_t>(last - first))) {
+					return true;
+				}
 				if (depth_limit == 0) {
 					partial_sort(first, last, last, __stl2::ref(comp), __stl2::ref(proj));
-					return;
+					return false;
 				}
 				I cut = unguarded_partition(first, last, comp, proj);
-				introsort_loop(cut, last, --depth_limit, comp, proj);
+				if (introsort_loop(cut, last, --depth_limit, comp, proj, poll)) {
+					return true;
+				}
 				last = cut;
 			}
+			return false;
 		}
 
 		template<bidirectional_iterator I, class Comp, class Proj>
@@ -186,6 +251,66 @@ STL2_OPEN_NAMESPACE {
 			}
 		}
 
+		// Partitions [first, last) around a median-of-three pivot into
+		// [first, lt) less than it, [lt, gt) equivalent to it, and [gt, last)
+		// greater than it; returns {lt, gt}.
+		template<random_access_iterator I, class Comp, class Proj>
+		requires ext::three_way_sortable<I, Comp, Proj>
+		static constexpr std::pair<I, I>
+		partition_3way(I first, I last, Comp& comp, Proj& proj) {
+			detail::__three_way_less<Comp> less{&comp};
+			iter_swap(first, choose_pivot(first, last, less, proj));
+
+			// The pivot stays at first until the end: [next(first), lt) is
+			// less, [lt, i) equivalent, [i, gt) unexamined.
+			auto&& v = *first;
+			auto&& pivot = __stl2::invoke(proj, std::forward<decltype(v)>(v));
+			I lt = next(first);
+			I i = lt;
+			I gt = last;
+			while (i < gt) {
+				auto c = detail::__compare_3way(comp, __stl2::invoke(proj, *i), pivot);
+				if (c < 0) {
+					if (lt != i) iter_swap(lt, i);
+					++lt;
+					++i;
+				} else if (c > 0) {
+					iter_swap(i, --gt);
+				} else {
+					++i;
+				}
+			}
+			--lt;
+			iter_swap(first, lt);
+			return {lt, gt};
+		}
+
+		template<random_access_iterator I, class Comp, class Proj>
+		requires ext::three_way_sortable<I, Comp, Proj>
+		static constexpr void
+		introsort_3way_loop(I first, I last, iter_difference_t<I> depth_limit,
+			Comp& comp, Proj& proj)
+		{
+			detail::__three_way_less<Comp> less{&comp};
+			while (distance(first, last) > introsort_threshold) {
+				if (depth_limit == 0) {
+					partial_sort(first, last, last, less, __stl2::ref(proj));
+					return;
+				}
+				--depth_limit;
+				auto [lt, gt] = partition_3way(first, last, comp, proj);
+				// Recurse into the smaller side, iterate on the larger.
+				if (lt - first < last - gt) {
+					introsort_3way_loop(first, lt, depth_limit, comp, proj);
+					first = gt;
+				} else {
+					introsort_3way_loop(gt, last, depth_limit, comp, proj);
+					last = lt;
+				}
+			}
+			detail::rsort::insertion_sort(first, last, less, proj);
+		}
+
 		template<integral I>
 		static constexpr auto log2(I n) {
 			STL2_EXPECT(n > 0);
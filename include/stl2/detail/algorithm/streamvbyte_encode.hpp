@@ -0,0 +1,83 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_STREAMVBYTE_ENCODE_HPP
+#define STL2_DETAIL_ALGORITHM_STREAMVBYTE_ENCODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/iterator/operations.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// streamvbyte_encode [Extension]
+//
+// Writes n 32-bit unsigned integers in the StreamVByte format: (n + 3) / 4
+// control bytes, each holding the byte lengths less one of four values in
+// successive bit pairs, least significant first; then the values
+// themselves, each in as few little-endian bytes as it needs. Separating
+// lengths from data lets a decoder place four values with one byte
+// shuffle. The output needs at most streamvbyte_max_bytes(n) bytes. (See
+// views::ext::streamvbyte_decode.)
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		constexpr std::ptrdiff_t streamvbyte_max_bytes(std::ptrdiff_t n) noexcept {
+			return (n + 3) / 4 + 4 * n;
+		}
+
+		template<class I, class O>
+		using streamvbyte_encode_result = __in_out_result<I, O>;
+
+		struct __streamvbyte_encode_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, contiguous_iterator O>
+			requires (forward_iterator<I> || sized_sentinel_for<S, I>) &&
+				convertible_to<iter_reference_t<I>, std::uint32_t> &&
+				same_as<iter_value_t<O>, unsigned char> &&
+				indirectly_writable<O, unsigned char>
+			streamvbyte_encode_result<I, O>
+			operator()(I first, S last, O result) const {
+				const auto n = static_cast<std::ptrdiff_t>(distance(first, last));
+				if (n == 0) return {std::move(first), std::move(result)};
+
+				unsigned char* const control = std::addressof(*result);
+				unsigned char* data = control + (n + 3) / 4;
+				std::memset(control, 0, static_cast<std::size_t>(data - control));
+				for (std::ptrdiff_t i = 0; i < n; ++i, ++first) {
+					const std::uint32_t v = *first;
+					const int code = (v > 0xff) + (v > 0xffff) + (v > 0xffffff);
+					control[i / 4] |= static_cast<unsigned char>(code << (2 * (i % 4)));
+					for (int b = 0; b <= code; ++b) {
+						*data++ = static_cast<unsigned char>(v >> (8 * b));
+					}
+				}
+				return {std::move(first), result + (data - control)};
+			}
+
+			template<input_range R, contiguous_iterator O>
+			requires (forward_range<R> || sized_range<R>) &&
+				convertible_to<range_reference_t<R>, std::uint32_t> &&
+				same_as<iter_value_t<O>, unsigned char> &&
+				indirectly_writable<O, unsigned char>
+			streamvbyte_encode_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O result) const {
+				return (*this)(begin(r), end(r), std::move(result));
+			}
+		};
+
+		inline constexpr __streamvbyte_encode_fn streamvbyte_encode{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
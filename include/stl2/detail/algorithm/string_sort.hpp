@@ -0,0 +1,430 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_STRING_SORT_HPP
+#define STL2_DETAIL_ALGORITHM_STRING_SORT_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <stl2/detail/temporary_vector.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_sort.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/range/primitives.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// string_sort, string_stable_sort [Extension]
+//
+// Sort a range by the std::string_view each element projects to, in the
+// order of string_view's operator<. A key is built per element - the
+// string's bytes, its length, its position, and its first eight bytes as
+// a big-endian integer - so that most comparisons are one integer
+// comparison with no indirection. The elements themselves are moved once,
+// into their final positions, at the end.
+//
+// string_sort is multikey quicksort (Bentley and Sedgewick) on eight bytes
+// at a time: elements whose cached bytes tie move on to the next eight
+// bytes, and the bytes they share are never compared again.
+// string_stable_sort is LCP mergesort (Ng and Kakehi): runs carry the
+// length of the common prefix of each element with its predecessor, and
+// the eight bytes that follow it, from which most merge steps are decided
+// without touching either string.
+//
+// The projection's result must not own its characters: the strings are
+// read after the projection returns.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class I, class Proj>
+		META_CONCEPT _StringSortable = random_access_iterator<I> && permutable<I> &&
+			convertible_to<indirect_result_t<Proj&, I>, std::string_view> &&
+			(std::is_reference_v<indirect_result_t<Proj&, I>> ||
+				std::is_trivially_copyable_v<indirect_result_t<Proj&, I>>);
+
+		struct __string_key {
+			std::uint64_t key;
+			const unsigned char* data;
+			std::size_t size;
+			std::ptrdiff_t index;
+		};
+
+		// Bytes [depth, depth + 8) of [p, p + n) as a big-endian integer,
+		// zero-padded.
+		inline std::uint64_t
+		__string_prefix(const unsigned char* p, std::size_t n, std::size_t depth) noexcept {
+			if (depth >= n) return 0;
+			std::uint64_t w = 0;
+			if (n - depth >= 8) {
+				std::memcpy(&w, p + depth, 8);
+			} else {
+				std::memcpy(&w, p + depth, n - depth);
+			}
+			if constexpr (std::endian::native == std::endian::little) {
+				w = __builtin_bswap64(w);
+			}
+			return w;
+		}
+
+		struct __string_order {
+			// The length of the common prefix.
+			std::size_t lcp;
+			// Negative, zero or positive as the first string is less than,
+			// equal to, or greater than the second.
+			int order;
+		};
+
+		// Compares x and y, whose first h bytes are equal.
+		inline __string_order
+		__string_compare(const __string_key& x, const __string_key& y, std::size_t h) noexcept {
+			const auto n = x.size < y.size ? x.size : y.size;
+			for (; h + 8 <= n; h += 8) {
+				const auto a = __string_prefix(x.data, x.size, h);
+				const auto b = __string_prefix(y.data, y.size, h);
+				if (a != b) {
+					return {h + static_cast<std::size_t>(std::countl_zero(a ^ b) / 8),
+						a < b ? -1 : 1};
+				}
+			}
+			for (; h < n; ++h) {
+				if (x.data[h] != y.data[h]) return {h, x.data[h] < y.data[h] ? -1 : 1};
+			}
+			return {n, x.size < y.size ? -1 : x.size > y.size ? 1 : 0};
+		}
+
+		inline constexpr std::ptrdiff_t __string_sort_threshold = 16;
+
+		// Orders elements whose first end - 8 bytes are equal, with keys
+		// holding the next eight.
+		struct __string_key_less {
+			std::size_t end;
+
+			bool operator()(const __string_key& x, const __string_key& y) const noexcept {
+				if (x.key != y.key) return x.key < y.key;
+				if (x.size <= end || y.size <= end) return x.size < y.size;
+				return __string_compare(x, y, end).order < 0;
+			}
+		};
+
+		// Insertion sort of elements whose first depth bytes are equal, with
+		// keys holding the next eight.
+		inline void
+		__string_insertion_sort(__string_key* a, std::ptrdiff_t n, std::size_t depth) noexcept {
+			const __string_key_less less{depth + 8};
+			for (std::ptrdiff_t i = 1; i < n; ++i) {
+				const auto t = a[i];
+				auto j = i;
+				for (; j > 0 && less(t, a[j - 1]); --j) {
+					a[j] = a[j - 1];
+				}
+				a[j] = t;
+			}
+		}
+
+		// Multikey quicksort of elements whose first depth bytes are equal,
+		// with keys holding the next eight. Of the three partitions, the
+		// largest is sorted in the loop and the others recursively, so the
+		// recursion is at most log2 n deep. As in introsort, after budget
+		// partitions of the same bytes the rest is finished by sort.
+		inline void __string_mkqs(__string_key* a, std::ptrdiff_t n, std::size_t depth,
+			int budget) noexcept
+		{
+			while (n > __string_sort_threshold) {
+				if (budget == 0) {
+					__stl2::sort(a, a + n, __string_key_less{depth + 8});
+					return;
+				}
+
+				auto x = a[0].key, y = a[n / 2].key, z = a[n - 1].key;
+				if (y < x) std::swap(x, y);
+				if (z < y) y = z < x ? x : z;
+				const auto pivot = y;
+
+				std::ptrdiff_t lt = 0, i = 0, gt = n;
+				while (i < gt) {
+					if (a[i].key < pivot) {
+						std::swap(a[lt++], a[i++]);
+					} else if (pivot < a[i].key) {
+						std::swap(a[i], a[--gt]);
+					} else {
+						++i;
+					}
+				}
+
+				// Of the elements with equal keys, those that end within the
+				// key come first, shortest first; the rest move on.
+				auto* eq = a + lt;
+				auto m = gt - lt;
+				const auto end = depth + 8;
+				std::ptrdiff_t done = 0;
+				for (i = 0; i < m; ++i) {
+					if (eq[i].size <= end) std::swap(eq[done++], eq[i]);
+				}
+				__stl2::sort(eq, eq + done, less{}, &__string_key::size);
+				eq += done;
+				m -= done;
+				for (i = 0; i < m; ++i) {
+					eq[i].key = __string_prefix(eq[i].data, eq[i].size, end);
+				}
+
+				struct part {
+					__string_key* a;
+					std::ptrdiff_t n;
+					std::size_t depth;
+					int budget;
+				} parts[] = {
+					{a, lt, depth, budget - 1},
+					{eq, m, end, budget},
+					{a + gt, n - gt, depth, budget - 1},
+				};
+				auto* largest = parts;
+				for (auto& p : parts) {
+					if (p.n > largest->n) largest = &p;
+				}
+				for (auto& p : parts) {
+					if (&p != largest) __string_mkqs(p.a, p.n, p.depth, p.budget);
+				}
+				a = largest->a;
+				n = largest->n;
+				depth = largest->depth;
+				budget = largest->budget;
+			}
+			__string_insertion_sort(a, n, depth);
+		}
+
+		// Compares x and y, whose first h bytes are equal, given cx and cy,
+		// their next eight.
+		inline __string_order __string_compare_at(const __string_key& x, std::uint64_t cx,
+			const __string_key& y, std::uint64_t cy, std::size_t h) noexcept
+		{
+			const auto n = x.size < y.size ? x.size : y.size;
+			if (cx != cy) {
+				const auto k = h + static_cast<std::size_t>(std::countl_zero(cx ^ cy) / 8);
+				if (k < n) return {k, cx < cy ? -1 : 1};
+				// Only padding differs: the shorter is a prefix.
+				return {n, x.size < y.size ? -1 : 1};
+			}
+			if (n <= h + 8) return {n, x.size < y.size ? -1 : x.size > y.size ? 1 : 0};
+			return __string_compare(x, y, h + 8);
+		}
+
+		// Merges the sorted runs a and b, with their LCP arrays, into out.
+		// la[i] is the LCP of a[i - 1] and a[i], la[0] is zero, and a[i].key
+		// holds the eight bytes of a[i] after the first la[i]; likewise b
+		// and lb, and out and lo.
+		inline void __string_lcp_merge(
+			const __string_key* a, const std::size_t* la, std::ptrdiff_t na,
+			const __string_key* b, const std::size_t* lb, std::ptrdiff_t nb,
+			__string_key* out, std::size_t* lo) noexcept
+		{
+			// The LCPs of a[i] and b[j] with the last element output, and
+			// their eight bytes after those.
+			std::size_t ha = 0, hb = 0;
+			std::uint64_t ca = a[0].key, cb = b[0].key;
+			std::ptrdiff_t i = 0, j = 0;
+			auto take_a = [&] {
+				*out = a[i];
+				out->key = ca;
+				++out;
+				*lo++ = ha;
+				if (++i < na) {
+					ha = la[i];
+					ca = a[i].key;
+				}
+			};
+			auto take_b = [&] {
+				*out = b[j];
+				out->key = cb;
+				++out;
+				*lo++ = hb;
+				if (++j < nb) {
+					hb = lb[j];
+					cb = b[j].key;
+				}
+			};
+			while (i < na && j < nb) {
+				// The one sharing more with the last output is smaller, and
+				// shares with the other exactly what the other shares with
+				// the last output.
+				if (ha > hb) {
+					take_a();
+				} else if (hb > ha) {
+					take_b();
+				} else {
+					const auto c = __string_compare_at(a[i], ca, b[j], cb, ha);
+					if (c.order <= 0) {
+						take_a();
+						if (c.lcp != hb) {
+							hb = c.lcp;
+							cb = __string_prefix(b[j].data, b[j].size, hb);
+						}
+					} else {
+						take_b();
+						if (c.lcp != ha) {
+							ha = c.lcp;
+							ca = __string_prefix(a[i].data, a[i].size, ha);
+						}
+					}
+				}
+			}
+			while (i < na) take_a();
+			while (j < nb) take_b();
+		}
+
+		// Stable LCP mergesort of a, whose keys hold each string's first
+		// eight bytes, with scratch space b, la and lb.
+		inline void __string_lcp_mergesort(__string_key* a, __string_key* b,
+			std::size_t* la, std::size_t* lb, std::ptrdiff_t n) noexcept
+		{
+			constexpr std::ptrdiff_t run = __string_sort_threshold;
+			for (std::ptrdiff_t lo = 0; lo < n; lo += run) {
+				const auto hi = lo + run < n ? lo + run : n;
+				for (auto i = lo + 1; i < hi; ++i) {
+					const auto t = a[i];
+					auto j = i;
+					for (; j > lo && __string_compare_at(t, t.key, a[j - 1], a[j - 1].key, 0).order < 0; --j) {
+						a[j] = a[j - 1];
+					}
+					a[j] = t;
+				}
+				la[lo] = 0;
+				for (auto i = hi - 1; i > lo; --i) {
+					la[i] = __string_compare_at(a[i - 1], a[i - 1].key, a[i], a[i].key, 0).lcp;
+					a[i].key = __string_prefix(a[i].data, a[i].size, la[i]);
+				}
+			}
+			auto src = a, dst = b;
+			auto lsrc = la, ldst = lb;
+			for (auto width = run; width < n; width *= 2) {
+				for (std::ptrdiff_t lo = 0; lo < n; lo += 2 * width) {
+					const auto mid = lo + width < n ? lo + width : n;
+					const auto hi = mid + width < n ? mid + width : n;
+					if (mid == hi) {
+						std::memcpy(dst + lo, src + lo, static_cast<std::size_t>(mid - lo) * sizeof(__string_key));
+						std::memcpy(ldst + lo, lsrc + lo, static_cast<std::size_t>(mid - lo) * sizeof(std::size_t));
+						continue;
+					}
+					__string_lcp_merge(src + lo, lsrc + lo, mid - lo,
+						src + mid, lsrc + mid, hi - mid, dst + lo, ldst + lo);
+				}
+				std::swap(src, dst);
+				std::swap(lsrc, ldst);
+			}
+			if (src != a) {
+				std::memcpy(a, src, static_cast<std::size_t>(n) * sizeof(__string_key));
+			}
+		}
+
+		template<class I, class Proj>
+		void __string_keys(I first, std::ptrdiff_t n, Proj& proj, __string_key* keys) {
+			for (std::ptrdiff_t i = 0; i < n; ++i) {
+				const std::string_view s = __stl2::invoke(proj, first[i]);
+				const auto p = reinterpret_cast<const unsigned char*>(s.data());
+				keys[i] = {__string_prefix(p, s.size(), 0), p, s.size(), i};
+			}
+		}
+
+		// Moves each element to its sorted position: position i receives the
+		// element at keys[i].index.
+		template<class I>
+		void __string_permute(I first, __string_key* keys, std::ptrdiff_t n) {
+			for (std::ptrdiff_t i = 0; i < n; ++i) {
+				auto j = keys[i].index;
+				if (j == i || j < 0) continue;
+				iter_value_t<I> tmp = iter_move(first + i);
+				auto cur = i;
+				while (j != i) {
+					first[cur] = iter_move(first + j);
+					keys[cur].index = -1;
+					cur = j;
+					j = keys[cur].index;
+				}
+				first[cur] = std::move(tmp);
+				keys[cur].index = -1;
+			}
+		}
+
+		template<class Proj>
+		struct __string_view_proj {
+			Proj& proj_;
+
+			template<class T>
+			std::string_view operator()(T&& t) const {
+				return __stl2::invoke(proj_, static_cast<T&&>(t));
+			}
+		};
+	} // namespace detail
+
+	namespace ext {
+		struct __string_sort_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, class Proj = identity>
+			requires detail::_StringSortable<I, Proj>
+			I operator()(I first, S sent, Proj proj = {}) const {
+				auto last = next(first, static_cast<S&&>(sent));
+				const auto n = static_cast<std::ptrdiff_t>(last - first);
+				if (n < 2) return last;
+				detail::temporary_buffer<detail::__string_key> keys{n};
+				if (keys.size() < n) {
+					__stl2::sort(first, last, less{}, detail::__string_view_proj<Proj>{proj});
+					return last;
+				}
+				detail::__string_keys(first, n, proj, keys.data());
+				detail::__string_mkqs(keys.data(), n, 0,
+					2 * static_cast<int>(std::bit_width(static_cast<std::size_t>(n))));
+				detail::__string_permute(first, keys.data(), n);
+				return last;
+			}
+
+			template<random_access_range R, class Proj = identity>
+			requires detail::_StringSortable<iterator_t<R>, Proj>
+			safe_iterator_t<R> operator()(R&& r, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), static_cast<Proj&&>(proj));
+			}
+		};
+
+		inline constexpr __string_sort_fn string_sort{};
+
+		struct __string_stable_sort_fn : private __niebloid {
+			template<random_access_iterator I, sentinel_for<I> S, class Proj = identity>
+			requires detail::_StringSortable<I, Proj>
+			I operator()(I first, S sent, Proj proj = {}) const {
+				auto last = next(first, static_cast<S&&>(sent));
+				const auto n = static_cast<std::ptrdiff_t>(last - first);
+				if (n < 2) return last;
+				detail::temporary_buffer<detail::__string_key> keys{2 * n};
+				detail::temporary_buffer<std::size_t> lcps{2 * n};
+				if (keys.size() < 2 * n || lcps.size() < 2 * n) {
+					__stl2::stable_sort(first, last, less{},
+						detail::__string_view_proj<Proj>{proj});
+					return last;
+				}
+				detail::__string_keys(first, n, proj, keys.data());
+				detail::__string_lcp_mergesort(keys.data(), keys.data() + n,
+					lcps.data(), lcps.data() + n, n);
+				detail::__string_permute(first, keys.data(), n);
+				return last;
+			}
+
+			template<random_access_range R, class Proj = identity>
+			requires detail::_StringSortable<iterator_t<R>, Proj>
+			safe_iterator_t<R> operator()(R&& r, Proj proj = {}) const {
+				return (*this)(begin(r), end(r), static_cast<Proj&&>(proj));
+			}
+		};
+
+		inline constexpr __string_stable_sort_fn string_stable_sort{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -13,13 +13,34 @@
 #ifndef STL2_DETAIL_ALGORITHM_TRANSFORM_HPP
 #define STL2_DETAIL_ALGORITHM_TRANSFORM_HPP
 
+#include <memory>
+
+#include <stl2/detail/batch.hpp>
+#include <stl2/detail/execution.hpp>
 #include <stl2/detail/algorithm/results.hpp>
 #include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/iterator/common_iterator.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/range/primitives.hpp>
 
 ////////////////////////////////////////////////////////////////////////////////
 // transform [alg.transform]
 //
+// Given contiguous input and output, unprojected, and a function object
+// with a batch overload (see <stl2/detail/batch.hpp>), transform [Extension]
+// makes a single batch call for the whole range; given one with an
+// ext::simd overload, it calls that for each full vector of elements.
+//
+// The parallel unary overloads [Extension] call op concurrently from
+// several threads. Unless the output is random access too, results are
+// buffered per batch and written by the calling thread: in input order
+// if pol.ordered, otherwise in whatever order the batches finish. Given a
+// stop condition as well, they give up once it is satisfied, polling it
+// before each batch or piece of pol.grain elements. The output then holds
+// the results for an unspecified subset of the elements, or for input
+// that is not random access, for exactly those before the returned
+// position.
+//
 STL2_OPEN_NAMESPACE {
 	template<class I, class O>
 	using unary_transform_result = __in_out_result<I, O>;
@@ -33,6 +54,39 @@ STL2_OPEN_NAMESPACE {
 		requires writable<O, indirect_result_t<F&, projected<I, Proj>>>
 		constexpr unary_transform_result<I, O>
 		operator()(I first, S last, O result, F op, Proj proj = {}) const {
+			if constexpr (_PeelableCommon<I, S>) {
+				if (ext::peelable(first, last)) {
+					auto [i, o] = (*this)(ext::peel_iterator(first),
+						ext::peel_sentinel(last), std::move(result), std::move(op),
+						std::move(proj));
+					return {I{std::move(i)}, std::move(o)};
+				}
+			}
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto [i, o] = (*this)(base, base + first.count(), std::move(result),
+					std::move(op), std::move(proj));
+				return {ext::recounted(first, i, i - base), std::move(o)};
+			}
+			if constexpr (sized_sentinel_for<S, I> && _IdentityProjection<Proj> &&
+				_BatchTransformable<F, O, I>)
+			{
+				const auto n = static_cast<std::ptrdiff_t>(last - first);
+				if (n > 0) {
+					__invoke_batch(op, n, std::addressof(*result), std::addressof(*first));
+				}
+				return {first + n, result + n};
+			} else if constexpr (sized_sentinel_for<S, I> && _IdentityProjection<Proj> &&
+				_SimdTransformable<F, O, I>)
+			{
+				const auto n = static_cast<std::ptrdiff_t>(last - first);
+				if (n > 0) {
+					const auto k = __invoke_simd(op, n, std::addressof(*result),
+						std::addressof(*first));
+					first += k;
+					result += k;
+				}
+			}
 			for (; first != last; (void) ++first, (void) ++result) {
 				*result = __stl2::invoke(op, __stl2::invoke(proj, *first));
 			}
@@ -48,6 +102,65 @@ STL2_OPEN_NAMESPACE {
 				__stl2::ref(proj));
 		}
 
+		template<input_iterator I, sentinel_for<I> S, weakly_incrementable O,
+			copy_constructible F, class Proj = identity>
+		requires detail::_Batchable<I> &&
+			writable<O, indirect_result_t<F&, projected<I, Proj>>> &&
+			move_constructible<__uncvref<indirect_result_t<F&, projected<I, Proj>>>> &&
+			writable<O, __uncvref<indirect_result_t<F&, projected<I, Proj>>>>
+		unary_transform_result<I, O>
+		operator()(const ext::execution::parallel_policy& pol, I first, S last,
+			O result, F op, Proj proj = {}) const
+		{
+			return parallel(pol, std::move(first), std::move(last), std::move(result),
+				op, proj, detail::__never_stop{});
+		}
+
+		template<input_range R, weakly_incrementable O, copy_constructible F,
+			class Proj = identity>
+		requires detail::_Batchable<iterator_t<R>> &&
+			writable<O, indirect_result_t<F&, projected<iterator_t<R>, Proj>>> &&
+			move_constructible<__uncvref<indirect_result_t<F&, projected<iterator_t<R>, Proj>>>> &&
+			writable<O, __uncvref<indirect_result_t<F&, projected<iterator_t<R>, Proj>>>>
+		unary_transform_result<safe_iterator_t<R>, O>
+		operator()(const ext::execution::parallel_policy& pol, R&& r, O result,
+			F op, Proj proj = {}) const
+		{
+			return (*this)(pol, begin(r), end(r), std::move(result), __stl2::ref(op),
+				__stl2::ref(proj));
+		}
+
+		template<ext::stop_condition St, input_iterator I, sentinel_for<I> S,
+			weakly_incrementable O, copy_constructible F, class Proj = identity>
+		requires detail::_Batchable<I> &&
+			writable<O, indirect_result_t<F&, projected<I, Proj>>> &&
+			move_constructible<__uncvref<indirect_result_t<F&, projected<I, Proj>>>> &&
+			writable<O, __uncvref<indirect_result_t<F&, projected<I, Proj>>>>
+		ext::stoppable_result<unary_transform_result<I, O>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			I first, S last, O result, F op, Proj proj = {}) const
+		{
+			detail::__shared_stop_poller<St> poll{stop};
+			auto r = parallel(pol, std::move(first), std::move(last), std::move(result),
+				op, proj, poll);
+			return {std::move(r), poll.stopped()};
+		}
+
+		template<ext::stop_condition St, input_range R, weakly_incrementable O,
+			copy_constructible F, class Proj = identity>
+		requires detail::_Batchable<iterator_t<R>> &&
+			writable<O, indirect_result_t<F&, projected<iterator_t<R>, Proj>>> &&
+			move_constructible<__uncvref<indirect_result_t<F&, projected<iterator_t<R>, Proj>>>> &&
+			writable<O, __uncvref<indirect_result_t<F&, projected<iterator_t<R>, Proj>>>>
+		ext::stoppable_result<unary_transform_result<safe_iterator_t<R>, O>>
+		operator()(const St& stop, const ext::execution::parallel_policy& pol,
+			R&& r, O result, F op, Proj proj = {}) const
+		{
+			auto [res, stopped] = (*this)(stop, pol, begin(r), end(r), std::move(result),
+				__stl2::ref(op), __stl2::ref(proj));
+			return {{std::move(res.in), std::move(res.out)}, stopped};
+		}
+
 		template<input_iterator I1, sentinel_for<I1> S1,
 			input_iterator I2, sentinel_for<I2> S2,
 			weakly_incrementable O, copy_constructible F,
@@ -58,6 +171,35 @@ STL2_OPEN_NAMESPACE {
 		operator()(I1 first1, S1 last1, I2 first2, S2 last2, O result,
 			F op, Proj1 proj1 = {}, Proj2 proj2 = {}) const
 		{
+			if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+				_IdentityProjection<Proj1> && _IdentityProjection<Proj2> &&
+				_BatchTransformable<F, O, I1, I2>)
+			{
+				auto n = static_cast<std::ptrdiff_t>(last1 - first1);
+				if (const auto n2 = static_cast<std::ptrdiff_t>(last2 - first2); n2 < n) {
+					n = n2;
+				}
+				if (n > 0) {
+					__invoke_batch(op, n, std::addressof(*result),
+						std::addressof(*first1), std::addressof(*first2));
+				}
+				return {first1 + n, first2 + n, result + n};
+			} else if constexpr (sized_sentinel_for<S1, I1> && sized_sentinel_for<S2, I2> &&
+				_IdentityProjection<Proj1> && _IdentityProjection<Proj2> &&
+				_SimdTransformable<F, O, I1, I2>)
+			{
+				auto n = static_cast<std::ptrdiff_t>(last1 - first1);
+				if (const auto n2 = static_cast<std::ptrdiff_t>(last2 - first2); n2 < n) {
+					n = n2;
+				}
+				if (n > 0) {
+					const auto k = __invoke_simd(op, n, std::addressof(*result),
+						std::addressof(*first1), std::addressof(*first2));
+					first1 += k;
+					first2 += k;
+					result += k;
+				}
+			}
 			for (; bool(first1 != last1) && bool(first2 != last2);
 			     (void) ++first1, (void) ++first2, (void) ++result)
 			{
@@ -78,6 +220,14 @@ STL2_OPEN_NAMESPACE {
 			return (*this)(begin(r1), end(r1), begin(r2), end(r2), std::move(result),
 				__stl2::ref(op), __stl2::ref(proj1), __stl2::ref(proj2));
 		}
+	private:
+		template<class I, class S, class O, class F, class Proj, class Poll>
+		unary_transform_result<I, O> parallel(const ext::execution::parallel_policy& pol,
+			I first, S last, O result, F& op, Proj& proj, Poll&& poll) const
+		{
+			return detail::__parallel_algorithm<__transform_fn, I>::run(*this, pol,
+				std::move(first), std::move(last), std::move(result), op, proj, poll);
+		}
 	};
 
 	inline constexpr __transform_fn transform{};
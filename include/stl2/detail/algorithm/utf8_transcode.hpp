@@ -0,0 +1,110 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_UTF8_TRANSCODE_HPP
+#define STL2_DETAIL_ALGORITHM_UTF8_TRANSCODE_HPP
+
+#include <memory>
+
+#include <stl2/detail/utf8.hpp>
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// utf8_transcode [Extension]
+//
+// Converts a contiguous range of UTF-8 code units to UTF-16 or UTF-32, as
+// the contiguous output's value type is char16_t or char32_t. The output
+// must have room for as many code units as the input has; runs of ASCII
+// are widened 16 bytes per step. Stops at the first ill-formed sequence,
+// and returns its position with the end of the output.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Widens the leading ASCII of [p, e) to out; returns the first
+		// non-ASCII byte, or e.
+		template<class CharT>
+		const unsigned char*
+		__utf8_widen_ascii(const unsigned char* p, const unsigned char* e, CharT*& out) noexcept {
+#if defined(__SSE2__)
+			const auto zero = _mm_setzero_si128();
+			for (; e - p >= 16; p += 16) {
+				const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				if (_mm_movemask_epi8(v) != 0) break;
+				const auto lo = _mm_unpacklo_epi8(v, zero);
+				const auto hi = _mm_unpackhi_epi8(v, zero);
+				auto o = reinterpret_cast<__m128i*>(out);
+				if constexpr (sizeof(CharT) == 2) {
+					_mm_storeu_si128(o, lo);
+					_mm_storeu_si128(o + 1, hi);
+				} else {
+					_mm_storeu_si128(o, _mm_unpacklo_epi16(lo, zero));
+					_mm_storeu_si128(o + 1, _mm_unpackhi_epi16(lo, zero));
+					_mm_storeu_si128(o + 2, _mm_unpacklo_epi16(hi, zero));
+					_mm_storeu_si128(o + 3, _mm_unpackhi_epi16(hi, zero));
+				}
+				out += 16;
+			}
+#endif
+			const auto a = __utf8_ascii_end(p, e);
+			for (; p != a; ++p) {
+				*out++ = static_cast<CharT>(*p);
+			}
+			return p;
+		}
+	} // namespace detail
+
+	namespace ext {
+		template<class I, class O>
+		using utf8_transcode_result = __in_out_result<I, O>;
+
+		struct __utf8_transcode_fn : private __niebloid {
+			template<detail::_Utf8Range R, contiguous_iterator O>
+			requires (same_as<iter_value_t<O>, char16_t> ||
+				same_as<iter_value_t<O>, char32_t>) &&
+				indirectly_writable<O, iter_value_t<O>>
+			utf8_transcode_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O result) const noexcept {
+				using CharT = iter_value_t<O>;
+				const auto first = detail::__utf8_data(r);
+				const auto last = first + __stl2::size(r);
+				if (first == last) return {__stl2::begin(r), std::move(result)};
+
+				CharT* const out_first = std::addressof(*result);
+				CharT* out = out_first;
+				auto p = first;
+				while (p != last) {
+					p = detail::__utf8_widen_ascii(p, last, out);
+					if (p == last) break;
+					auto q = p;
+					const char32_t c = detail::__utf8_decode(q, last);
+					if (c == detail::__utf8_error) break;
+					if constexpr (sizeof(CharT) == 2) {
+						if (c >= 0x10000) {
+							*out++ = static_cast<CharT>(0xd800 + ((c - 0x10000) >> 10));
+							*out++ = static_cast<CharT>(0xdc00 + (c & 0x3ff));
+						} else {
+							*out++ = static_cast<CharT>(c);
+						}
+					} else {
+						*out++ = c;
+					}
+					p = q;
+				}
+				return {__stl2::begin(r) + (p - first), result + (out - out_first)};
+			}
+		};
+
+		inline constexpr __utf8_transcode_fn utf8_transcode{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
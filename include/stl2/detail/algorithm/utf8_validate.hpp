@@ -0,0 +1,52 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_UTF8_VALIDATE_HPP
+#define STL2_DETAIL_ALGORITHM_UTF8_VALIDATE_HPP
+
+#include <stl2/detail/utf8.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// utf8_validate, utf8_find_invalid [Extension]
+//
+// Whether a contiguous range of code units is well-formed UTF-8; and where
+// the first ill-formed sequence begins. Under SSSE3, 64 bytes are checked
+// per step with table lookups and no branches; on failure, and for the
+// tail, a scalar pass locates the error.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		struct __utf8_find_invalid_fn : private __niebloid {
+			template<detail::_Utf8Range R>
+			safe_iterator_t<R> operator()(R&& r) const noexcept {
+				const auto first = detail::__utf8_data(r);
+				const auto last = first + __stl2::size(r);
+				return __stl2::begin(r) + (detail::__utf8_find_invalid(first, last) - first);
+			}
+		};
+
+		inline constexpr __utf8_find_invalid_fn utf8_find_invalid{};
+
+		struct __utf8_validate_fn : private __niebloid {
+			template<detail::_Utf8Range R>
+			bool operator()(R&& r) const noexcept {
+				const auto first = detail::__utf8_data(r);
+				const auto last = first + __stl2::size(r);
+				return detail::__utf8_find_invalid(first, last) == last;
+			}
+		};
+
+		inline constexpr __utf8_validate_fn utf8_validate{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,72 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ALGORITHM_VARINT_ENCODE_HPP
+#define STL2_DETAIL_ALGORITHM_VARINT_ENCODE_HPP
+
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/dangling.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// varint_encode [Extension]
+//
+// Writes each unsigned integer of the input as an LEB128 varint: seven bits
+// per byte, least significant group first, with the high bit set on every
+// byte but the last. A value of type T needs at most varint_max_bytes<T>
+// bytes. (See views::ext::varint_decode.)
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class T>
+		requires std::is_integral_v<T> && std::is_unsigned_v<T>
+		inline constexpr std::ptrdiff_t varint_max_bytes =
+			(std::numeric_limits<T>::digits + 6) / 7;
+
+		template<class I, class O>
+		using varint_encode_result = __in_out_result<I, O>;
+
+		struct __varint_encode_fn : private __niebloid {
+			template<input_iterator I, sentinel_for<I> S, weakly_incrementable O>
+			requires std::is_integral_v<iter_value_t<I>> &&
+				std::is_unsigned_v<iter_value_t<I>> &&
+				indirectly_writable<O, unsigned char>
+			constexpr varint_encode_result<I, O>
+			operator()(I first, S last, O result) const {
+				for (; first != last; ++first) {
+					auto v = static_cast<iter_value_t<I>>(*first);
+					for (; v >= 0x80; v >>= 7) {
+						*result = static_cast<unsigned char>(v | 0x80);
+						++result;
+					}
+					*result = static_cast<unsigned char>(v);
+					++result;
+				}
+				return {std::move(first), std::move(result)};
+			}
+
+			template<input_range R, weakly_incrementable O>
+			requires std::is_integral_v<range_value_t<R>> &&
+				std::is_unsigned_v<range_value_t<R>> &&
+				indirectly_writable<O, unsigned char>
+			constexpr varint_encode_result<safe_iterator_t<R>, O>
+			operator()(R&& r, O result) const {
+				return (*this)(begin(r), end(r), std::move(result));
+			}
+		};
+
+		inline constexpr __varint_encode_fn varint_encode{};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,113 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_BATCH_HPP
+#define STL2_DETAIL_BATCH_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <stl2/functional.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/simd_fwd.hpp>
+#include <stl2/detail/span.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/functional/invoke.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+STL2_OPEN_NAMESPACE {
+	// Extension: besides its element-wise operator(), a function object may
+	// have a batch overload f(ext::span<const T>..., ext::span<U> out) that
+	// takes equally long spans of its arguments and of the results, and
+	// stores f(in[i]...) to out[i] for each i - typically with a vectorized
+	// kernel. out may be the same array as one of the inputs. transform
+	// hands the batch overload whole contiguous ranges, and the iterators
+	// of transform_view unpack blocks of a contiguous base with it.
+	template<class F, class U, class... T>
+	META_CONCEPT _BatchInvocable = invocable<F&, ext::span<const T>..., ext::span<U>>;
+
+	// Extension: a function object may instead have an overload
+	// f(ext::simd<T, N>...) returning ext::simd<U, N>, N the fewest native
+	// lanes of U and the Ts. It is called for each full block of N elements
+	// and the element-wise operator() for the rest. Since finding such an
+	// overload would instantiate the body of a generic lambda, the function
+	// object must also declare a member type is_vectorized, as a transparent
+	// comparator declares is_transparent. Only the declaration of
+	// ext::simd is needed here: a function object with such an overload
+	// has seen the definition, from <stl2/simd.hpp>.
+	template<class F>
+	struct __batch_target {
+		using type = F;
+	};
+	template<class F>
+	struct __batch_target<reference_wrapper<F>> {
+		using type = __uncvref<F>;
+	};
+
+	template<class... T>
+	constexpr int __simd_batch_lanes() noexcept {
+		int n = 64;
+		((n = ext::simd_native_lanes<T> < n ? ext::simd_native_lanes<T> : n), ...);
+		return n;
+	}
+
+	template<class F, class U, class... T>
+	META_CONCEPT _SimdInvocable = ext::simd_element<U> && (ext::simd_element<T> && ...) &&
+		requires { typename meta::_t<__batch_target<__uncvref<F>>>::is_vectorized; } &&
+		invocable<F&, ext::simd<T, __simd_batch_lanes<U, T...>()>...> &&
+		convertible_to<invoke_result_t<F&, ext::simd<T, __simd_batch_lanes<U, T...>()>...>,
+			ext::simd<U, __simd_batch_lanes<U, T...>()>>;
+
+	template<class Proj>
+	META_CONCEPT _IdentityProjection = same_as<Proj, identity> ||
+		same_as<Proj, reference_wrapper<identity>> ||
+		same_as<Proj, reference_wrapper<const identity>>;
+
+	// An iterator whose elements can be handed to a batch overload as an
+	// array, and one that can receive its results.
+	template<class I>
+	META_CONCEPT _BatchSource = contiguous_iterator<I>;
+
+	template<class O>
+	META_CONCEPT _BatchSink = contiguous_iterator<O> &&
+		same_as<iter_reference_t<O>, iter_value_t<O>&>;
+
+	// Whether transform(in..., out, f) can call the batch overload of f.
+	template<class F, class O, class... I>
+	META_CONCEPT _BatchTransformable = _BatchSink<O> && (_BatchSource<I> && ...) &&
+		_BatchInvocable<F, iter_value_t<O>, iter_value_t<I>...>;
+
+	template<class F, class O, class... I>
+	META_CONCEPT _SimdTransformable = _BatchSink<O> && (_BatchSource<I> && ...) &&
+		_SimdInvocable<F, iter_value_t<O>, iter_value_t<I>...>;
+
+	// Calls the batch overload of f for the n elements at out and in...
+	template<class F, class U, class... T>
+	requires _BatchInvocable<F, U, T...>
+	constexpr void __invoke_batch(F& f, std::ptrdiff_t n, U* out, const T*... in) {
+		__stl2::invoke(f, ext::span<const T>{in, n}..., ext::span<U>{out, n});
+	}
+
+	// Calls the simd overload of f for each full block of the n elements at
+	// out and in...; returns the number of elements it covered.
+	template<class F, class U, class... T>
+	requires _SimdInvocable<F, U, T...>
+	std::ptrdiff_t __invoke_simd(F& f, std::ptrdiff_t n, U* out, const T*... in) {
+		constexpr int lanes = __simd_batch_lanes<U, T...>();
+		std::ptrdiff_t i = 0;
+		for (; n - i >= lanes; i += lanes) {
+			ext::simd<U, lanes>(__stl2::invoke(f, ext::simd<T, lanes>::load(in + i)...))
+				.store(out + i);
+		}
+		return i;
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,328 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_BUFFERED_WRITER_HPP
+#define STL2_DETAIL_BUFFERED_WRITER_HPP
+
+#include <stl2/detail/fwd.hpp>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/span.hpp>
+#include <stl2/detail/swap.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// buffered_writer [Extension]
+//
+// A byte sink over a file descriptor with a large, page-aligned buffer of
+// user-chosen capacity. Output is assembled in place: prepare(n) returns
+// writable contiguous space for n bytes, into which copy, transform or
+// to_chars can write directly, and commit(n) appends what was written.
+// Full buffers go out with one write(2); large appends bypass the buffer
+// through writev(2).
+//
+// A writer opened with direct = true uses O_DIRECT where the file system
+// supports it: only whole pages are written until close(), which writes
+// the unaligned tail with O_DIRECT cleared.
+//
+// The destructor flushes but cannot report errors; call close() first to
+// observe them.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		class buffered_writer {
+		public:
+			static constexpr std::size_t default_capacity = std::size_t{1} << 20;
+			static constexpr std::size_t alignment = 4096;
+
+			buffered_writer() = default;
+
+			// Writes to fd, which remains owned by the caller.
+			explicit buffered_writer(int fd, std::size_t capacity = default_capacity)
+			: fd_{fd} { allocate(capacity); }
+
+			// Creates or truncates the file at path.
+			explicit buffered_writer(const std::filesystem::path& path,
+				std::size_t capacity = default_capacity, bool direct = false)
+			{
+				constexpr int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+				if (direct) {
+					fd_ = ::open(path.c_str(), flags | O_DIRECT, 0666);
+					direct_ = fd_ >= 0;
+				}
+				if (fd_ < 0) {
+					fd_ = ::open(path.c_str(), flags, 0666);
+				}
+				if (fd_ < 0) throw_errno("open");
+				owns_fd_ = true;
+				try {
+					allocate(capacity);
+				} catch (...) {
+					::close(std::exchange(fd_, -1));
+					throw;
+				}
+			}
+
+			buffered_writer(buffered_writer&& that) noexcept
+			: buffer_{std::move(that.buffer_)}
+			, capacity_{std::exchange(that.capacity_, 0)}
+			, size_{std::exchange(that.size_, 0)}
+			, fd_{std::exchange(that.fd_, -1)}
+			, owns_fd_{std::exchange(that.owns_fd_, false)}
+			, direct_{std::exchange(that.direct_, false)} {}
+
+			buffered_writer& operator=(buffered_writer&& that) noexcept {
+				buffered_writer tmp{std::move(that)};
+				swap(tmp);
+				return *this;
+			}
+
+			~buffered_writer() {
+				try {
+					close();
+				} catch (...) {}
+			}
+
+			int fd() const noexcept { return fd_; }
+			bool direct() const noexcept { return direct_; }
+			std::size_t capacity() const noexcept
+			{ return direct_ ? capacity_ - alignment : capacity_; }
+			// Bytes buffered but not yet written.
+			std::size_t size() const noexcept { return size_; }
+
+			// Contiguous space for at least n bytes, n <= capacity(), flushing
+			// as needed. The space remains valid until the next call of a
+			// non-const member.
+			span<std::byte> prepare(std::size_t n) {
+				STL2_EXPECT(n <= capacity());
+				if (capacity_ - size_ < n) {
+					flush_buffer(false);
+				}
+				return {buffer_.get() + size_, static_cast<std::ptrdiff_t>(capacity_ - size_)};
+			}
+
+			// Appends the first n bytes of the space last returned by prepare.
+			void commit(std::size_t n) noexcept {
+				STL2_EXPECT(n <= capacity_ - size_);
+				size_ += n;
+			}
+
+			void put(std::byte b) {
+				if (size_ == capacity_) {
+					flush_buffer(false);
+				}
+				buffer_[size_++] = b;
+			}
+
+			// Appends the object representation of the elements of s.
+			template<class T, __span::index_t Extent>
+			requires std::is_trivially_copyable_v<T>
+			void write(span<T, Extent> s) {
+				write(s.data(), static_cast<std::size_t>(s.size_bytes()));
+			}
+
+			void write(const void* p, std::size_t n) {
+				auto data = static_cast<const std::byte*>(p);
+				if (!direct_ && n > capacity_ - size_ && n >= capacity_ / 2) {
+					// Too large to be worth copying: one writev of the buffered
+					// bytes and the new ones.
+					iovec iov[] = {{buffer_.get(), size_}, {const_cast<std::byte*>(data), n}};
+					writev_all(iov);
+					size_ = 0;
+					return;
+				}
+				while (n > capacity_ - size_) {
+					const auto room = capacity_ - size_;
+					std::memcpy(buffer_.get() + size_, data, room);
+					size_ = capacity_;
+					data += room;
+					n -= room;
+					flush_buffer(false);
+				}
+				std::memcpy(buffer_.get() + size_, data, n);
+				size_ += n;
+			}
+
+			// Writes all buffered bytes; in direct mode, all whole pages.
+			void flush() { flush_buffer(false); }
+
+			// Writes all buffered bytes, and closes the file if owned. The
+			// file is closed even if the writes fail; their error is then
+			// the one reported, and the bytes not written are discarded.
+			void close() {
+				if (fd_ < 0) return;
+				try {
+					flush_buffer(true);
+				} catch (...) {
+					size_ = 0;
+					if (std::exchange(owns_fd_, false)) ::close(fd_);
+					fd_ = -1;
+					throw;
+				}
+				if (std::exchange(owns_fd_, false) && ::close(std::exchange(fd_, -1)) != 0) {
+					throw_errno("close");
+				}
+				fd_ = -1;
+			}
+
+			void swap(buffered_writer& that) noexcept {
+				using std::swap;
+				swap(buffer_, that.buffer_);
+				swap(capacity_, that.capacity_);
+				swap(size_, that.size_);
+				swap(fd_, that.fd_);
+				swap(owns_fd_, that.owns_fd_);
+				swap(direct_, that.direct_);
+			}
+			friend void swap(buffered_writer& x, buffered_writer& y) noexcept {
+				x.swap(y);
+			}
+		private:
+			struct deleter {
+				void operator()(std::byte* p) const noexcept {
+					::operator delete(p, std::align_val_t{alignment});
+				}
+			};
+
+			std::unique_ptr<std::byte[], deleter> buffer_;
+			std::size_t capacity_ = 0;
+			std::size_t size_ = 0;
+			int fd_ = -1;
+			bool owns_fd_ = false;
+			bool direct_ = false;
+
+			[[noreturn]] static void throw_errno(const char* what) {
+				throw std::system_error{errno, std::system_category(), what};
+			}
+
+			void allocate(std::size_t capacity) {
+				capacity_ = (capacity + alignment - 1) / alignment * alignment;
+				if (capacity_ == 0) capacity_ = alignment;
+				if (direct_) {
+					// Room for the partial page a direct flush leaves behind.
+					capacity_ += alignment;
+				}
+				buffer_.reset(static_cast<std::byte*>(
+					::operator new(capacity_, std::align_val_t{alignment})));
+			}
+
+			void write_all(const std::byte* data, std::size_t n) {
+				while (n != 0) {
+					const auto r = ::write(fd_, data, n);
+					if (r < 0) {
+						if (errno == EINTR) continue;
+						throw_errno("write");
+					}
+					data += r;
+					n -= static_cast<std::size_t>(r);
+				}
+			}
+
+			void writev_all(iovec (&iov)[2]) {
+				int first = iov[0].iov_len == 0;
+				while (first < 2) {
+					const auto r = ::writev(fd_, iov + first, 2 - first);
+					if (r < 0) {
+						if (errno == EINTR) continue;
+						throw_errno("writev");
+					}
+					// Skip what was written.
+					auto done = static_cast<std::size_t>(r);
+					for (; first < 2 && done >= iov[first].iov_len; ++first) {
+						done -= iov[first].iov_len;
+					}
+					if (first < 2) {
+						iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + done;
+						iov[first].iov_len -= done;
+					}
+				}
+			}
+
+			void flush_buffer(bool final) {
+				if (!direct_) {
+					write_all(buffer_.get(), size_);
+					size_ = 0;
+					return;
+				}
+				const auto whole = size_ / alignment * alignment;
+				write_all(buffer_.get(), whole);
+				const auto tail = size_ - whole;
+				if (tail != 0) {
+					std::memmove(buffer_.get(), buffer_.get() + whole, tail);
+				}
+				size_ = tail;
+				if (final && tail != 0) {
+					// O_DIRECT cannot write a partial block.
+					const int flags = ::fcntl(fd_, F_GETFL);
+					if (flags < 0 || ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT) < 0) {
+						throw_errno("fcntl");
+					}
+					direct_ = false;
+					write_all(buffer_.get(), tail);
+					size_ = 0;
+				}
+			}
+		};
+
+		///////////////////////////////////////////////////////////////////////
+		// fd_output_iterator [Extension]
+		//
+		// An output iterator that appends the object representation of each
+		// T assigned through it to a buffered_writer.
+		//
+		template<class T = char>
+		requires std::is_trivially_copyable_v<T>
+		class fd_output_iterator {
+		public:
+			using difference_type = std::ptrdiff_t;
+
+			constexpr fd_output_iterator() noexcept = default;
+			explicit fd_output_iterator(buffered_writer& w) noexcept
+			: writer_{std::addressof(w)} {}
+
+			fd_output_iterator& operator=(const T& t) {
+				if constexpr (sizeof(T) == 1) {
+					std::byte b;
+					std::memcpy(&b, std::addressof(t), 1);
+					writer_->put(b);
+				} else {
+					auto s = writer_->prepare(sizeof(T));
+					std::memcpy(s.data(), std::addressof(t), sizeof(T));
+					writer_->commit(sizeof(T));
+				}
+				return *this;
+			}
+
+			fd_output_iterator& operator*() noexcept { return *this; }
+			fd_output_iterator& operator++() noexcept { return *this; }
+			fd_output_iterator& operator++(int) noexcept { return *this; }
+
+			buffered_writer* writer() const noexcept { return writer_; }
+		private:
+			detail::raw_ptr<buffered_writer> writer_ = nullptr;
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+#endif // __linux__
+
+#endif
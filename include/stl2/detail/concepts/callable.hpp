@@ -13,6 +13,8 @@
 #ifndef STL2_DETAIL_CONCEPTS_CALLABLE_HPP
 #define STL2_DETAIL_CONCEPTS_CALLABLE_HPP
 
+#include <compare>
+
 #include <stl2/type_traits.hpp>
 #include <stl2/detail/concepts/compare.hpp>
 #include <stl2/detail/concepts/function.hpp>
@@ -185,6 +187,66 @@ STL2_OPEN_NAMESPACE {
 	template<class I, class R = less, class P = identity>
 	META_CONCEPT sortable = permutable<I> &&
 		indirect_strict_weak_order<R, projected<I, P>>;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Three-way comparators [Extension]
+	//
+	// A three-way comparator returns std::strong_ordering or
+	// std::weak_ordering, e.g., std::compare_three_way. One call orders a
+	// pair that a strict weak order needs two calls to find equivalent;
+	// sort, merge, the binary searches and the set algorithms accept one in
+	// place of a boolean comparator.
+	//
+	namespace ext {
+		template<class R, class T, class U>
+		META_CONCEPT three_way_order =
+			regular_invocable<R, T, U> && regular_invocable<R, U, T> &&
+			convertible_to<invoke_result_t<R, T, U>, std::weak_ordering> &&
+			convertible_to<invoke_result_t<R, U, T>, std::weak_ordering>;
+
+		template<class F, class I1, class I2 = I1>
+		META_CONCEPT indirect_three_way_order =
+			readable<I1> &&
+			readable<I2> &&
+			copy_constructible<F> &&
+			three_way_order<F&, iter_value_t<I1>&, iter_value_t<I2>&> &&
+			three_way_order<F&, iter_value_t<I1>&, iter_reference_t<I2>> &&
+			three_way_order<F&, iter_reference_t<I1>, iter_value_t<I2>&> &&
+			three_way_order<F&, iter_reference_t<I1>, iter_reference_t<I2>> &&
+			three_way_order<F&, iter_common_reference_t<I1>, iter_common_reference_t<I2>>;
+
+		template<class I1, class I2, class Out, class R = std::compare_three_way,
+			class P1 = identity, class P2 = identity>
+		META_CONCEPT three_way_mergeable = input_iterator<I1> && input_iterator<I2> &&
+			weakly_incrementable<Out> &&
+			indirectly_copyable<I1, Out> && indirectly_copyable<I2, Out> &&
+			indirect_three_way_order<R, projected<I1, P1>, projected<I2, P2>>;
+
+		template<class I, class R = std::compare_three_way, class P = identity>
+		META_CONCEPT three_way_sortable = permutable<I> &&
+			indirect_three_way_order<R, projected<I, P>>;
+	} // namespace ext
+
+	namespace detail {
+		// Orders a pair with one call of a three-way comparator.
+		template<class Comp, class T, class U>
+		constexpr std::weak_ordering __compare_3way(Comp& comp, T&& t, U&& u) {
+			return __stl2::invoke(comp, static_cast<T&&>(t), static_cast<U&&>(u));
+		}
+
+		// Adapts a three-way comparator to the strict weak order of
+		// algorithms that already make a single call per pair.
+		template<class Comp>
+		struct __three_way_less {
+			Comp* comp_;
+
+			template<class T, class U>
+			requires ext::three_way_order<Comp&, T, U>
+			constexpr bool operator()(T&& t, U&& u) const {
+				return __compare_3way(*comp_, static_cast<T&&>(t), static_cast<U&&>(u)) < 0;
+			}
+		};
+	} // namespace detail
 } STL2_CLOSE_NAMESPACE
 
 #endif
@@ -0,0 +1,71 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_EXECUTION_HPP
+#define STL2_DETAIL_EXECUTION_HPP
+
+#include <cstddef>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/stop_condition.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Execution policies [Extension]
+//
+// ext::execution::par requests that an algorithm split its input into
+// contiguous chunks, one per thread. Chunks are never smaller than the
+// policy's grain, so small inputs run on fewer threads, or only on the
+// calling thread.
+//
+// Input that is not random access is instead read by the calling thread
+// in batches of grain elements, which worker threads process while the
+// reader fills the next ones. At most in_flight batches exist at once, so
+// a slow stage stalls the reader instead of growing the buffers.
+//
+// The algorithms declare their parallel overloads alongside the others,
+// but the threads that run them are defined in
+// <stl2/detail/algorithm/parallel.hpp>, which <stl2/algorithm.hpp>
+// includes, so that the sequential algorithm headers need not pull in
+// <thread>.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext::execution {
+		struct parallel_policy {
+			// The most threads to use, including the calling thread; zero
+			// means std::thread::hardware_concurrency().
+			unsigned threads = 0;
+			// The fewest elements worth handing to a thread.
+			std::ptrdiff_t grain = 1 << 14;
+			// The most batches of input read ahead at once; zero means
+			// twice the number of worker threads.
+			unsigned in_flight = 0;
+			// Whether an algorithm that writes output, like transform,
+			// writes the batches in input order rather than as they finish.
+			bool ordered = true;
+		};
+
+		inline constexpr parallel_policy par{};
+	} // namespace ext::execution
+
+	namespace detail {
+		template<class I>
+		META_CONCEPT _Batchable = input_iterator<I> && (forward_iterator<I> ||
+			(move_constructible<iter_value_t<I>> &&
+				constructible_from<iter_value_t<I>, iter_reference_t<I>>));
+
+		// Runs the parallel overloads of the algorithm object Alg for input
+		// iterator I; specialized in <stl2/detail/algorithm/parallel.hpp>.
+		template<class Alg, class I>
+		struct __parallel_algorithm;
+	} // namespace detail
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,57 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_ITERATOR_BLOCK_UNPACK_HPP
+#define STL2_DETAIL_ITERATOR_BLOCK_UNPACK_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+STL2_OPEN_NAMESPACE {
+	// Extension: iterators over packed encodings (e.g. bitunpacked_view's)
+	// can decode a whole range [first, last) into an array of values with
+	// first.unpack(last, out) much faster than element by element.
+	// Algorithms decode such ranges in blocks and loop over the arrays.
+	template<class I, class S>
+	META_CONCEPT _BlockUnpackable = same_as<I, S> && random_access_iterator<I> &&
+		requires(const I& i, iter_value_t<I>* out) {
+			{ i.unpack(i, out) } -> same_as<iter_value_t<I>*>;
+		};
+
+	inline constexpr std::ptrdiff_t __unpack_block_size = 128;
+
+	// Calls f(p, n) for successive arrays of the n <= __unpack_block_size
+	// values of [first, last). During constant evaluation, where unpack
+	// may not be usable, the arrays hold one element each.
+	template<class I, class F>
+	requires _BlockUnpackable<I, I>
+	constexpr void __for_each_unpacked(I first, const I& last, F&& f) {
+		if (std::is_constant_evaluated()) {
+			for (; first != last; ++first) {
+				const iter_value_t<I> v = *first;
+				f(&v, iter_difference_t<I>{1});
+			}
+			return;
+		}
+		iter_value_t<I> buf[__unpack_block_size];
+		while (first != last) {
+			auto n = last - first;
+			if (n > __unpack_block_size) n = __unpack_block_size;
+			auto mid = first + n;
+			first.unpack(mid, buf);
+			f(static_cast<const iter_value_t<I>*>(buf), n);
+			first = std::move(mid);
+		}
+	}
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -15,7 +15,9 @@
 
 #include <memory>
 #include <stl2/type_traits.hpp>
+#include <stl2/detail/ebo_box.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
 #include <stl2/detail/variant.hpp>
 #include <stl2/detail/iterator/concepts.hpp>
 #include <stl2/detail/iterator/operations.hpp>
@@ -29,6 +31,113 @@ STL2_OPEN_NAMESPACE {
 	class common_iterator;
 
 	namespace __common_iterator {
+		// A stateless sentinel can be conjured from nothing, so a
+		// common_iterator over one needs only an iterator and a flag.
+		template<class S>
+		META_CONCEPT _CompactSentinel = std::is_empty_v<S> &&
+			std::is_trivially_default_constructible_v<S> &&
+			std::is_trivially_copyable_v<S>;
+
+		template<class I, class S>
+		class STL2_EMPTY_BASES compact_variant
+		: private detail::ebo_box<S, compact_variant<I, S>> {
+			using box_t = detail::ebo_box<S, compact_variant<I, S>>;
+
+			I i_{};
+			bool is_sentinel_ = false;
+		public:
+			compact_variant() = default;
+
+			template<class... Args>
+			requires constructible_from<I, Args...>
+			constexpr compact_variant(std::in_place_index_t<0>, Args&&... args)
+			noexcept(std::is_nothrow_constructible_v<I, Args...>)
+			: i_(std::forward<Args>(args)...) {}
+			template<class... Args>
+			requires constructible_from<S, Args...>
+			constexpr compact_variant(std::in_place_index_t<1>, Args&&... args)
+			noexcept(std::is_nothrow_constructible_v<S, Args...>)
+			: box_t{std::forward<Args>(args)...}, is_sentinel_{true} {}
+
+			constexpr std::size_t index() const noexcept {
+				return is_sentinel_;
+			}
+			constexpr bool valueless_by_exception() const noexcept {
+				return false;
+			}
+
+			template<std::size_t N>
+			requires (N < 2)
+			constexpr auto& get() & noexcept {
+				STL2_EXPECT(index() == N);
+				if constexpr (N == 0) return i_;
+				else return box_t::get();
+			}
+			template<std::size_t N>
+			requires (N < 2)
+			constexpr const auto& get() const& noexcept {
+				STL2_EXPECT(index() == N);
+				if constexpr (N == 0) return i_;
+				else return box_t::get();
+			}
+			template<std::size_t N>
+			requires (N < 2)
+			constexpr auto&& get() && noexcept {
+				return std::move(get<N>());
+			}
+
+			template<std::size_t N, class Arg>
+			requires (N == 0 && assignable_from<I&, Arg>) ||
+				(N == 1 && assignable_from<S&, Arg>)
+			constexpr auto& emplace(Arg&& arg) {
+				is_sentinel_ = N == 1;
+				if constexpr (N == 0) return i_ = std::forward<Arg>(arg);
+				else return box_t::get() = std::forward<Arg>(arg);
+			}
+		};
+
+		template<class I, class S>
+		using variant_t = meta::if_c<_CompactSentinel<S>,
+			compact_variant<I, S>, std::variant<I, S>>;
+
+		template<std::size_t N, class V>
+		constexpr decltype(auto) get(V&& v) noexcept {
+			if constexpr (_SpecializationOf<V, std::variant>)
+				return __stl2::__unchecked_get<N>(static_cast<V&&>(v));
+			else
+				return static_cast<V&&>(v).template get<N>();
+		}
+
+		// With exactly two alternatives, testing the indices directly is
+		// cheaper than the dispatch table std::visit builds.
+		template<class F, class V>
+		constexpr decltype(auto) visit(F&& f, V&& v) {
+			STL2_EXPECT(!v.valueless_by_exception());
+			if (v.index() == 0) {
+				return static_cast<F&&>(f)(get<0>(static_cast<V&&>(v)));
+			}
+			return static_cast<F&&>(f)(get<1>(static_cast<V&&>(v)));
+		}
+		template<class F, class V1, class V2>
+		constexpr decltype(auto) visit(F&& f, V1&& v1, V2&& v2) {
+			STL2_EXPECT(!v1.valueless_by_exception());
+			STL2_EXPECT(!v2.valueless_by_exception());
+			if (v1.index() == 0) {
+				if (v2.index() == 0) {
+					return static_cast<F&&>(f)(get<0>(static_cast<V1&&>(v1)),
+						get<0>(static_cast<V2&&>(v2)));
+				}
+				return static_cast<F&&>(f)(get<0>(static_cast<V1&&>(v1)),
+					get<1>(static_cast<V2&&>(v2)));
+			}
+			if (v2.index() == 0) {
+				return static_cast<F&&>(f)(get<1>(static_cast<V1&&>(v1)),
+					get<0>(static_cast<V2&&>(v2)));
+			}
+			return static_cast<F&&>(f)(get<1>(static_cast<V1&&>(v1)),
+				get<1>(static_cast<V2&&>(v2)));
+		}
+
 		template<class T>
 		struct operator_arrow_proxy {
 			template<class U>
@@ -55,7 +164,7 @@ STL2_OPEN_NAMESPACE {
 			friend iter_rvalue_reference_t<I>
 			iter_move(const common_iterator<I, S>& i)
 			noexcept(noexcept(__stl2::iter_move(std::declval<const I&>()))) {
-				return __stl2::iter_move(__stl2::__unchecked_get<I>(v(i)));
+				return __stl2::iter_move(__common_iterator::get<0>(v(i)));
 			}
 			template<class I1, class S1, indirectly_swappable<I1> I2, class S2>
 			friend void iter_swap(
@@ -64,8 +173,8 @@ STL2_OPEN_NAMESPACE {
 				std::declval<const I2&>())))
 			{
 				__stl2::iter_swap(
-					__stl2::__unchecked_get<I1>(v(x)),
-					__stl2::__unchecked_get<I2>(v(y)));
+					__common_iterator::get<0>(v(x)),
+					__common_iterator::get<0>(v(y)));
 			}
 
 			// Not to spec: here avoid GCC hidden friend constraint bugs
@@ -74,7 +183,7 @@ STL2_OPEN_NAMESPACE {
 			friend iter_difference_t<I2> operator-(
 				const common_iterator<I1, S1>& x, const common_iterator<I2, S2>& y)
 			{
-				return __stl2::__unchecked_visit(
+				return __common_iterator::visit(
 					difference_visitor<I1, S1, I2, S2>{}, v(x), v(y));
 			}
 
@@ -101,11 +210,11 @@ STL2_OPEN_NAMESPACE {
 		struct convert_visitor {
 			constexpr auto operator()(const I2& i) const
 			STL2_NOEXCEPT_RETURN(
-				std::variant<I1, S1>{std::in_place_index<0>, i}
+				variant_t<I1, S1>{std::in_place_index<0>, i}
 			)
 			constexpr auto operator()(const S2& s) const
 			STL2_NOEXCEPT_RETURN(
-				std::variant<I1, S1>{std::in_place_index<1>, s}
+				variant_t<I1, S1>{std::in_place_index<1>, s}
 			)
 		};
 
@@ -113,7 +222,7 @@ STL2_OPEN_NAMESPACE {
 		requires convertible_to<const I2&, I1> && convertible_to<const S2&, S1> &&
 			assignable_from<I1&, const I2&> && assignable_from<S1&, const S2&>
 		struct assign_visitor {
-			std::variant<I1, S1>& v_;
+			variant_t<I1, S1>& v_;
 
 			void operator()(I1& i1, const I2& i2) const
 			STL2_NOEXCEPT_RETURN(
@@ -125,11 +234,11 @@ STL2_OPEN_NAMESPACE {
 			)
 			void operator()(const S1&, const I2& i2) const
 			STL2_NOEXCEPT_RETURN(
-				(void)v_.template emplace<I1>(i2)
+				(void)v_.template emplace<0>(i2)
 			)
 			void operator()(const I1&, const S2& s2) const
 			STL2_NOEXCEPT_RETURN(
-				(void)v_.template emplace<S1>(s2)
+				(void)v_.template emplace<1>(s2)
 			)
 		};
 
@@ -166,18 +275,18 @@ STL2_OPEN_NAMESPACE {
 	{
 		friend __common_iterator::access;
 
-		std::variant<I, S> v_;
+		__common_iterator::variant_t<I, S> v_;
 
 	public:
 		constexpr common_iterator() = default;
 
 		constexpr common_iterator(I i)
-		noexcept(std::is_nothrow_constructible_v<std::variant<I, S>, I>) // strengthened
-		: v_{std::in_place_type<I>, std::move(i)} {}
+		noexcept(std::is_nothrow_move_constructible_v<I>) // strengthened
+		: v_{std::in_place_index<0>, std::move(i)} {}
 
 		constexpr common_iterator(S s)
-		noexcept(std::is_nothrow_constructible_v<std::variant<I, S>, S>) // strengthened
-		: v_{std::in_place_type<S>, std::move(s)} {}
+		noexcept(std::is_nothrow_move_constructible_v<S>) // strengthened
+		: v_{std::in_place_index<1>, std::move(s)} {}
 
 		template<class I2, class S2>
 		requires convertible_to<const I2&, I> && convertible_to<const S2&, S>
@@ -185,7 +294,7 @@ STL2_OPEN_NAMESPACE {
 		noexcept(
 			std::is_nothrow_constructible_v<I, const I2&> &&
 			std::is_nothrow_constructible_v<S, const S2&>) // strengthened
-		: v_{__stl2::__unchecked_visit(
+		: v_{__common_iterator::visit(
 			__common_iterator::convert_visitor<I, S, I2, S2>{},
 			__common_iterator::access::v(i))}
 		{}
@@ -198,7 +307,7 @@ STL2_OPEN_NAMESPACE {
 			std::is_nothrow_assignable_v<I&, const I2&> &&
 			std::is_nothrow_assignable_v<S&, const S2&>) // strengthened
 		{
-			__stl2::__unchecked_visit(
+			__common_iterator::visit(
 				__common_iterator::assign_visitor<I, S, I2, S2>{v_}, v_,
 				__common_iterator::access::v(i));
 			return *this;
@@ -206,12 +315,12 @@ STL2_OPEN_NAMESPACE {
 
 		decltype(auto) operator*()
 		noexcept(noexcept(*std::declval<I&>())) { // strengthened
-			return *__stl2::__unchecked_get<I>(v_);
+			return *__common_iterator::get<0>(v_);
 		}
 		decltype(auto) operator*() const
 		noexcept(noexcept(*std::declval<const I&>())) // strengthened
 		requires __dereferenceable<const I> {
-			return *__stl2::__unchecked_get<I>(v_);
+			return *__common_iterator::get<0>(v_);
 		}
 		decltype(auto) operator->() const
 		requires readable<const I> &&
@@ -220,25 +329,25 @@ STL2_OPEN_NAMESPACE {
 			 constructible_from<iter_value_t<I>, iter_reference_t<I>>)
 		{
 			if constexpr (std::is_pointer_v<I> || _HasArrow<const I>)
-				return __stl2::__unchecked_get<I>(v_);
+				return __common_iterator::get<0>(v_);
 			else if constexpr (std::is_reference_v<iter_reference_t<const I>>) { // TODO: file LWG issue (const I instead of I)
-				auto&& tmp = *__stl2::__unchecked_get<I>(v_);
+				auto&& tmp = *__common_iterator::get<0>(v_);
 				return std::addressof(tmp);
 			} else {
 				return __common_iterator::operator_arrow_proxy<iter_value_t<I>>{
-					*__stl2::__unchecked_get<I>(v_)
+					*__common_iterator::get<0>(v_)
 				};
 			}
 		}
 
 		common_iterator& operator++()
 		noexcept(noexcept(++std::declval<I&>())) { // strengthened
-			++__stl2::__unchecked_get<I>(v_);
+			++__common_iterator::get<0>(v_);
 			return *this;
 		}
 		decltype(auto) operator++(int)
 		{
-			auto& i = __stl2::__unchecked_get<I>(v_);
+			auto& i = __common_iterator::get<0>(v_);
 			if constexpr (forward_iterator<I>) {
 				auto tmp = *this;
 				++i;
@@ -251,7 +360,7 @@ STL2_OPEN_NAMESPACE {
 		requires sentinel_for<S, I2>
 		friend bool
 		operator==(const common_iterator& x, const common_iterator<I2, S2>& y) {
-			return __stl2::__unchecked_visit(
+			return __common_iterator::visit(
 				__common_iterator::equal_visitor<I, S, I2, S2>{}, x.v_,
 				__common_iterator::access::v(y));
 		}
@@ -281,6 +390,33 @@ STL2_OPEN_NAMESPACE {
 	struct iterator_category<common_iterator<I, S>> {
 		using type = forward_iterator_tag;
 	};
+
+	// Extension: a range [common_iterator(i), common_iterator(s)) is "peeled"
+	// by algorithms, which run their loop on the underlying (i, s) and avoid
+	// re-examining the alternative on every step.
+	template<class I, class S>
+	META_CONCEPT _PeelableCommon =
+		same_as<I, S> && _SpecializationOf<I, common_iterator>;
+
+	namespace ext {
+		template<class I, class S>
+		constexpr bool peelable(const common_iterator<I, S>& first,
+			const common_iterator<I, S>& last) noexcept
+		{
+			return __common_iterator::access::v(first).index() == 0 &&
+				__common_iterator::access::v(last).index() == 1;
+		}
+
+		template<class I, class S>
+		constexpr const I& peel_iterator(const common_iterator<I, S>& i) noexcept {
+			return __common_iterator::get<0>(__common_iterator::access::v(i));
+		}
+
+		template<class I, class S>
+		constexpr const S& peel_sentinel(const common_iterator<I, S>& s) noexcept {
+			return __common_iterator::get<1>(__common_iterator::access::v(s));
+		}
+	}
 } STL2_CLOSE_NAMESPACE
 
 #endif
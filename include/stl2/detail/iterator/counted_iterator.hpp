@@ -294,6 +294,15 @@ STL2_OPEN_NAMESPACE {
 		}
 	}
 
+	// Extension: with contiguous I, [counted_iterator(i, n), default_sentinel)
+	// denotes the same elements as [i, i + n). Algorithms loop over the latter,
+	// which needs no count alongside the iterator. (Merely random-access
+	// iterators are excluded: e.g. repeat_view's iterators never advance.)
+	template<class I, class S>
+	META_CONCEPT _ContiguousCounted = same_as<S, default_sentinel_t> &&
+		_SpecializationOf<I, counted_iterator> &&
+		contiguous_iterator<typename I::iterator_type>;
+
 	namespace ext {
 		template<input_or_output_iterator I>
 		constexpr auto uncounted(const I& i)
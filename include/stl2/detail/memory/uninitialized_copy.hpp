@@ -14,7 +14,9 @@
 #define STL2_DETAIL_MEMORY_UNINITIALIZED_COPY_HPP
 
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/parallel.hpp>
 #include <stl2/detail/algorithm/results.hpp>
+#include <stl2/detail/iterator/counted_iterator.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
@@ -31,6 +33,12 @@ STL2_OPEN_NAMESPACE {
 		template<input_iterator I, sentinel_for<I> S1, _NoThrowForwardIterator O, _NoThrowSentinel<O> S2>
 		requires constructible_from<iter_value_t<O>, iter_reference_t<I>>
 		uninitialized_copy_result<I, O> operator()(I ifirst, S1 ilast, O ofirst, S2 olast) const {
+			if constexpr (_ContiguousCounted<I, S1>) {
+				auto base = ifirst.base();
+				auto [in, out] = (*this)(base, base + ifirst.count(),
+					std::move(ofirst), std::move(olast));
+				return {ext::recounted(ifirst, in, in - base), std::move(out)};
+			}
 			auto guard = detail::destroy_guard{ofirst};
 			for (; ifirst != ilast && ofirst != olast; (void) ++ifirst, (void)++ofirst) {
 				__stl2::__construct_at(*ofirst, *ifirst);
@@ -39,12 +47,38 @@ STL2_OPEN_NAMESPACE {
 			return {std::move(ifirst), std::move(ofirst)};
 		}
 
+		template<random_access_iterator I, sized_sentinel_for<I> S1,
+			_NoThrowForwardIterator O, _NoThrowSentinel<O> S2>
+		requires random_access_iterator<O> && sized_sentinel_for<S2, O> &&
+			constructible_from<iter_value_t<O>, iter_reference_t<I>>
+		uninitialized_copy_result<I, O> operator()(const ext::execution::parallel_policy& pol,
+			I ifirst, S1 ilast, O ofirst, S2 olast) const
+		{
+			const auto ni = static_cast<std::ptrdiff_t>(ilast - ifirst);
+			const auto no = static_cast<std::ptrdiff_t>(olast - ofirst);
+			const auto n = ni < no ? ni : no;
+			detail::__parallel_construct(pol, n,
+				[&](auto lo, auto hi) {
+					(*this)(ifirst + lo, ifirst + hi, ofirst + lo, ofirst + hi);
+				},
+				[&](auto lo, auto hi) { destroy(ofirst + lo, ofirst + hi); });
+			return {ifirst + n, ofirst + n};
+		}
+
 		template<input_range IR, _NoThrowForwardRange OR>
 		requires constructible_from<iter_value_t<iterator_t<OR>>, iter_reference_t<iterator_t<IR>>>
 		uninitialized_copy_result<safe_iterator_t<IR>, safe_iterator_t<OR>>
 		operator()(IR&& in, OR&& out) const {
 			return (*this)(begin(in), end(in), begin(out), end(out));
 		}
+
+		template<random_access_range IR, _NoThrowForwardRange OR>
+		requires sized_range<IR> && random_access_range<OR> && sized_range<OR> &&
+			constructible_from<iter_value_t<iterator_t<OR>>, iter_reference_t<iterator_t<IR>>>
+		uninitialized_copy_result<safe_iterator_t<IR>, safe_iterator_t<OR>>
+		operator()(const ext::execution::parallel_policy& pol, IR&& in, OR&& out) const {
+			return (*this)(pol, begin(in), end(in), begin(out), end(out));
+		}
 	};
 
 	inline constexpr __uninitialized_copy_fn uninitialized_copy{};
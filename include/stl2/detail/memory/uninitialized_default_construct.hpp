@@ -15,6 +15,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/parallel.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
@@ -27,6 +28,11 @@ STL2_OPEN_NAMESPACE {
 		template<_NoThrowForwardIterator I, _NoThrowSentinel<I> S>
 		requires default_initializable<iter_value_t<I>>
 		I operator()(I first, S last) const {
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto i = (*this)(base, base + first.count());
+				return ext::recounted(first, i, i - base);
+			}
 			auto guard = detail::destroy_guard{first};
 			for (; first != last; ++first) {
 				__stl2::__default_construct_at(*first);
@@ -35,11 +41,30 @@ STL2_OPEN_NAMESPACE {
 			return first;
 		}
 
+		template<_NoThrowForwardIterator I, _NoThrowSentinel<I> S>
+		requires random_access_iterator<I> && sized_sentinel_for<S, I> &&
+			default_initializable<iter_value_t<I>>
+		I operator()(const ext::execution::parallel_policy& pol, I first, S last) const {
+			const auto n = last - first;
+			detail::__parallel_construct(pol, n,
+				[&](auto lo, auto hi) { (*this)(first + lo, first + hi); },
+				[&](auto lo, auto hi) { destroy(first + lo, first + hi); });
+			return first + n;
+		}
+
 		template<_NoThrowForwardRange Rng>
 		requires default_initializable<iter_value_t<iterator_t<Rng>>>
 		safe_iterator_t<Rng> operator()(Rng&& rng) const {
 			return (*this)(begin(rng), end(rng));
 		}
+
+		template<_NoThrowForwardRange Rng>
+		requires random_access_range<Rng> && sized_range<Rng> &&
+			default_initializable<iter_value_t<iterator_t<Rng>>>
+		safe_iterator_t<Rng>
+		operator()(const ext::execution::parallel_policy& pol, Rng&& rng) const {
+			return (*this)(pol, begin(rng), end(rng));
+		}
 	};
 
 	inline constexpr __uninitialized_default_construct_fn uninitialized_default_construct{};
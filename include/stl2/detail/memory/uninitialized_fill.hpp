@@ -15,6 +15,7 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/fwd.hpp>
+#include <stl2/detail/parallel.hpp>
 #include <stl2/detail/memory/concepts.hpp>
 #include <stl2/detail/memory/construct_at.hpp>
 #include <stl2/detail/memory/destroy.hpp>
@@ -27,6 +28,11 @@ STL2_OPEN_NAMESPACE {
 		template<_NoThrowForwardIterator I, _NoThrowSentinel<I> S, class T>
 		requires constructible_from<iter_value_t<I>, const T&>
 		I operator()(I first, S last, const T& x) const {
+			if constexpr (_ContiguousCounted<I, S>) {
+				auto base = first.base();
+				auto i = (*this)(base, base + first.count(), x);
+				return ext::recounted(first, i, i - base);
+			}
 			auto guard = detail::destroy_guard{first};
 			for (; first != last; ++first) {
 				__stl2::__construct_at(*first, x);
@@ -35,11 +41,34 @@ STL2_OPEN_NAMESPACE {
 			return first;
 		}
 
+		// Constructs in parallel chunks, so that pages of fresh memory are
+		// first touched by the threads that construct them.
+		template<_NoThrowForwardIterator I, _NoThrowSentinel<I> S, class T>
+		requires random_access_iterator<I> && sized_sentinel_for<S, I> &&
+			constructible_from<iter_value_t<I>, const T&>
+		I operator()(const ext::execution::parallel_policy& pol,
+			I first, S last, const T& x) const
+		{
+			const auto n = last - first;
+			detail::__parallel_construct(pol, n,
+				[&](auto lo, auto hi) { (*this)(first + lo, first + hi, x); },
+				[&](auto lo, auto hi) { destroy(first + lo, first + hi); });
+			return first + n;
+		}
+
 		template<_NoThrowForwardRange R, class T>
 		requires constructible_from<iter_value_t<iterator_t<R>>, const T&>
 		safe_iterator_t<R> operator()(R&& r, const T& x) const {
 			return (*this)(begin(r), end(r), x);
 		}
+
+		template<_NoThrowForwardRange R, class T>
+		requires random_access_range<R> && sized_range<R> &&
+			constructible_from<iter_value_t<iterator_t<R>>, const T&>
+		safe_iterator_t<R>
+		operator()(const ext::execution::parallel_policy& pol, R&& r, const T& x) const {
+			return (*this)(pol, begin(r), end(r), x);
+		}
 	};
 
 	inline constexpr __uninitialized_fill_fn uninitialized_fill{};
@@ -0,0 +1,297 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_PARALLEL_HPP
+#define STL2_DETAIL_PARALLEL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/execution.hpp>
+#include <stl2/detail/stop_condition.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// The threads behind ext::execution::parallel_policy (see
+// <stl2/detail/execution.hpp>).
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		inline std::ptrdiff_t
+		__thread_count(const ext::execution::parallel_policy& pol) noexcept {
+			std::ptrdiff_t threads = pol.threads ? pol.threads : std::thread::hardware_concurrency();
+			return threads < 1 ? 1 : threads;
+		}
+
+		// The policy's grain, at least one element.
+		constexpr std::ptrdiff_t
+		__grain(const ext::execution::parallel_policy& pol) noexcept {
+			return pol.grain < 1 ? 1 : pol.grain;
+		}
+
+		inline std::ptrdiff_t
+		__chunk_count(const ext::execution::parallel_policy& pol, std::ptrdiff_t n) noexcept {
+			const auto threads = __thread_count(pol);
+			const auto k = n / __grain(pol);
+			return k < 1 ? 1 : k < threads ? k : threads;
+		}
+
+		// The offset of chunk i when [0, n) is split into k nearly equal chunks.
+		constexpr std::ptrdiff_t
+		__chunk_begin(std::ptrdiff_t n, std::ptrdiff_t k, std::ptrdiff_t i) noexcept {
+			const auto rem = n % k;
+			return n / k * i + (i < rem ? i : rem);
+		}
+
+		// Calls f(lo, hi) for each chunk [lo, hi) of [0, n), each but the first
+		// on a new thread. Given a poll, each chunk is instead handed to f in
+		// pieces of __grain(pol) elements, and abandoned once poll() is true.
+		// Returns the exception, if any, thrown by each chunk.
+		template<class F, class Poll = __never_stop>
+		std::vector<std::exception_ptr>
+		__parallel_chunks(const ext::execution::parallel_policy& pol, std::ptrdiff_t n, F& f,
+			Poll&& poll = {})
+		{
+			const auto k = __chunk_count(pol, n);
+			std::vector<std::exception_ptr> errors(static_cast<std::size_t>(k));
+			auto run = [&](std::ptrdiff_t i) noexcept {
+				try {
+					const auto lo = __chunk_begin(n, k, i);
+					const auto hi = __chunk_begin(n, k, i + 1);
+					if constexpr (same_as<__uncvref<Poll>, __never_stop>) {
+						f(lo, hi);
+					} else {
+						const auto step = __grain(pol);
+						for (auto b = lo; b < hi && !poll(); b += step) {
+							f(b, hi - b > step ? b + step : hi);
+						}
+					}
+				} catch (...) {
+					errors[static_cast<std::size_t>(i)] = std::current_exception();
+				}
+			};
+
+			std::vector<std::thread> threads;
+			threads.reserve(static_cast<std::size_t>(k - 1));
+			for (std::ptrdiff_t i = 1; i < k; ++i) {
+				try {
+					threads.emplace_back(run, i);
+				} catch (...) {
+					// Out of threads: this chunk runs here instead.
+					run(i);
+				}
+			}
+			run(0);
+			for (auto& t : threads) {
+				t.join();
+			}
+			return errors;
+		}
+
+		inline void __rethrow_first(const std::vector<std::exception_ptr>& errors) {
+			for (auto& e : errors) {
+				if (e) std::rethrow_exception(e);
+			}
+		}
+
+		// Constructs [0, n) in parallel chunks with construct(lo, hi), which
+		// must leave its chunk unconstructed when it throws. If any chunk
+		// throws, the others are destroyed with destroy(lo, hi), and the
+		// first exception is rethrown.
+		template<class Construct, class Destroy>
+		void __parallel_construct(const ext::execution::parallel_policy& pol,
+			std::ptrdiff_t n, Construct construct, Destroy destroy)
+		{
+			const auto errors = __parallel_chunks(pol, n, construct);
+			std::exception_ptr first_error;
+			for (auto& e : errors) {
+				if (e) {
+					first_error = e;
+					break;
+				}
+			}
+			if (!first_error) return;
+
+			const auto k = static_cast<std::ptrdiff_t>(errors.size());
+			for (std::ptrdiff_t i = 0; i < k; ++i) {
+				if (!errors[static_cast<std::size_t>(i)]) {
+					destroy(__chunk_begin(n, k, i), __chunk_begin(n, k, i + 1));
+				}
+			}
+			std::rethrow_exception(first_error);
+		}
+
+		// A reusable buffer for a batch of input. Forward iterators are
+		// buffered themselves; the elements of an input-only range are
+		// copied out, since they do not outlive the next increment.
+		template<_Batchable I>
+		class __batch_buffer {
+		private:
+			using element_t = meta::if_c<forward_iterator<I>, I, iter_value_t<I>>;
+			std::vector<element_t> items_;
+		public:
+			// Reads at most n elements from [first, last), advancing first.
+			// Returns false if there were none.
+			template<sentinel_for<I> S>
+			bool fill(I& first, const S& last, std::ptrdiff_t n) {
+				items_.clear();
+				for (; static_cast<std::ptrdiff_t>(items_.size()) < n && first != last; ++first) {
+					if constexpr (forward_iterator<I>) {
+						items_.push_back(first);
+					} else {
+						items_.emplace_back(*first);
+					}
+				}
+				return !items_.empty();
+			}
+
+			std::size_t size() const noexcept { return items_.size(); }
+
+			decltype(auto) operator[](std::size_t i) {
+				if constexpr (forward_iterator<I>) {
+					return *items_[i];
+				} else {
+					return (items_[i]);
+				}
+			}
+		};
+
+		// A pipeline over input of unknown length. The calling thread reads
+		// batches with fill(b), which returns false once the input is
+		// exhausted; worker threads call process(b); and the calling thread
+		// hands each processed batch to commit(b) - in the order the batches
+		// were read, if ordered - before reusing it. Given a poll, reading
+		// stops once poll() is true. The first exception stops the pipeline
+		// and is rethrown once the workers have exited.
+		template<class Batch, class Fill, class Process, class Commit,
+			class Poll = __never_stop>
+		void __parallel_batches(const ext::execution::parallel_policy& pol, bool ordered,
+			Fill fill, Process process, Commit commit, Poll&& poll = {})
+		{
+			struct slot {
+				Batch batch{};
+				std::size_t seq = 0;
+				std::exception_ptr error;
+			};
+
+			const auto workers = __thread_count(pol) - 1;
+			const auto slots = pol.in_flight ? std::ptrdiff_t{pol.in_flight} :
+				workers > 0 ? 2 * workers : 1;
+			std::vector<slot> pool(static_cast<std::size_t>(slots));
+			std::vector<slot*> free_slots, finished;
+			std::deque<slot*> queued;
+			for (auto& s : pool) {
+				free_slots.push_back(&s);
+			}
+
+			std::mutex m;
+			std::condition_variable work_cv, done_cv;
+			bool stop = false;
+			auto work = [&]() noexcept {
+				std::unique_lock lock{m};
+				for (;;) {
+					work_cv.wait(lock, [&] { return stop || !queued.empty(); });
+					if (stop) return;
+					auto* s = queued.front();
+					queued.pop_front();
+					lock.unlock();
+					try {
+						process(s->batch);
+					} catch (...) {
+						s->error = std::current_exception();
+					}
+					lock.lock();
+					finished.push_back(s);
+					done_cv.notify_one();
+				}
+			};
+
+			struct joiner {
+				std::mutex& m;
+				std::condition_variable& work_cv;
+				bool& stop;
+				std::vector<std::thread> threads;
+
+				~joiner() {
+					{
+						std::lock_guard lock{m};
+						stop = true;
+					}
+					work_cv.notify_all();
+					for (auto& t : threads) {
+						t.join();
+					}
+				}
+			} guard{m, work_cv, stop, {}};
+			guard.threads.reserve(static_cast<std::size_t>(workers > 0 ? workers : 0));
+			for (std::ptrdiff_t i = 0; i < workers; ++i) {
+				try {
+					guard.threads.emplace_back(work);
+				} catch (...) {
+					// Out of threads: make do with those we have.
+					break;
+				}
+			}
+
+			if (guard.threads.empty()) {
+				auto& b = pool.front().batch;
+				while (!poll() && fill(b)) {
+					process(b);
+					commit(b);
+				}
+				return;
+			}
+
+			std::size_t filled = 0, committed = 0;
+			bool more = true;
+			std::unique_lock lock{m};
+			for (;;) {
+				auto pos = finished.begin();
+				if (ordered) {
+					while (pos != finished.end() && (*pos)->seq != committed) ++pos;
+				}
+				if (pos != finished.end()) {
+					auto* s = *pos;
+					finished.erase(pos);
+					lock.unlock();
+					if (s->error) std::rethrow_exception(s->error);
+					commit(s->batch);
+					lock.lock();
+					++committed;
+					free_slots.push_back(s);
+				} else if (more && !free_slots.empty()) {
+					auto* s = free_slots.back();
+					free_slots.pop_back();
+					lock.unlock();
+					more = !poll() && fill(s->batch);
+					lock.lock();
+					if (more) {
+						s->seq = filled++;
+						queued.push_back(s);
+						work_cv.notify_one();
+					} else {
+						free_slots.push_back(s);
+					}
+				} else if (committed == filled) {
+					return;
+				} else {
+					done_cv.wait(lock);
+				}
+			}
+		}
+	} // namespace detail
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,308 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_RAGGED_VECTOR_HPP
+#define STL2_DETAIL_RAGGED_VECTOR_HPP
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/span.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// ragged_vector [Extension]
+//
+// A sequence of variable-length rows stored in compressed sparse row form:
+// the elements of all rows are contiguous in a single buffer, and an offsets
+// array records where each row begins. Rows are appended whole; row i is the
+// span [values().data() + offsets()[i], values().data() + offsets()[i + 1]).
+//
+// Appending a row invalidates spans and iterators obtained earlier, as with
+// std::vector.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<ext::object T>
+		class ragged_vector {
+			using index_t = __span::index_t;
+
+			template<bool Const>
+			class __row_iterator {
+				using E = __maybe_const<Const, T>;
+
+				const index_t* offset_ = nullptr;
+				E* data_ = nullptr;
+
+				friend __row_iterator<!Const>;
+			public:
+				using iterator_category = __stl2::random_access_iterator_tag;
+				using value_type = span<E>;
+				using difference_type = index_t;
+
+				__row_iterator() = default;
+				constexpr __row_iterator(const index_t* offset, E* data) noexcept
+				: offset_{offset}, data_{data} {}
+				constexpr __row_iterator(__row_iterator<!Const> that) noexcept
+				requires Const
+				: offset_{that.offset_}, data_{that.data_} {}
+
+				constexpr span<E> operator*() const noexcept
+				{ return {data_ + offset_[0], offset_[1] - offset_[0]}; }
+				constexpr span<E> operator[](index_t n) const noexcept
+				{ return {data_ + offset_[n], offset_[n + 1] - offset_[n]}; }
+
+				constexpr __row_iterator& operator++() noexcept { ++offset_; return *this; }
+				constexpr __row_iterator operator++(int) noexcept
+				{ auto tmp = *this; ++offset_; return tmp; }
+				constexpr __row_iterator& operator--() noexcept { --offset_; return *this; }
+				constexpr __row_iterator operator--(int) noexcept
+				{ auto tmp = *this; --offset_; return tmp; }
+				constexpr __row_iterator& operator+=(index_t n) noexcept
+				{ offset_ += n; return *this; }
+				constexpr __row_iterator& operator-=(index_t n) noexcept
+				{ offset_ -= n; return *this; }
+
+				friend constexpr __row_iterator operator+(__row_iterator i, index_t n) noexcept
+				{ return i += n; }
+				friend constexpr __row_iterator operator+(index_t n, __row_iterator i) noexcept
+				{ return i += n; }
+				friend constexpr __row_iterator operator-(__row_iterator i, index_t n) noexcept
+				{ return i -= n; }
+				friend constexpr index_t
+				operator-(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return x.offset_ - y.offset_; }
+
+				friend constexpr bool
+				operator==(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return x.offset_ == y.offset_; }
+				friend constexpr bool
+				operator!=(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return !(x == y); }
+				friend constexpr bool
+				operator<(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return x.offset_ < y.offset_; }
+				friend constexpr bool
+				operator>(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return y < x; }
+				friend constexpr bool
+				operator<=(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return !(y < x); }
+				friend constexpr bool
+				operator>=(const __row_iterator& x, const __row_iterator& y) noexcept
+				{ return !(x < y); }
+			};
+
+			// A sized random-access view of (a contiguous block of) the rows,
+			// as span<T> or span<const T>. Subviews can be handed to separate
+			// threads; they share no mutable state.
+			template<bool Const>
+			class __rows_view : public view_interface<__rows_view<Const>> {
+				__row_iterator<Const> first_;
+				index_t size_ = 0;
+			public:
+				__rows_view() = default;
+				constexpr __rows_view(__row_iterator<Const> first, index_t n) noexcept
+				: first_{first}, size_{n} {}
+
+				constexpr __row_iterator<Const> begin() const noexcept { return first_; }
+				constexpr __row_iterator<Const> end() const noexcept { return first_ + size_; }
+				constexpr index_t size() const noexcept { return size_; }
+			};
+
+			std::vector<T> values_;
+			std::vector<index_t> offsets_{0};
+		public:
+			using value_type = span<T>;
+			using size_type = index_t;
+			using rows_view = __rows_view<false>;
+			using const_rows_view = __rows_view<true>;
+
+			ragged_vector() = default;
+
+			template<input_range R>
+			requires input_range<range_reference_t<R>> &&
+				constructible_from<T, range_reference_t<range_reference_t<R>>>
+			explicit ragged_vector(R&& rows) {
+				append_rows(std::forward<R>(rows));
+			}
+
+			// The number of rows.
+			index_t size() const noexcept
+			{ return static_cast<index_t>(offsets_.size()) - 1; }
+			bool empty() const noexcept { return size() == 0; }
+			// The total number of elements in all rows.
+			index_t value_count() const noexcept { return offsets_.back(); }
+
+			void reserve(index_t rows, index_t values) {
+				offsets_.reserve(static_cast<std::size_t>(rows) + 1);
+				values_.reserve(static_cast<std::size_t>(values));
+			}
+
+			void clear() noexcept {
+				values_.clear();
+				offsets_.resize(1);
+			}
+
+			span<T> operator[](index_t i) noexcept {
+				STL2_EXPECT(0 <= i && i < size());
+				return rows_begin_()[i];
+			}
+			span<const T> operator[](index_t i) const noexcept {
+				STL2_EXPECT(0 <= i && i < size());
+				return rows_begin_()[i];
+			}
+
+			span<T> front() noexcept { return (*this)[0]; }
+			span<const T> front() const noexcept { return (*this)[0]; }
+			span<T> back() noexcept { return (*this)[size() - 1]; }
+			span<const T> back() const noexcept { return (*this)[size() - 1]; }
+
+			rows_view rows() noexcept { return {rows_begin_(), size()}; }
+			const_rows_view rows() const noexcept { return {rows_begin_(), size()}; }
+
+			// Rows [first, last), e.g. one thread's share of the work.
+			rows_view rows(index_t first, index_t last) noexcept {
+				STL2_EXPECT(0 <= first && first <= last && last <= size());
+				return {rows_begin_() + first, last - first};
+			}
+			const_rows_view rows(index_t first, index_t last) const noexcept {
+				STL2_EXPECT(0 <= first && first <= last && last <= size());
+				return {rows_begin_() + first, last - first};
+			}
+
+			// All elements of all rows, in row order.
+			span<T> values() noexcept
+			{ return {values_.data(), value_count()}; }
+			span<const T> values() const noexcept
+			{ return {values_.data(), value_count()}; }
+
+			// offsets()[i] is the index in values() of the first element of row
+			// i; offsets()[size()] == value_count().
+			span<const index_t> offsets() const noexcept
+			{ return {offsets_.data(), static_cast<index_t>(offsets_.size())}; }
+
+			// The row containing the element values()[n]. Together with
+			// offsets(), this divides the rows into groups of roughly equal
+			// element count in O(log size()).
+			index_t row_of(index_t n) const noexcept {
+				STL2_EXPECT(0 <= n && n < value_count());
+				return static_cast<index_t>(
+					__stl2::upper_bound(offsets_, n) - offsets_.begin()) - 1;
+			}
+
+			// Appends the elements of r as a new last row, and returns it. r may
+			// be a row of this ragged_vector, or any other span of values();
+			// a range that reads values() some other way must not be used.
+			template<input_range R>
+			requires constructible_from<T, range_reference_t<R>>
+			span<T> push_back(R&& r) {
+				if constexpr (contiguous_range<R> && sized_range<R> &&
+					same_as<iter_value_t<iterator_t<R>>, T>)
+				{
+					// Growing values_ would leave such a span dangling, so its
+					// elements are found by index instead.
+					const T* const p = __stl2::data(r);
+					const T* const v = values_.data();
+					if (!std::less<const T*>{}(p, v) &&
+						std::less<const T*>{}(p, v + values_.size()))
+					{
+						const auto first = static_cast<std::size_t>(p - v);
+						const auto n = static_cast<std::size_t>(__stl2::size(r));
+						values_.reserve(values_.size() + n);
+						offsets_.reserve(offsets_.size() + 1);
+						try {
+							for (std::size_t i = 0; i < n; ++i) {
+								values_.emplace_back(values_[first + i]);
+							}
+						} catch (...) {
+							values_.erase(values_.begin() + offsets_.back(), values_.end());
+							throw;
+						}
+						offsets_.push_back(static_cast<index_t>(values_.size()));
+						return back();
+					}
+				}
+				if constexpr (sized_range<R>) {
+					values_.reserve(values_.size() + static_cast<std::size_t>(__stl2::size(r)));
+				}
+				offsets_.reserve(offsets_.size() + 1);
+				try {
+					for (auto&& e : r) {
+						values_.emplace_back(std::forward<decltype(e)>(e));
+					}
+				} catch (...) {
+					values_.erase(values_.begin() + offsets_.back(), values_.end());
+					throw;
+				}
+				offsets_.push_back(static_cast<index_t>(values_.size()));
+				return back();
+			}
+
+			// Appends a row of n value-initialized elements, and returns it.
+			span<T> emplace_back(index_t n)
+			requires default_initializable<T>
+			{
+				STL2_EXPECT(n >= 0);
+				offsets_.reserve(offsets_.size() + 1);
+				values_.resize(values_.size() + static_cast<std::size_t>(n));
+				offsets_.push_back(static_cast<index_t>(values_.size()));
+				return back();
+			}
+
+			// Appends each element of rows as a row. rows must not be a view of
+			// this ragged_vector.
+			template<input_range R>
+			requires input_range<range_reference_t<R>> &&
+				constructible_from<T, range_reference_t<range_reference_t<R>>>
+			void append_rows(R&& rows) {
+				if constexpr (sized_range<R>) {
+					offsets_.reserve(offsets_.size() + static_cast<std::size_t>(__stl2::size(rows)));
+				}
+				for (auto&& row : rows) {
+					push_back(row);
+				}
+			}
+
+			void pop_back() noexcept {
+				STL2_EXPECT(!empty());
+				offsets_.pop_back();
+				values_.erase(values_.begin() + offsets_.back(), values_.end());
+			}
+
+			void swap(ragged_vector& that) noexcept {
+				values_.swap(that.values_);
+				offsets_.swap(that.offsets_);
+			}
+			friend void swap(ragged_vector& x, ragged_vector& y) noexcept {
+				x.swap(y);
+			}
+
+			friend bool operator==(const ragged_vector& x, const ragged_vector& y) {
+				return x.offsets_ == y.offsets_ && x.values_ == y.values_;
+			}
+			friend bool operator!=(const ragged_vector& x, const ragged_vector& y) {
+				return !(x == y);
+			}
+
+		private:
+			__row_iterator<false> rows_begin_() noexcept
+			{ return {offsets_.data(), values_.data()}; }
+			__row_iterator<true> rows_begin_() const noexcept
+			{ return {offsets_.data(), values_.data()}; }
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
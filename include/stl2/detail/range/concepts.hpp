@@ -75,8 +75,24 @@ STL2_OPEN_NAMESPACE {
 		range<T> && range<const T> &&
 		!same_as<iter_reference_t<iterator_t<T>>, iter_reference_t<iterator_t<const T>>>;
 
+	template<class D>
+	requires std::is_class_v<D>
+	class view_interface;
+
+	// Implement the PR of LWG 3549: view_interface does not derive from
+	// view_base, so views that nest other views hold no two empty view_base
+	// subobjects that must have distinct addresses.
+	template<class D>
+	void __is_derived_from_view_interface(const view_interface<D>&);
+
+	template<class T>
+	META_CONCEPT _DerivedFromViewInterface = requires(const T& t) {
+		__stl2::__is_derived_from_view_interface(t);
+	};
+
 	template<class T>
-	META_CONCEPT __enable_view_default = derived_from<T, view_base> || !_ContainerLike<T>;
+	META_CONCEPT __enable_view_default = derived_from<T, view_base> ||
+		_DerivedFromViewInterface<T> || !_ContainerLike<T>;
 
 	template<class T>
 	inline constexpr bool enable_view = __enable_view_default<T>;
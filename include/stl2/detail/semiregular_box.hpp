@@ -12,7 +12,10 @@
 #ifndef STL2_DETAIL_SEMIREGULAR_BOX_HPP
 #define STL2_DETAIL_SEMIREGULAR_BOX_HPP
 
+#include <cstring>
+#include <memory>
 #include <optional>
+#include <type_traits>
 
 #include <stl2/type_traits.hpp>
 #include <stl2/detail/ebo_box.hpp>
@@ -177,6 +180,61 @@ STL2_OPEN_NAMESPACE {
 			: semiregular_box::ebo_box{static_cast<Args&&>(args)...} {}
 		};
 
+		// A trivially copy constructible and destructible T - e.g., a lambda
+		// that captures by value - needs no engaged flag: assignment copies
+		// its bytes. As with an empty std::optional, a default-constructed box
+		// that holds no T may only be assigned to, copied, or destroyed.
+		template<ext::move_constructible_object T>
+		requires (!semiregular<T> && copy_constructible<T> &&
+			std::is_trivially_copy_constructible_v<T> &&
+			std::is_trivially_destructible_v<T>)
+		struct semiregular_box<T> {
+			constexpr semiregular_box() noexcept {}
+			constexpr semiregular_box()
+			noexcept(std::is_nothrow_default_constructible_v<T>)
+			requires constructible_from<T>
+			: t_{} {}
+
+			template<_NotSameAs<semiregular_box> U>
+			requires convertible_to<U, T>
+			constexpr semiregular_box(U&& u)
+			noexcept(std::is_nothrow_constructible_v<T, U>)
+			: t_(static_cast<U&&>(u)) {}
+
+			template<class... Args>
+			requires constructible_from<T, Args...>
+			constexpr semiregular_box(std::in_place_t, Args&&... args)
+			noexcept(std::is_nothrow_constructible_v<T, Args...>)
+			: t_(static_cast<Args&&>(args)...) {}
+
+			semiregular_box(const semiregular_box&) = default;
+			semiregular_box(semiregular_box&&) = default;
+
+			constexpr semiregular_box& operator=(const semiregular_box& that) & noexcept {
+				if (std::is_constant_evaluated()) {
+					std::construct_at(std::addressof(t_), that.t_);
+				} else {
+					std::memcpy(static_cast<void*>(std::addressof(t_)),
+						std::addressof(that.t_), sizeof(T));
+				}
+				return *this;
+			}
+
+			constexpr semiregular_box& operator=(const T& t) & noexcept {
+				std::construct_at(std::addressof(t_), t);
+				return *this;
+			}
+
+			constexpr T& get() & noexcept { return t_; }
+			constexpr const T& get() const& noexcept { return t_; }
+			constexpr T&& get() && noexcept { return static_cast<T&&>(t_); }
+			constexpr const T&& get() const&& noexcept
+			{ return static_cast<const T&&>(t_); }
+
+		private:
+			union { T t_; };
+		};
+
 		template<class T>
 		semiregular_box(T) -> semiregular_box<T>;
 	}
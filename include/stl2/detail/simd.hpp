@@ -0,0 +1,485 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_HPP
+#define STL2_DETAIL_SIMD_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/simd_fwd.hpp>
+#include <stl2/detail/concepts/callable.hpp>
+#include <stl2/detail/concepts/core.hpp>
+#include <stl2/detail/concepts/fundamental.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// simd [Extension]
+//
+// ext::simd<T, N> holds N lanes of an arithmetic type T, N a power of two,
+// by default as many as fill a native vector register: 64 bytes with
+// AVX-512, 32 with AVX2 and 16 otherwise. Arithmetic, bitwise and shift
+// operators work lane by lane, as do the comparisons, which yield an
+// ext::simd_mask<T, N>. Both are built on the compiler's generic vectors,
+// which lower to the widest instructions the target has and to scalar
+// code on targets with none.
+//
+// The operations generic vectors lack have explicit AVX-512, AVX2 and SSE2
+// code for the register sizes and lane types those instruction sets
+// support, and a scalar loop for the others: simd_mask::bits, which packs
+// a mask into an integer (movemask); simd::compress_store, which stores
+// the selected lanes contiguously (vpcompress, or vpermd with BMI2); and
+// simd::gather, which loads lanes from a table at indices given by a
+// simd (vpgather).
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class T, int N>
+		struct __simd_storage {
+			typedef T type __attribute__((vector_size(N * sizeof(T))));
+		};
+
+		// The signed integer as wide as T: the lane type of masks.
+		template<class T>
+		using __simd_mask_element_t = meta::if_c<sizeof(T) == 1, std::int8_t,
+			meta::if_c<sizeof(T) == 2, std::int16_t,
+			meta::if_c<sizeof(T) == 4, std::int32_t, std::int64_t>>>;
+	} // namespace detail
+
+	namespace ext {
+		template<simd_element T, int N>
+		requires detail::__simd_lanes<N>
+		class simd_mask {
+		private:
+			using __element = detail::__simd_mask_element_t<T>;
+			using __vec = typename detail::__simd_storage<__element, N>::type;
+
+			__vec m_;
+
+			friend class simd<T, N>;
+
+			explicit simd_mask(const __vec& m) noexcept : m_(m) {}
+		public:
+			simd_mask() = default;
+			explicit simd_mask(bool b) noexcept
+			: m_(__vec{} - static_cast<__element>(b)) {}
+
+			static constexpr int size() noexcept { return N; }
+
+			bool operator[](int i) const noexcept {
+				STL2_EXPECT(0 <= i && i < N);
+				return m_[i] != 0;
+			}
+
+			// Bit i is set iff lane i is.
+			std::uint64_t bits() const noexcept requires (N <= 64) {
+				[[maybe_unused]] constexpr std::size_t bytes = sizeof(__vec);
+				[[maybe_unused]] constexpr std::size_t lane = sizeof(T);
+#if defined(__AVX512BW__) && defined(__AVX512DQ__)
+				if constexpr (bytes == 64) {
+					__m512i v;
+					std::memcpy(&v, &m_, 64);
+					if constexpr (lane == 1) return _mm512_movepi8_mask(v);
+					else if constexpr (lane == 2) return _mm512_movepi16_mask(v);
+					else if constexpr (lane == 4) return _mm512_movepi32_mask(v);
+					else return _mm512_movepi64_mask(v);
+				}
+#endif
+#if defined(__AVX2__)
+				if constexpr (bytes == 32) {
+					__m256i v;
+					std::memcpy(&v, &m_, 32);
+					if constexpr (lane == 1) {
+						return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+					} else if constexpr (lane == 2) {
+						// packs works within 128-bit halves.
+						const auto m = static_cast<std::uint32_t>(
+							_mm256_movemask_epi8(_mm256_packs_epi16(v, v)));
+						return (m & 0xffu) | ((m >> 8) & 0xff00u);
+					} else if constexpr (lane == 4) {
+						return static_cast<std::uint32_t>(
+							_mm256_movemask_ps(_mm256_castsi256_ps(v)));
+					} else {
+						return static_cast<std::uint32_t>(
+							_mm256_movemask_pd(_mm256_castsi256_pd(v)));
+					}
+				}
+#endif
+#if defined(__SSE2__)
+				if constexpr (bytes == 16) {
+					__m128i v;
+					std::memcpy(&v, &m_, 16);
+					if constexpr (lane == 1) {
+						return static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+					} else if constexpr (lane == 2) {
+						return static_cast<std::uint32_t>(
+							_mm_movemask_epi8(_mm_packs_epi16(v, _mm_setzero_si128())));
+					} else if constexpr (lane == 4) {
+						return static_cast<std::uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(v)));
+					} else {
+						return static_cast<std::uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(v)));
+					}
+				}
+#endif
+				std::uint64_t result = 0;
+				for (int i = 0; i < N; ++i) {
+					result |= std::uint64_t{m_[i] != 0} << i;
+				}
+				return result;
+			}
+
+			bool any() const noexcept {
+				if constexpr (N <= 64) {
+					return bits() != 0;
+				} else {
+					for (int i = 0; i < N; ++i) {
+						if (m_[i]) return true;
+					}
+					return false;
+				}
+			}
+			bool none() const noexcept { return !any(); }
+			bool all() const noexcept { return (!*this).none(); }
+
+			int count() const noexcept {
+				if constexpr (N <= 64) {
+					return std::popcount(bits());
+				} else {
+					int n = 0;
+					for (int i = 0; i < N; ++i) {
+						n += m_[i] != 0;
+					}
+					return n;
+				}
+			}
+
+			friend simd_mask operator!(const simd_mask& x) noexcept
+			{ return simd_mask{~x.m_}; }
+			friend simd_mask operator&(const simd_mask& x, const simd_mask& y) noexcept
+			{ return simd_mask{x.m_ & y.m_}; }
+			friend simd_mask operator|(const simd_mask& x, const simd_mask& y) noexcept
+			{ return simd_mask{x.m_ | y.m_}; }
+			friend simd_mask operator^(const simd_mask& x, const simd_mask& y) noexcept
+			{ return simd_mask{x.m_ ^ y.m_}; }
+		};
+
+		template<simd_element T, int N>
+		requires detail::__simd_lanes<N>
+		class simd {
+		private:
+			using __vec = typename detail::__simd_storage<T, N>::type;
+			using __mask_vec = typename simd_mask<T, N>::__vec;
+
+			__vec v_;
+
+			explicit simd(const __vec& v) noexcept : v_(v) {}
+
+			static simd_mask<T, N> __mask(const __mask_vec& m) noexcept
+			{ return simd_mask<T, N>{m}; }
+
+			static simd __blend(const simd_mask<T, N>& m, const simd& x, const simd& y) noexcept
+			{ return simd{m.m_ ? x.v_ : y.v_}; }
+		public:
+			using value_type = T;
+			using mask_type = simd_mask<T, N>;
+
+			static constexpr int size() noexcept { return N; }
+
+			simd() = default;
+
+			// Every lane x.
+			simd(T x) noexcept : v_(__vec{} + x) {}
+
+			// Lane i gen(i).
+			template<class G>
+			requires (!convertible_to<G, T>) && invocable<G&, int> &&
+				convertible_to<invoke_result_t<G&, int>, T>
+			explicit simd(G gen) {
+				for (int i = 0; i < N; ++i) {
+					v_[i] = static_cast<T>(gen(i));
+				}
+			}
+
+			static simd load(const T* p) noexcept {
+				simd r;
+				std::memcpy(&r.v_, p, sizeof(__vec));
+				return r;
+			}
+			// p must be aligned to sizeof(simd).
+			static simd load_aligned(const T* p) noexcept {
+				STL2_EXPECT(reinterpret_cast<std::uintptr_t>(p) % sizeof(__vec) == 0);
+				simd r;
+				std::memcpy(&r.v_, __builtin_assume_aligned(p, sizeof(__vec)), sizeof(__vec));
+				return r;
+			}
+
+			void store(T* p) const noexcept {
+				std::memcpy(p, &v_, sizeof(__vec));
+			}
+			void store_aligned(T* p) const noexcept {
+				STL2_EXPECT(reinterpret_cast<std::uintptr_t>(p) % sizeof(__vec) == 0);
+				std::memcpy(__builtin_assume_aligned(p, sizeof(__vec)), &v_, sizeof(__vec));
+			}
+
+			T operator[](int i) const noexcept {
+				STL2_EXPECT(0 <= i && i < N);
+				return v_[i];
+			}
+
+			// Folds the lanes with op, which is applied to the two halves
+			// of the vector, then to the halves of the result, and so on;
+			// so the result is unspecified unless op is associative and
+			// commutative.
+			template<class Op = std::plus<>>
+			T reduce(Op op = {}) const {
+				if constexpr (N == 1) {
+					return v_[0];
+				} else {
+					T lanes[N];
+					std::memcpy(lanes, &v_, sizeof(lanes));
+					const auto lo = simd<T, N / 2>::load(lanes);
+					const auto hi = simd<T, N / 2>::load(lanes + N / 2);
+					return simd<T, N / 2>(__stl2::invoke(op, lo, hi)).reduce(std::move(op));
+				}
+			}
+
+			// Stores the lanes selected by m to successive elements from out;
+			// returns the end of those stored.
+			T* compress_store(const mask_type& m, T* out) const noexcept {
+				[[maybe_unused]] constexpr std::size_t bytes = sizeof(__vec);
+				[[maybe_unused]] constexpr std::size_t lane = sizeof(T);
+#if defined(__AVX512F__)
+				if constexpr (bytes == 64 && lane >= 4) {
+					__m512i v;
+					std::memcpy(&v, &v_, 64);
+					const auto k = m.bits();
+					if constexpr (lane == 4) {
+						_mm512_mask_compressstoreu_epi32(out, static_cast<__mmask16>(k), v);
+					} else {
+						_mm512_mask_compressstoreu_epi64(out, static_cast<__mmask8>(k), v);
+					}
+					return out + std::popcount(k);
+				}
+#endif
+#if defined(__AVX512VL__)
+				if constexpr (bytes == 32 && lane >= 4) {
+					__m256i v;
+					std::memcpy(&v, &v_, 32);
+					const auto k = static_cast<__mmask8>(m.bits());
+					if constexpr (lane == 4) _mm256_mask_compressstoreu_epi32(out, k, v);
+					else _mm256_mask_compressstoreu_epi64(out, k, v);
+					return out + std::popcount(k);
+				}
+				if constexpr (bytes == 16 && lane >= 4) {
+					__m128i v;
+					std::memcpy(&v, &v_, 16);
+					const auto k = static_cast<__mmask8>(m.bits());
+					if constexpr (lane == 4) _mm_mask_compressstoreu_epi32(out, k, v);
+					else _mm_mask_compressstoreu_epi64(out, k, v);
+					return out + std::popcount(k);
+				}
+#endif
+#if defined(__AVX512VBMI2__) && defined(__AVX512BW__)
+				if constexpr (bytes == 64 && lane <= 2) {
+					__m512i v;
+					std::memcpy(&v, &v_, 64);
+					const auto k = m.bits();
+					if constexpr (lane == 1) _mm512_mask_compressstoreu_epi8(out, k, v);
+					else _mm512_mask_compressstoreu_epi16(out, static_cast<__mmask32>(k), v);
+					return out + std::popcount(k);
+				}
+#endif
+#if defined(__AVX2__) && defined(__BMI2__)
+				if constexpr (bytes == 32 && lane == 4) {
+					// Spread the mask to one byte per lane, then extract the
+					// indices of the selected lanes into a permutation.
+					const auto k = m.bits();
+					const auto spread = _pdep_u64(k, 0x0101010101010101u) * 0xffu;
+					const auto indices = _pext_u64(0x0706050403020100u, spread);
+					const auto perm = _mm256_cvtepu8_epi32(
+						_mm_cvtsi64_si128(static_cast<long long>(indices)));
+					__m256i v;
+					std::memcpy(&v, &v_, 32);
+					T packed[8];
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(packed),
+						_mm256_permutevar8x32_epi32(v, perm));
+					const int n = std::popcount(k);
+					std::memcpy(out, packed, static_cast<std::size_t>(n) * sizeof(T));
+					return out + n;
+				}
+#endif
+				for (int i = 0; i < N; ++i) {
+					if (m[i]) *out++ = v_[i];
+				}
+				return out;
+			}
+
+			// Lane i base[index[i]].
+			template<simd_element I>
+			requires integral<I>
+			static simd gather(const T* base, const simd<I, N>& index) noexcept {
+				[[maybe_unused]] constexpr std::size_t bytes = sizeof(__vec);
+				[[maybe_unused]] constexpr std::size_t lane = sizeof(T);
+				[[maybe_unused]] constexpr bool signed_index = std::is_signed_v<I>;
+#if defined(__AVX512F__)
+				if constexpr (bytes == 64 && signed_index && lane >= 4 && sizeof(I) >= 4) {
+					simd r;
+					if constexpr (lane == 4 && sizeof(I) == 4) {
+						__m512i i;
+						std::memcpy(&i, &index, 64);
+						const auto v = _mm512_mask_i32gather_epi32(
+							_mm512_setzero_si512(), __mmask16(0xffff), i, base, 4);
+						std::memcpy(&r.v_, &v, 64);
+						return r;
+					} else if constexpr (lane == 8 && sizeof(I) == 4) {
+						__m256i i;
+						std::memcpy(&i, &index, 32);
+						const auto v = _mm512_mask_i32gather_epi64(
+							_mm512_setzero_si512(), __mmask8(0xff), i, base, 8);
+						std::memcpy(&r.v_, &v, 64);
+						return r;
+					} else if constexpr (lane == 8 && sizeof(I) == 8) {
+						__m512i i;
+						std::memcpy(&i, &index, 64);
+						const auto v = _mm512_mask_i64gather_epi64(
+							_mm512_setzero_si512(), __mmask8(0xff), i, base, 8);
+						std::memcpy(&r.v_, &v, 64);
+						return r;
+					}
+				}
+#endif
+#if defined(__AVX2__)
+				if constexpr ((bytes == 32 || bytes == 16) && signed_index && lane >= 4 &&
+					sizeof(I) >= 4)
+				{
+					simd r;
+					if constexpr (bytes == 32 && lane == 4 && sizeof(I) == 4) {
+						__m256i i;
+						std::memcpy(&i, &index, 32);
+						const auto v = _mm256_i32gather_epi32(
+							reinterpret_cast<const int*>(base), i, 4);
+						std::memcpy(&r.v_, &v, 32);
+						return r;
+					} else if constexpr (bytes == 16 && lane == 4 && sizeof(I) == 4) {
+						__m128i i;
+						std::memcpy(&i, &index, 16);
+						const auto v = _mm_i32gather_epi32(
+							reinterpret_cast<const int*>(base), i, 4);
+						std::memcpy(&r.v_, &v, 16);
+						return r;
+					} else if constexpr (bytes == 32 && lane == 8 && sizeof(I) == 4) {
+						__m128i i;
+						std::memcpy(&i, &index, 16);
+						const auto v = _mm256_i32gather_epi64(
+							reinterpret_cast<const long long*>(base), i, 8);
+						std::memcpy(&r.v_, &v, 32);
+						return r;
+					} else if constexpr (bytes == 32 && lane == 8 && sizeof(I) == 8) {
+						__m256i i;
+						std::memcpy(&i, &index, 32);
+						const auto v = _mm256_i64gather_epi64(
+							reinterpret_cast<const long long*>(base), i, 8);
+						std::memcpy(&r.v_, &v, 32);
+						return r;
+					}
+				}
+#endif
+				simd r;
+				for (int i = 0; i < N; ++i) {
+					r.v_[i] = base[index[i]];
+				}
+				return r;
+			}
+
+			// Lane i (*this)[table[i] % N]: pshufb, vpermd, vpermb and the
+			// like, as the target allows.
+			template<simd_element I>
+			requires integral<I>
+			simd shuffle(const simd<I, N>& table) const noexcept {
+				typename detail::__simd_storage<I, N>::type t;
+				std::memcpy(&t, &table, sizeof(t));
+				return simd{__builtin_shuffle(v_, __builtin_convertvector(t, __mask_vec))};
+			}
+
+			// Lane i of if_true where m is set, else of if_false.
+			friend simd blend(const mask_type& m, const simd& if_true, const simd& if_false) noexcept
+			{ return __blend(m, if_true, if_false); }
+
+			friend simd operator+(const simd& x) noexcept { return x; }
+			friend simd operator-(const simd& x) noexcept { return simd{-x.v_}; }
+			friend simd operator~(const simd& x) noexcept requires integral<T>
+			{ return simd{~x.v_}; }
+
+			friend simd operator+(const simd& x, const simd& y) noexcept
+			{ return simd{x.v_ + y.v_}; }
+			friend simd operator-(const simd& x, const simd& y) noexcept
+			{ return simd{x.v_ - y.v_}; }
+			friend simd operator*(const simd& x, const simd& y) noexcept
+			{ return simd{x.v_ * y.v_}; }
+			friend simd operator/(const simd& x, const simd& y) noexcept
+			{ return simd{x.v_ / y.v_}; }
+			friend simd operator%(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ % y.v_}; }
+			friend simd operator&(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ & y.v_}; }
+			friend simd operator|(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ | y.v_}; }
+			friend simd operator^(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ ^ y.v_}; }
+			friend simd operator<<(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ << y.v_}; }
+			friend simd operator>>(const simd& x, const simd& y) noexcept requires integral<T>
+			{ return simd{x.v_ >> y.v_}; }
+			friend simd operator<<(const simd& x, int n) noexcept requires integral<T>
+			{ return simd{x.v_ << n}; }
+			friend simd operator>>(const simd& x, int n) noexcept requires integral<T>
+			{ return simd{x.v_ >> n}; }
+
+			simd& operator+=(const simd& y) noexcept { return *this = *this + y; }
+			simd& operator-=(const simd& y) noexcept { return *this = *this - y; }
+			simd& operator*=(const simd& y) noexcept { return *this = *this * y; }
+			simd& operator/=(const simd& y) noexcept { return *this = *this / y; }
+			simd& operator%=(const simd& y) noexcept requires integral<T>
+			{ return *this = *this % y; }
+			simd& operator&=(const simd& y) noexcept requires integral<T>
+			{ return *this = *this & y; }
+			simd& operator|=(const simd& y) noexcept requires integral<T>
+			{ return *this = *this | y; }
+			simd& operator^=(const simd& y) noexcept requires integral<T>
+			{ return *this = *this ^ y; }
+			simd& operator<<=(int n) noexcept requires integral<T>
+			{ return *this = *this << n; }
+			simd& operator>>=(int n) noexcept requires integral<T>
+			{ return *this = *this >> n; }
+
+			friend mask_type operator==(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ == y.v_, __mask_vec)); }
+			friend mask_type operator!=(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ != y.v_, __mask_vec)); }
+			friend mask_type operator<(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ < y.v_, __mask_vec)); }
+			friend mask_type operator>(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ > y.v_, __mask_vec)); }
+			friend mask_type operator<=(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ <= y.v_, __mask_vec)); }
+			friend mask_type operator>=(const simd& x, const simd& y) noexcept
+			{ return __mask(__builtin_convertvector(x.v_ >= y.v_, __mask_vec)); }
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,59 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SIMD_FWD_HPP
+#define STL2_DETAIL_SIMD_FWD_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/core.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Declarations of ext::simd and ext::simd_mask, which are defined in
+// <stl2/simd.hpp>, for headers that only detect simd overloads.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class T>
+		META_CONCEPT simd_element = std::is_arithmetic_v<T> && !same_as<T, bool> &&
+			!same_as<T, long double> &&
+			(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+	} // namespace ext
+
+	namespace detail {
+#if defined(__AVX512F__)
+		inline constexpr std::size_t __simd_register_bytes = 64;
+#elif defined(__AVX2__)
+		inline constexpr std::size_t __simd_register_bytes = 32;
+#else
+		inline constexpr std::size_t __simd_register_bytes = 16;
+#endif
+
+		template<int N>
+		inline constexpr bool __simd_lanes = N > 0 && (N & (N - 1)) == 0;
+	} // namespace detail
+
+	namespace ext {
+		template<simd_element T>
+		inline constexpr int simd_native_lanes =
+			static_cast<int>(detail::__simd_register_bytes / sizeof(T));
+
+		template<simd_element T, int N = simd_native_lanes<T>>
+		requires detail::__simd_lanes<N>
+		class simd;
+
+		template<simd_element T, int N = simd_native_lanes<T>>
+		requires detail::__simd_lanes<N>
+		class simd_mask;
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,469 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_SOA_VECTOR_HPP
+#define STL2_DETAIL_SOA_VECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <stl2/type_traits.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/span.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// soa_vector [Extension]
+//
+// A sequence of records (Ts...) stored as one contiguous column per member.
+// Iterators are random-access and yield soa_reference<Ts&...> proxies, a
+// std::tuple of references to the record's members; the value type is
+// std::tuple<Ts...>. iter_move and iter_swap act on every column, so the
+// mutating algorithms (sort, partition, unique, remove_if, ...) permute
+// whole records in place. A bool member is stored one per byte, not packed
+// as in std::vector<bool>, so that its column is contiguous too.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class... Refs>
+		requires (std::is_reference_v<Refs> && ...)
+		struct soa_reference : std::tuple<Refs...> {
+		private:
+			using base_t = std::tuple<Refs...>;
+			template<class... Us>
+			requires (std::is_reference_v<Us> && ...)
+			friend struct soa_reference;
+
+			template<class Tuple, std::size_t... Is>
+			void assign_(Tuple&& t, std::index_sequence<Is...>) const {
+				// get on a const tuple of references still yields T&.
+				((void)(std::get<Is>(static_cast<const base_t&>(*this)) =
+					std::get<Is>(std::forward<Tuple>(t))), ...);
+			}
+		public:
+			static constexpr bool is_const_ =
+				(std::is_const_v<std::remove_reference_t<Refs>> && ...);
+		public:
+			explicit constexpr soa_reference(Refs... refs) noexcept
+			: base_t{static_cast<Refs>(refs)...} {}
+			soa_reference(const soa_reference&) = default;
+
+			// A proxy of const lvalue references - the common reference of a
+			// record's representations - binds to the members of any other
+			// proxy or of an lvalue std::tuple value.
+			template<class... Us>
+			requires is_const_ && (sizeof...(Us) == sizeof...(Refs)) &&
+				(convertible_to<Us&, Refs> && ...)
+			constexpr soa_reference(const soa_reference<Us...>& that) noexcept
+			: base_t{static_cast<const std::tuple<Us...>&>(that)} {}
+			template<class... Us>
+			requires is_const_ && (sizeof...(Us) == sizeof...(Refs)) &&
+				(convertible_to<const Us&, Refs> && ...)
+			constexpr soa_reference(const std::tuple<Us...>& t) noexcept
+			: base_t{t} {}
+			template<class... Us>
+			requires is_const_ && (sizeof...(Us) == sizeof...(Refs))
+			soa_reference(const std::tuple<Us...>&&) = delete;
+
+			// Assignment writes through to the referenced members, also when
+			// the proxy itself is const (as required of indirectly_writable).
+			template<class... Us>
+			requires (sizeof...(Us) == sizeof...(Refs)) &&
+				(assignable_from<Refs&, const Us&> && ...)
+			const soa_reference& operator=(const std::tuple<Us...>& t) const {
+				assign_(t, std::index_sequence_for<Refs...>{});
+				return *this;
+			}
+			template<class... Us>
+			requires (sizeof...(Us) == sizeof...(Refs)) &&
+				(assignable_from<Refs&, Us> && ...)
+			const soa_reference& operator=(std::tuple<Us...>&& t) const {
+				assign_(std::move(t), std::index_sequence_for<Refs...>{});
+				return *this;
+			}
+			const soa_reference& operator=(const soa_reference& that) const
+			requires (assignable_from<Refs&, const std::remove_reference_t<Refs>&> && ...)
+			{
+				assign_(static_cast<const base_t&>(that), std::index_sequence_for<Refs...>{});
+				return *this;
+			}
+		};
+	} // namespace ext
+
+	// The common reference of a record's representations - lvalue proxy,
+	// rvalue proxy, and std::tuple value - is a proxy of const lvalue
+	// references, which (unlike the value type) move-only members permit.
+	template<class... Ts, class... Us,
+		template<class> class TQual, template<class> class UQual>
+	requires same_as<std::tuple<__uncvref<Ts>...>, std::tuple<__uncvref<Us>...>>
+	struct basic_common_reference<ext::soa_reference<Ts...>, ext::soa_reference<Us...>,
+		TQual, UQual> {
+		using type = ext::soa_reference<const __uncvref<Ts>&...>;
+	};
+	template<class... Ts, class... Us,
+		template<class> class TQual, template<class> class UQual>
+	requires same_as<std::tuple<__uncvref<Ts>...>, std::tuple<Us...>>
+	struct basic_common_reference<ext::soa_reference<Ts...>, std::tuple<Us...>,
+		TQual, UQual> {
+		using type = ext::soa_reference<const Us&...>;
+	};
+	template<class... Ts, class... Us,
+		template<class> class TQual, template<class> class UQual>
+	requires same_as<std::tuple<Ts...>, std::tuple<__uncvref<Us>...>>
+	struct basic_common_reference<std::tuple<Ts...>, ext::soa_reference<Us...>,
+		TQual, UQual> {
+		using type = ext::soa_reference<const Ts&...>;
+	};
+} STL2_CLOSE_NAMESPACE
+
+namespace std {
+	template<class... Refs>
+	struct tuple_size<::__stl2::ext::soa_reference<Refs...>>
+	: std::integral_constant<std::size_t, sizeof...(Refs)> {};
+	template<std::size_t I, class... Refs>
+	struct tuple_element<I, ::__stl2::ext::soa_reference<Refs...>>
+	: tuple_element<I, std::tuple<Refs...>> {};
+}
+
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// std::vector<bool> packs its elements into bits and has no data(),
+		// so soa_vector keeps a bool member in this instead: the part of
+		// std::vector's interface that soa_vector uses, over an array of bool.
+		class __soa_bool_column {
+			std::unique_ptr<bool[]> data_;
+			std::size_t size_ = 0;
+			std::size_t capacity_ = 0;
+
+			void reallocate_(std::size_t n) {
+				std::unique_ptr<bool[]> p{new bool[n]};
+				std::copy_n(data_.get(), size_, p.get());
+				data_ = std::move(p);
+				capacity_ = n;
+			}
+		public:
+			__soa_bool_column() = default;
+			__soa_bool_column(const __soa_bool_column& that) {
+				reserve(that.size_);
+				std::copy_n(that.data_.get(), that.size_, data_.get());
+				size_ = that.size_;
+			}
+			__soa_bool_column(__soa_bool_column&& that) noexcept
+			: data_(std::move(that.data_)), size_(std::exchange(that.size_, 0))
+			, capacity_(std::exchange(that.capacity_, 0)) {}
+			__soa_bool_column& operator=(__soa_bool_column that) noexcept {
+				swap(that);
+				return *this;
+			}
+
+			void swap(__soa_bool_column& that) noexcept {
+				std::swap(data_, that.data_);
+				std::swap(size_, that.size_);
+				std::swap(capacity_, that.capacity_);
+			}
+			friend void swap(__soa_bool_column& x, __soa_bool_column& y) noexcept {
+				x.swap(y);
+			}
+
+			bool* data() noexcept { return data_.get(); }
+			const bool* data() const noexcept { return data_.get(); }
+			bool* begin() noexcept { return data_.get(); }
+			bool* end() noexcept { return data_.get() + size_; }
+			std::size_t size() const noexcept { return size_; }
+			std::size_t capacity() const noexcept { return capacity_; }
+
+			void reserve(std::size_t n) {
+				if (n > capacity_) reallocate_(n);
+			}
+			void resize(std::size_t n) {
+				reserve(n);
+				if (n > size_) std::fill(end(), begin() + n, false);
+				size_ = n;
+			}
+			void clear() noexcept { size_ = 0; }
+			void shrink_to_fit() {
+				if (capacity_ > size_) reallocate_(size_);
+			}
+
+			template<class Arg>
+			void emplace_back(Arg&& arg) {
+				// Converted first: arg may be an element of this column.
+				const bool b(std::forward<Arg>(arg));
+				if (size_ == capacity_) reallocate_(capacity_ ? 2 * capacity_ : 8);
+				data_[size_++] = b;
+			}
+			void pop_back() noexcept { --size_; }
+			bool* erase(bool* first, bool* last) noexcept {
+				size_ = static_cast<std::size_t>(std::copy(last, end(), first) - begin());
+				return first;
+			}
+
+			friend bool operator==(const __soa_bool_column& x, const __soa_bool_column& y) noexcept {
+				return std::equal(x.data(), x.data() + x.size_, y.data(), y.data() + y.size_);
+			}
+		};
+
+		template<class T>
+		using __soa_column = meta::if_c<same_as<T, bool>, __soa_bool_column, std::vector<T>>;
+	} // namespace detail
+
+	namespace ext {
+		template<move_constructible_object... Ts>
+		requires (sizeof...(Ts) > 0)
+		class soa_vector {
+			using index_t = __span::index_t;
+			using seq_t = std::index_sequence_for<Ts...>;
+
+			template<bool Const>
+			class __iterator {
+				friend __iterator<!Const>;
+
+				std::tuple<__maybe_const<Const, Ts>*...> columns_{};
+				index_t n_ = 0;
+
+				template<std::size_t... Is>
+				auto deref_(index_t n, std::index_sequence<Is...>) const noexcept {
+					return soa_reference<__maybe_const<Const, Ts>&...>{
+						std::get<Is>(columns_)[n]...};
+				}
+				template<std::size_t... Is>
+				auto move_(std::index_sequence<Is...>) const noexcept {
+					return soa_reference<__maybe_const<Const, Ts>&&...>{
+						std::move(std::get<Is>(columns_)[n_])...};
+				}
+				template<std::size_t... Is>
+				void swap_(const __iterator& that, std::index_sequence<Is...>) const {
+					(__stl2::iter_swap(std::get<Is>(columns_) + n_,
+						std::get<Is>(that.columns_) + that.n_), ...);
+				}
+			public:
+				using iterator_category = __stl2::random_access_iterator_tag;
+				using value_type = std::tuple<Ts...>;
+				using difference_type = index_t;
+
+				__iterator() = default;
+				constexpr __iterator(__maybe_const<Const, Ts>*... columns, index_t n) noexcept
+				: columns_{columns...}, n_{n} {}
+				constexpr __iterator(__iterator<!Const> that) noexcept requires Const
+				: columns_{that.columns_}, n_{that.n_} {}
+
+				soa_reference<__maybe_const<Const, Ts>&...> operator*() const noexcept
+				{ return deref_(n_, seq_t{}); }
+				soa_reference<__maybe_const<Const, Ts>&...> operator[](index_t n) const noexcept
+				{ return deref_(n_ + n, seq_t{}); }
+
+				constexpr __iterator& operator++() noexcept { ++n_; return *this; }
+				constexpr __iterator operator++(int) noexcept
+				{ auto tmp = *this; ++n_; return tmp; }
+				constexpr __iterator& operator--() noexcept { --n_; return *this; }
+				constexpr __iterator operator--(int) noexcept
+				{ auto tmp = *this; --n_; return tmp; }
+				constexpr __iterator& operator+=(index_t n) noexcept
+				{ n_ += n; return *this; }
+				constexpr __iterator& operator-=(index_t n) noexcept
+				{ n_ -= n; return *this; }
+
+				friend constexpr __iterator operator+(__iterator i, index_t n) noexcept
+				{ return i += n; }
+				friend constexpr __iterator operator+(index_t n, __iterator i) noexcept
+				{ return i += n; }
+				friend constexpr __iterator operator-(__iterator i, index_t n) noexcept
+				{ return i -= n; }
+				friend constexpr index_t
+				operator-(const __iterator& x, const __iterator& y) noexcept
+				{ return x.n_ - y.n_; }
+
+				friend constexpr bool operator==(const __iterator& x, const __iterator& y) noexcept
+				{ return x.n_ == y.n_; }
+				friend constexpr bool operator!=(const __iterator& x, const __iterator& y) noexcept
+				{ return !(x == y); }
+				friend constexpr bool operator<(const __iterator& x, const __iterator& y) noexcept
+				{ return x.n_ < y.n_; }
+				friend constexpr bool operator>(const __iterator& x, const __iterator& y) noexcept
+				{ return y < x; }
+				friend constexpr bool operator<=(const __iterator& x, const __iterator& y) noexcept
+				{ return !(y < x); }
+				friend constexpr bool operator>=(const __iterator& x, const __iterator& y) noexcept
+				{ return !(x < y); }
+
+				friend soa_reference<__maybe_const<Const, Ts>&&...>
+				iter_move(const __iterator& i) noexcept
+				{ return i.move_(seq_t{}); }
+
+				friend void iter_swap(const __iterator& x, const __iterator& y)
+				noexcept((std::is_nothrow_swappable_v<Ts> && ...))
+				requires (!Const)
+				{ x.swap_(y, seq_t{}); }
+			};
+
+			std::tuple<detail::__soa_column<Ts>...> columns_;
+
+			template<std::size_t... Is>
+			auto begin_(index_t n, std::index_sequence<Is...>) noexcept {
+				return __iterator<false>{std::get<Is>(columns_).data()..., n};
+			}
+			template<std::size_t... Is>
+			auto begin_(index_t n, std::index_sequence<Is...>) const noexcept {
+				return __iterator<true>{std::get<Is>(columns_).data()..., n};
+			}
+
+			template<class F, std::size_t... Is>
+			void for_each_column_(F f, std::index_sequence<Is...>) {
+				(f(std::get<Is>(columns_)), ...);
+			}
+
+			// Appends one element to each column; on exception, the columns
+			// already extended are shrunk back so that all keep size().
+			template<std::size_t I, class Args>
+			void emplace_columns_(Args& args) {
+				if constexpr (I < sizeof...(Ts)) {
+					auto& column = std::get<I>(columns_);
+					column.emplace_back(std::get<I>(std::move(args)));
+					try {
+						emplace_columns_<I + 1>(args);
+					} catch (...) {
+						column.pop_back();
+						throw;
+					}
+				}
+			}
+
+			// Resizes each column from old to n elements; on exception, the
+			// columns already grown are shrunk back so that all keep size().
+			template<std::size_t I>
+			void resize_columns_(std::size_t n, std::size_t old) {
+				if constexpr (I < sizeof...(Ts)) {
+					auto& column = std::get<I>(columns_);
+					column.resize(n);
+					try {
+						resize_columns_<I + 1>(n, old);
+					} catch (...) {
+						column.erase(column.begin() + old, column.end());
+						throw;
+					}
+				}
+			}
+		public:
+			using value_type = std::tuple<Ts...>;
+			using size_type = index_t;
+			using difference_type = index_t;
+			using reference = soa_reference<Ts&...>;
+			using const_reference = soa_reference<const Ts&...>;
+			using iterator = __iterator<false>;
+			using const_iterator = __iterator<true>;
+
+			soa_vector() = default;
+			explicit soa_vector(index_t n)
+			requires (default_initializable<Ts> && ...)
+			{ resize(n); }
+
+			index_t size() const noexcept
+			{ return static_cast<index_t>(std::get<0>(columns_).size()); }
+			bool empty() const noexcept { return size() == 0; }
+			index_t capacity() const noexcept {
+				return std::apply([](const auto&... c) {
+					return static_cast<index_t>(std::min({c.capacity()...}));
+				}, columns_);
+			}
+
+			void reserve(index_t n) {
+				for_each_column_([n](auto& c) { c.reserve(static_cast<std::size_t>(n)); }, seq_t{});
+			}
+			void resize(index_t n)
+			requires (default_initializable<Ts> && ...)
+			{
+				STL2_EXPECT(n >= 0);
+				resize_columns_<0>(static_cast<std::size_t>(n), static_cast<std::size_t>(size()));
+			}
+			void clear() noexcept {
+				for_each_column_([](auto& c) { c.clear(); }, seq_t{});
+			}
+			void shrink_to_fit() {
+				for_each_column_([](auto& c) { c.shrink_to_fit(); }, seq_t{});
+			}
+
+			// The I-th member of every record, contiguous.
+			template<std::size_t I>
+			span<meta::at_c<meta::list<Ts...>, I>> column() noexcept {
+				auto& c = std::get<I>(columns_);
+				return {c.data(), static_cast<index_t>(c.size())};
+			}
+			template<std::size_t I>
+			span<const meta::at_c<meta::list<Ts...>, I>> column() const noexcept {
+				auto& c = std::get<I>(columns_);
+				return {c.data(), static_cast<index_t>(c.size())};
+			}
+
+			iterator begin() noexcept { return begin_(0, seq_t{}); }
+			iterator end() noexcept { return begin_(size(), seq_t{}); }
+			const_iterator begin() const noexcept { return begin_(0, seq_t{}); }
+			const_iterator end() const noexcept { return begin_(size(), seq_t{}); }
+
+			reference operator[](index_t n) noexcept {
+				STL2_EXPECT(0 <= n && n < size());
+				return begin()[n];
+			}
+			const_reference operator[](index_t n) const noexcept {
+				STL2_EXPECT(0 <= n && n < size());
+				return begin()[n];
+			}
+			reference front() noexcept { return (*this)[0]; }
+			const_reference front() const noexcept { return (*this)[0]; }
+			reference back() noexcept { return (*this)[size() - 1]; }
+			const_reference back() const noexcept { return (*this)[size() - 1]; }
+
+			template<class... Args>
+			requires (sizeof...(Args) == sizeof...(Ts)) &&
+				(constructible_from<Ts, Args> && ...)
+			reference emplace_back(Args&&... args) {
+				auto refs = std::forward_as_tuple(std::forward<Args>(args)...);
+				emplace_columns_<0>(refs);
+				return back();
+			}
+			void push_back(const value_type& v)
+			requires (copy_constructible<Ts> && ...)
+			{ std::apply([this](const Ts&... ts) { emplace_back(ts...); }, v); }
+			void push_back(value_type&& v) {
+				std::apply([this](Ts&... ts) { emplace_back(std::move(ts)...); }, v);
+			}
+
+			void pop_back() noexcept {
+				STL2_EXPECT(!empty());
+				for_each_column_([](auto& c) { c.pop_back(); }, seq_t{});
+			}
+
+			// Erases the records [first, last), e.g. the tail left by
+			// remove_if or unique.
+			iterator erase(const_iterator first, const_iterator last) {
+				const auto f = first - begin();
+				const auto l = last - begin();
+				STL2_EXPECT(0 <= f && f <= l && l <= size());
+				for_each_column_([f, l](auto& c) {
+					c.erase(c.begin() + f, c.begin() + l);
+				}, seq_t{});
+				return begin() + f;
+			}
+
+			void swap(soa_vector& that) noexcept { columns_.swap(that.columns_); }
+			friend void swap(soa_vector& x, soa_vector& y) noexcept { x.swap(y); }
+
+			friend bool operator==(const soa_vector& x, const soa_vector& y)
+			{ return x.columns_ == y.columns_; }
+			friend bool operator!=(const soa_vector& x, const soa_vector& y)
+			{ return !(x == y); }
+		};
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
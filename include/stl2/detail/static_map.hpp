@@ -0,0 +1,227 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_STATIC_MAP_HPP
+#define STL2_DETAIL_STATIC_MAP_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <stl2/functional.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/algorithm/adjacent_find.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// static_map [Extension]
+//
+// An immutable associative array built entirely during constant
+// evaluation. Up to static_map_max_hashed entries are placed by a minimal
+// collision-free hash (PTHash-style: keys are grouped into buckets, and each
+// bucket searches for a "pilot" value that moves all its keys to free
+// slots), so that a lookup is one hash, two table loads and one key
+// comparison. Larger maps fall back to a sorted array and binary search,
+// keeping compile times bounded.
+//
+// Keys are hashed with ext::static_hash<Key>, which is provided for
+// integral, enumeration and basic_string_view types and may be specialized
+// for others.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		namespace __static_map {
+			// The splitmix64 finalizer.
+			constexpr std::uint64_t mix(std::uint64_t x) noexcept {
+				x ^= x >> 30;
+				x *= 0xbf58476d1ce4e5b9u;
+				x ^= x >> 27;
+				x *= 0x94d049bb133111ebu;
+				x ^= x >> 31;
+				return x;
+			}
+
+			constexpr std::size_t bit_ceil(std::size_t n) noexcept {
+				std::size_t m = 1;
+				while (m < n) m <<= 1;
+				return m;
+			}
+		}
+
+		template<class Key>
+		struct static_hash;
+
+		template<class Key>
+		requires std::is_integral_v<Key> || std::is_enum_v<Key>
+		struct static_hash<Key> {
+			constexpr std::uint64_t operator()(Key k, std::uint64_t seed) const noexcept {
+				return __static_map::mix(static_cast<std::uint64_t>(k) ^ seed);
+			}
+		};
+
+		template<class CharT, class Traits>
+		struct static_hash<std::basic_string_view<CharT, Traits>> {
+			constexpr std::uint64_t operator()(std::basic_string_view<CharT, Traits> s,
+				std::uint64_t seed) const noexcept
+			{
+				// FNV-1a, seeded through the offset basis.
+				std::uint64_t h = 0xcbf29ce484222325u ^ seed;
+				for (auto c : s) {
+					h ^= static_cast<std::uint64_t>(c);
+					h *= 0x100000001b3u;
+				}
+				return __static_map::mix(h);
+			}
+		};
+
+		inline constexpr std::size_t static_map_max_hashed = 4096;
+
+		template<class Key, class Value, std::size_t N,
+			class Hash = static_hash<Key>, class Less = less>
+		requires (N > 0)
+		class static_map {
+		public:
+			using key_type = Key;
+			using mapped_type = Value;
+			using value_type = std::pair<Key, Value>;
+			using const_iterator = const value_type*;
+			using size_type = std::size_t;
+
+			static constexpr bool hashed = N <= static_map_max_hashed;
+		private:
+			using slot_t = meta::if_c<(N < 0xffff), std::uint16_t, std::uint32_t>;
+
+			// Twice as many slots as keys, and about two keys per bucket, keep
+			// the pilot search short.
+			static constexpr std::size_t slots_ = hashed ? __static_map::bit_ceil(2 * N) : 0;
+			static constexpr std::size_t buckets_ = hashed ? __static_map::bit_ceil((N + 1) / 2) : 0;
+			static constexpr int slot_shift_ = [] {
+				int shift = 64;
+				for (auto n = slots_; n > 1; n >>= 1) --shift;
+				return shift;
+			}();
+
+			std::array<value_type, N> entries_{};
+			std::array<slot_t, slots_> slot_{};
+			std::array<std::uint32_t, buckets_> pilot_{};
+			std::uint64_t seed_ = 0;
+
+			static constexpr std::size_t bucket_of(std::uint64_t h) noexcept
+			{ return static_cast<std::size_t>(h >> 32) & (buckets_ - 1); }
+			// Multiplying before taking the high bits makes the slot depend on
+			// every bit of h ^ pilot hash: keys sharing low hash bits still
+			// separate for some pilot.
+			static constexpr std::size_t slot_of(std::uint64_t h, std::uint32_t pilot) noexcept {
+				return static_cast<std::size_t>(
+					((h ^ __static_map::mix(pilot)) * 0x9e3779b97f4a7c15u) >> slot_shift_);
+			}
+
+			constexpr bool try_build(std::uint64_t seed) {
+				constexpr std::size_t max_pilot = 1 << 16;
+				seed_ = seed;
+				std::array<std::uint64_t, N> hashes{};
+				std::array<std::size_t, N> order{};
+				std::array<std::size_t, buckets_> size{};
+				for (std::size_t i = 0; i < N; ++i) {
+					hashes[i] = Hash{}(entries_[i].first, seed);
+					order[i] = i;
+					++size[bucket_of(hashes[i])];
+				}
+				// Place the largest buckets first, while most slots are free;
+				// keys of a bucket are contiguous in order.
+				__stl2::sort(order, [&](std::size_t x, std::size_t y) {
+					const auto bx = bucket_of(hashes[x]);
+					const auto by = bucket_of(hashes[y]);
+					return size[bx] != size[by] ? size[bx] > size[by] : bx < by;
+				});
+
+				std::array<bool, slots_> taken{};
+				for (std::size_t first = 0; first < N;) {
+					const auto bucket = bucket_of(hashes[order[first]]);
+					const auto last = first + size[bucket];
+					std::uint32_t pilot = 0;
+					for (;; ++pilot) {
+						if (pilot == max_pilot) return false;
+						bool ok = true;
+						for (auto i = first; ok && i < last; ++i) {
+							const auto s = slot_of(hashes[order[i]], pilot);
+							ok = !taken[s];
+							for (auto j = first; ok && j < i; ++j) {
+								ok = slot_of(hashes[order[j]], pilot) != s;
+							}
+						}
+						if (ok) break;
+					}
+					pilot_[bucket] = pilot;
+					for (auto i = first; i < last; ++i) {
+						const auto s = slot_of(hashes[order[i]], pilot);
+						taken[s] = true;
+						slot_[s] = static_cast<slot_t>(order[i]);
+					}
+					first = last;
+				}
+				return true;
+			}
+		public:
+			// \pre The keys of entries are distinct.
+			constexpr explicit static_map(const value_type (&entries)[N]) {
+				for (std::size_t i = 0; i < N; ++i) {
+					entries_[i] = entries[i];
+				}
+				// Sorting also exposes duplicate keys.
+				__stl2::sort(entries_, Less{}, &value_type::first);
+				STL2_EXPECT(__stl2::adjacent_find(entries_, [](const auto& x, const auto& y) {
+					return !Less{}(x, y);
+				}, &value_type::first) == entries_.end());
+				if constexpr (hashed) {
+					std::uint64_t seed = 0;
+					while (!try_build(seed)) {
+						seed = __static_map::mix(seed + 1);
+					}
+				}
+			}
+
+			constexpr size_type size() const noexcept { return N; }
+			constexpr const_iterator begin() const noexcept { return entries_.data(); }
+			constexpr const_iterator end() const noexcept { return entries_.data() + N; }
+
+			constexpr const_iterator find(const Key& key) const {
+				if constexpr (hashed) {
+					const auto h = Hash{}(key, seed_);
+					const auto i = slot_[slot_of(h, pilot_[bucket_of(h)])];
+					const auto& e = entries_[i];
+					return !Less{}(e.first, key) && !Less{}(key, e.first) ? &e : end();
+				} else {
+					const auto it = __stl2::lower_bound(entries_, key, Less{}, &value_type::first);
+					return it != entries_.end() && !Less{}(key, it->first) ? &*it : end();
+				}
+			}
+
+			constexpr bool contains(const Key& key) const { return find(key) != end(); }
+
+			// The value mapped to key. \pre contains(key)
+			constexpr const Value& operator[](const Key& key) const {
+				const auto it = find(key);
+				STL2_EXPECT(it != end());
+				return it->second;
+			}
+		};
+
+		template<class Key, class Value, std::size_t N>
+		constexpr auto make_static_map(const std::pair<Key, Value> (&entries)[N]) {
+			return static_map<Key, Value, N>{entries};
+		}
+	} // namespace ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,115 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_STOP_CONDITION_HPP
+#define STL2_DETAIL_STOP_CONDITION_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stop_token>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/core.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// Stop conditions [Extension]
+//
+// Long-running algorithms have overloads that take a stop condition - a
+// std::stop_token, an ext::deadline, or anything else with a
+// stop_requested() member - before their other arguments, and give up
+// soon after it is satisfied. The condition is polled at coarse
+// granularity: about once per __stop_poll_interval units of work, or once
+// per chunk in the parallel algorithms. These overloads return an
+// ext::stoppable_result, whose stopped member says whether the algorithm
+// gave up; each algorithm documents the state it leaves behind if so.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<class T>
+		META_CONCEPT stop_condition = requires(const T& t) {
+			{ t.stop_requested() } -> convertible_to<bool>;
+		};
+
+		// Satisfied once Clock reaches a time point.
+		template<class Clock = std::chrono::steady_clock,
+			class Duration = typename Clock::duration>
+		class deadline {
+		private:
+			std::chrono::time_point<Clock, Duration> when_;
+		public:
+			constexpr explicit deadline(std::chrono::time_point<Clock, Duration> when) noexcept
+			: when_{when} {}
+
+			constexpr std::chrono::time_point<Clock, Duration> when() const noexcept
+			{ return when_; }
+
+			bool stop_requested() const noexcept { return Clock::now() >= when_; }
+		};
+
+		template<class T>
+		struct stoppable_result {
+			STL2_NO_UNIQUE_ADDRESS T result;
+			bool stopped = false;
+		};
+	} // namespace ext
+
+	namespace detail {
+		inline constexpr std::ptrdiff_t __stop_poll_interval = 1 << 12;
+
+		// A stop condition that never holds; polling it compiles away.
+		struct __never_stop {
+			constexpr bool operator()(std::ptrdiff_t = 0) const noexcept { return false; }
+		};
+
+		// Polls stop once every __stop_poll_interval units of work, the
+		// first time on the first call.
+		template<ext::stop_condition St>
+		class __stop_poller {
+		private:
+			const St& stop_;
+			std::ptrdiff_t budget_ = 0;
+			bool stopped_ = false;
+		public:
+			explicit __stop_poller(const St& stop) noexcept
+			: stop_{stop} {}
+
+			bool operator()(std::ptrdiff_t work = 1) {
+				if ((budget_ -= work) > 0) return false;
+				budget_ = __stop_poll_interval;
+				return stopped_ = static_cast<bool>(stop_.stop_requested());
+			}
+
+			bool stopped() const noexcept { return stopped_; }
+		};
+
+		// Polls stop from several threads at once, remembering whether any
+		// poll has found it satisfied.
+		template<ext::stop_condition St>
+		class __shared_stop_poller {
+		private:
+			const St& stop_;
+			std::atomic<bool> stopped_{false};
+		public:
+			explicit __shared_stop_poller(const St& stop) noexcept
+			: stop_{stop} {}
+
+			bool operator()(std::ptrdiff_t = 0) {
+				if (stopped_.load(std::memory_order_relaxed)) return true;
+				if (!static_cast<bool>(stop_.stop_requested())) return false;
+				stopped_.store(true, std::memory_order_relaxed);
+				return true;
+			}
+
+			bool stopped() const noexcept { return stopped_.load(std::memory_order_relaxed); }
+		};
+	} // namespace detail
+} STL2_CLOSE_NAMESPACE
+
+#endif
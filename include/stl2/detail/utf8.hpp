@@ -0,0 +1,279 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_DETAIL_UTF8_HPP
+#define STL2_DETAIL_UTF8_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// UTF-8 primitives shared by utf8_validate, utf8_transcode and
+// utf8_codepoints_view.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		// Contiguous UTF-8 code units: char, char8_t, unsigned char, ...
+		template<class R>
+		META_CONCEPT _Utf8Range = contiguous_range<R> && sized_range<R> &&
+			(sizeof(range_value_t<R>) == 1) &&
+			std::is_trivially_copyable_v<range_value_t<R>>;
+
+		template<class R>
+		const unsigned char* __utf8_data(R& r) noexcept {
+			return reinterpret_cast<const unsigned char*>(__stl2::data(r));
+		}
+
+		// Returned by __utf8_decode for an ill-formed sequence.
+		inline constexpr char32_t __utf8_error = 0xffffffff;
+
+		// The first byte in [p, e) that is not ASCII, or e. Scans 32 or 16
+		// bytes per step with AVX2 or SSE2, else 8.
+		inline const unsigned char*
+		__utf8_ascii_end(const unsigned char* p, const unsigned char* e) noexcept {
+#if defined(__AVX2__)
+			for (; e - p >= 32; p += 32) {
+				const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+				if (const auto m = static_cast<unsigned>(_mm256_movemask_epi8(v))) {
+					return p + std::countr_zero(m);
+				}
+			}
+#endif
+#if defined(__SSE2__)
+			for (; e - p >= 16; p += 16) {
+				const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+				if (const auto m = static_cast<unsigned>(_mm_movemask_epi8(v))) {
+					return p + std::countr_zero(m);
+				}
+			}
+#endif
+			if constexpr (std::endian::native == std::endian::little) {
+				for (; e - p >= 8; p += 8) {
+					std::uint64_t w;
+					std::memcpy(&w, p, 8);
+					if (const auto m = w & 0x8080808080808080u) {
+						return p + std::countr_zero(m) / 8;
+					}
+				}
+			}
+			while (p != e && *p < 0x80) ++p;
+			return p;
+		}
+
+		// Decodes the sequence at p, which must not be e, and advances p past
+		// it. An ill-formed sequence yields __utf8_error, and p advances past
+		// its maximal subpart (Unicode 3.9, "U+FFFD Substitution of Maximal
+		// Subparts"): at least one byte, and no byte that could begin a
+		// well-formed sequence.
+		inline char32_t __utf8_decode(const unsigned char*& p, const unsigned char* e) noexcept {
+			const unsigned b0 = *p++;
+			if (b0 < 0x80) return b0;
+
+			int n;
+			unsigned lo = 0x80, hi = 0xbf;
+			char32_t cp;
+			if (b0 < 0xc2) {
+				return __utf8_error;
+			} else if (b0 < 0xe0) {
+				n = 1;
+				cp = b0 & 0x1f;
+			} else if (b0 < 0xf0) {
+				n = 2;
+				cp = b0 & 0x0f;
+				if (b0 == 0xe0) lo = 0xa0;
+				else if (b0 == 0xed) hi = 0x9f;
+			} else if (b0 < 0xf5) {
+				n = 3;
+				cp = b0 & 0x07;
+				if (b0 == 0xf0) lo = 0x90;
+				else if (b0 == 0xf4) hi = 0x8f;
+			} else {
+				return __utf8_error;
+			}
+			for (; n != 0; --n) {
+				if (p == e || *p < lo || *p > hi) return __utf8_error;
+				cp = (cp << 6) | (*p++ & 0x3fu);
+				lo = 0x80;
+				hi = 0xbf;
+			}
+			return cp;
+		}
+
+		// The start of the first ill-formed sequence in [p, e), which must
+		// begin at a sequence boundary; or e.
+		inline const unsigned char*
+		__utf8_find_invalid_scalar(const unsigned char* p, const unsigned char* e) noexcept {
+			while (p != e) {
+				p = __utf8_ascii_end(p, e);
+				if (p == e) break;
+				auto q = p;
+				if (__utf8_decode(q, e) == __utf8_error) return p;
+				p = q;
+			}
+			return e;
+		}
+
+#if defined(__SSSE3__)
+		// Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction
+		// Per Byte" (2021): each pair of adjacent bytes is classified by three
+		// 16-entry table lookups on its nibbles, whose conjunction is nonzero
+		// exactly where the pair is ill-formed, save for the number of
+		// continuation bytes after three- and four-byte leads, which is
+		// checked separately.
+		struct __utf8_simd_checker {
+			static constexpr unsigned char too_short = 1 << 0;
+			static constexpr unsigned char too_long = 1 << 1;
+			static constexpr unsigned char overlong_3 = 1 << 2;
+			static constexpr unsigned char too_large = 1 << 3;
+			static constexpr unsigned char surrogate = 1 << 4;
+			static constexpr unsigned char overlong_2 = 1 << 5;
+			static constexpr unsigned char too_large_1000 = 1 << 6;
+			static constexpr unsigned char overlong_4 = 1 << 6;
+			static constexpr unsigned char two_conts = 1 << 7;
+			static constexpr unsigned char carry = too_short | too_long | two_conts;
+
+			__m128i error = _mm_setzero_si128();
+			__m128i prev_input = _mm_setzero_si128();
+			__m128i prev_incomplete = _mm_setzero_si128();
+
+			static __m128i table(unsigned char t0, unsigned char t1, unsigned char t2,
+				unsigned char t3, unsigned char t4, unsigned char t5, unsigned char t6,
+				unsigned char t7, unsigned char t8, unsigned char t9, unsigned char t10,
+				unsigned char t11, unsigned char t12, unsigned char t13, unsigned char t14,
+				unsigned char t15) noexcept
+			{
+				return _mm_setr_epi8(static_cast<char>(t0), static_cast<char>(t1),
+					static_cast<char>(t2), static_cast<char>(t3), static_cast<char>(t4),
+					static_cast<char>(t5), static_cast<char>(t6), static_cast<char>(t7),
+					static_cast<char>(t8), static_cast<char>(t9), static_cast<char>(t10),
+					static_cast<char>(t11), static_cast<char>(t12), static_cast<char>(t13),
+					static_cast<char>(t14), static_cast<char>(t15));
+			}
+
+			static __m128i high_nibbles(__m128i v) noexcept {
+				return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+			}
+
+			static __m128i special_cases(__m128i input, __m128i prev1) noexcept {
+				const auto byte_1_high = _mm_shuffle_epi8(table(
+					too_long, too_long, too_long, too_long,
+					too_long, too_long, too_long, too_long,
+					two_conts, two_conts, two_conts, two_conts,
+					too_short | overlong_2,
+					too_short,
+					too_short | overlong_3 | surrogate,
+					too_short | too_large | too_large_1000 | overlong_4),
+					high_nibbles(prev1));
+				const auto byte_1_low = _mm_shuffle_epi8(table(
+					carry | overlong_3 | overlong_2 | overlong_4,
+					carry | overlong_2,
+					carry,
+					carry,
+					carry | too_large,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000 | surrogate,
+					carry | too_large | too_large_1000,
+					carry | too_large | too_large_1000),
+					_mm_and_si128(prev1, _mm_set1_epi8(0x0f)));
+				const auto byte_2_high = _mm_shuffle_epi8(table(
+					too_short, too_short, too_short, too_short,
+					too_short, too_short, too_short, too_short,
+					too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+					too_long | overlong_2 | two_conts | overlong_3 | too_large,
+					too_long | overlong_2 | two_conts | surrogate | too_large,
+					too_long | overlong_2 | two_conts | surrogate | too_large,
+					too_short, too_short, too_short, too_short),
+					high_nibbles(input));
+				return _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+			}
+
+			void check(__m128i input) noexcept {
+				if (_mm_movemask_epi8(input) == 0) {
+					// ASCII cannot continue a sequence begun in the last block.
+					error = _mm_or_si128(error, prev_incomplete);
+				} else {
+					const auto prev1 = _mm_alignr_epi8(input, prev_input, 15);
+					const auto sc = special_cases(input, prev1);
+					const auto prev2 = _mm_alignr_epi8(input, prev_input, 14);
+					const auto prev3 = _mm_alignr_epi8(input, prev_input, 13);
+					// Only 111_____ and 1111____ leads remain >= 0x80.
+					const auto must23 = _mm_or_si128(
+						_mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xe0 - 0x80))),
+						_mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80))));
+					const auto must23_80 = _mm_and_si128(must23, _mm_set1_epi8(static_cast<char>(0x80)));
+					error = _mm_or_si128(error, _mm_xor_si128(must23_80, sc));
+					// A lead in the last three bytes that needs more bytes.
+					prev_incomplete = _mm_subs_epu8(input, _mm_setr_epi8(
+						-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+						static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1),
+						static_cast<char>(0xc0 - 1)));
+				}
+				prev_input = input;
+			}
+
+			bool failed() const noexcept {
+				const auto zero = _mm_cmpeq_epi8(error, _mm_setzero_si128());
+				return _mm_movemask_epi8(zero) != 0xffff;
+			}
+
+			void finish() noexcept {
+				error = _mm_or_si128(error, prev_incomplete);
+			}
+		};
+#endif // __SSSE3__
+
+		// The start of the first ill-formed sequence in [p, e), or e.
+		inline const unsigned char*
+		__utf8_find_invalid(const unsigned char* p, const unsigned char* e) noexcept {
+#if defined(__SSSE3__)
+			const auto first = p;
+			__utf8_simd_checker checker;
+			constexpr std::ptrdiff_t block = 64;
+			for (; e - p >= block; p += block) {
+				for (int i = 0; i < block; i += 16) {
+					checker.check(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i)));
+				}
+				if (checker.failed()) break;
+			}
+			if (p == e) {
+				checker.finish();
+				if (!checker.failed()) return e;
+			}
+			// Everything before the block at p is well-formed, except perhaps
+			// a sequence begun at most three bytes back: rescan from its lead.
+			for (std::ptrdiff_t i = 1; i <= 3 && i <= p - first; ++i) {
+				if ((p[-i] & 0xc0) != 0x80) {
+					p -= i;
+					break;
+				}
+			}
+#endif
+			return __utf8_find_invalid_scalar(p, e);
+		}
+	} // namespace detail
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,15 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_RAGGED_VECTOR_HPP
+#define STL2_RAGGED_VECTOR_HPP
+
+#include <stl2/detail/ragged_vector.hpp>
+
+#endif
@@ -20,29 +20,41 @@
 #include <stl2/detail/range/nth_iterator.hpp>
 #include <stl2/detail/range/primitives.hpp>
 #include <stl2/view/all.hpp>
+#include <stl2/view/bitunpacked.hpp>
+#include <stl2/view/bytes_as.hpp>
+#include <stl2/view/cache_all.hpp>
 #include <stl2/view/common.hpp>
 #include <stl2/view/counted.hpp>
+#include <stl2/view/delta_decode.hpp>
 #include <stl2/view/drop.hpp>
 #include <stl2/view/drop_while.hpp>
 #include <stl2/view/empty.hpp>
+#include <stl2/view/file_chunks.hpp>
 #include <stl2/view/filter.hpp>
 #include <stl2/view/generate.hpp>
 #include <stl2/view/indirect.hpp>
+#include <stl2/view/instrument.hpp>
 #include <stl2/view/iota.hpp>
 #include <stl2/view/istream.hpp>
 #include <stl2/view/join.hpp>
+#include <stl2/view/join_indexed.hpp>
 #include <stl2/view/move.hpp>
+#include <stl2/view/random_permutation.hpp>
 #include <stl2/view/ref.hpp>
 #include <stl2/view/repeat_n.hpp>
 #include <stl2/view/repeat.hpp>
 #include <stl2/view/reverse.hpp>
 #include <stl2/view/single.hpp>
+#include <stl2/view/sorted.hpp>
 #include <stl2/view/split.hpp>
+#include <stl2/view/streamvbyte_decode.hpp>
 #include <stl2/view/subrange.hpp>
 #include <stl2/view/take.hpp>
 #include <stl2/view/take_exactly.hpp>
 #include <stl2/view/take_while.hpp>
 #include <stl2/view/transform.hpp>
+#include <stl2/view/utf8_codepoints.hpp>
+#include <stl2/view/varint_decode.hpp>
 #include <stl2/view/view_interface.hpp>
 
 #endif
@@ -0,0 +1,261 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_BITUNPACKED_HPP
+#define STL2_VIEW_BITUNPACKED_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/block_unpack.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/bytes_as.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// bitunpacked_view [Extension]
+//
+// A random-access view of integers stored as fixed-width bit fields: value
+// i is base plus bits [i * bits, (i + 1) * bits) of a contiguous range of
+// bytes, numbering bits from the least significant of the first byte.
+// (See ext::bitpack.) Element access is one unaligned load, a shift and a
+// mask.
+//
+// The iterators are _BlockUnpackable: copy, for_each, count and count_if
+// decode runs of 32 fields, which always begin on a byte boundary, with a
+// kernel specialized for each width, whose shifts and masks are constants.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class T>
+		META_CONCEPT _BitpackValue = std::is_integral_v<T> && !same_as<T, bool> &&
+			(sizeof(T) <= 8);
+
+		constexpr std::uint64_t __low_bits(int bits) noexcept {
+			return bits >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+		}
+
+		inline std::uint64_t __load_le64(const unsigned char* p) noexcept {
+			std::uint64_t w;
+			std::memcpy(&w, p, 8);
+			if constexpr (std::endian::native == std::endian::big) {
+				w = __builtin_bswap64(w);
+			}
+			return w;
+		}
+
+		// Bits [pos, pos + bits) of the bit string in [p, p + bytes).
+		inline std::uint64_t __bit_extract(const unsigned char* p, std::ptrdiff_t bytes,
+			std::ptrdiff_t pos, int bits) noexcept
+		{
+			if (bits == 0) return 0;
+			const auto byte = pos / 8;
+			const int shift = static_cast<int>(pos % 8);
+			unsigned char buf[9] = {};
+			const auto avail = bytes - byte;
+			std::memcpy(buf, p + byte, static_cast<std::size_t>(avail < 9 ? avail : 9));
+			auto w = __load_le64(buf) >> shift;
+			if (shift != 0) w |= std::uint64_t{buf[8]} << (64 - shift);
+			return w & __low_bits(bits);
+		}
+
+		// Unpacks the 32 Bits-wide fields in the 4 * Bits bytes at p, which
+		// must be followed by at least 9 readable bytes.
+		template<int Bits, class T>
+		void __bitunpack32(const unsigned char* p, T* out, T base) noexcept {
+			using U = std::make_unsigned_t<T>;
+			constexpr auto mask = __low_bits(Bits);
+#pragma GCC unroll 32
+			for (int i = 0; i < 32; ++i) {
+				const int pos = i * Bits;
+				auto w = __load_le64(p + pos / 8) >> (pos % 8);
+				if constexpr (Bits > 56) {
+					if (pos % 8 + Bits > 64) {
+						w |= std::uint64_t{p[pos / 8 + 8]} << (64 - pos % 8);
+					}
+				}
+				out[i] = static_cast<T>(static_cast<U>(base) + static_cast<U>(w & mask));
+			}
+		}
+
+		template<class T, std::size_t... Bits>
+		constexpr auto __make_bitunpack_table(std::index_sequence<Bits...>) noexcept {
+			using kernel = void (*)(const unsigned char*, T*, T) noexcept;
+			return std::array<kernel, sizeof...(Bits)>{{
+				&__bitunpack32<static_cast<int>(Bits), T>...}};
+		}
+
+		template<class T>
+		inline constexpr auto __bitunpack_table = __make_bitunpack_table<T>(
+			std::make_index_sequence<std::numeric_limits<std::make_unsigned_t<T>>::digits + 1>{});
+	} // namespace detail
+
+	namespace ext {
+		template<class T>
+		requires detail::_BitpackValue<T>
+		class bitunpacked_view : public view_interface<bitunpacked_view<T>> {
+		private:
+			using U = std::make_unsigned_t<T>;
+			class __iterator;
+
+			const unsigned char* data_ = nullptr;
+			std::ptrdiff_t bytes_ = 0;
+			std::ptrdiff_t size_ = 0;
+			int bits_ = 0;
+			T base_ = 0;
+
+			T get(std::ptrdiff_t i) const noexcept {
+				return static_cast<T>(static_cast<U>(base_) +
+					static_cast<U>(detail::__bit_extract(data_, bytes_, i * bits_, bits_)));
+			}
+
+			T* unpack(std::ptrdiff_t i, std::ptrdiff_t n, T* out) const noexcept {
+				const auto last = i + n;
+				// To a block boundary, which is byte-aligned...
+				for (; i < last && i % 32 != 0; ++i) {
+					*out++ = get(i);
+				}
+				// ...whole blocks while the kernel's loads stay in bounds...
+				const auto kernel = detail::__bitunpack_table<T>[static_cast<std::size_t>(bits_)];
+				const std::ptrdiff_t block_bytes = 4 * bits_;
+				for (; last - i >= 32; i += 32, out += 32) {
+					const auto byte = i / 32 * block_bytes;
+					if (bytes_ - byte < block_bytes + 9) break;
+					kernel(data_ + byte, out, base_);
+				}
+				// ...and the rest.
+				for (; i < last; ++i) {
+					*out++ = get(i);
+				}
+				return out;
+			}
+		public:
+			static constexpr int max_bits = std::numeric_limits<U>::digits;
+
+			bitunpacked_view() = default;
+			constexpr bitunpacked_view(const void* data, std::ptrdiff_t bytes, int bits,
+				std::ptrdiff_t count, T base = 0) noexcept
+			: data_{static_cast<const unsigned char*>(data)}, bytes_{bytes}, size_{count}
+			, bits_{bits}, base_{base}
+			{
+				STL2_EXPECT(0 <= bits && bits <= max_bits);
+				STL2_EXPECT(0 <= count && count * bits <= bytes * 8);
+			}
+
+			// As many fields as the bytes hold.
+			template<detail::_ByteRange R>
+			requires (!same_as<__uncvref<R>, bitunpacked_view>)
+			constexpr bitunpacked_view(R&& r, int bits, T base = 0)
+			: bitunpacked_view{__stl2::data(r), static_cast<std::ptrdiff_t>(__stl2::size(r)),
+				bits, bits > 0 ? static_cast<std::ptrdiff_t>(__stl2::size(r)) * 8 / bits : 0, base}
+			{ STL2_EXPECT(bits > 0); }
+
+			template<detail::_ByteRange R>
+			constexpr bitunpacked_view(R&& r, int bits, std::ptrdiff_t count, T base)
+			: bitunpacked_view{__stl2::data(r), static_cast<std::ptrdiff_t>(__stl2::size(r)),
+				bits, count, base} {}
+
+			constexpr int bits() const noexcept { return bits_; }
+			constexpr T base() const noexcept { return base_; }
+
+			constexpr __iterator begin() const noexcept { return __iterator{*this, 0}; }
+			constexpr __iterator end() const noexcept { return __iterator{*this, size_}; }
+			constexpr std::ptrdiff_t size() const noexcept { return size_; }
+		};
+
+		template<class T>
+		requires detail::_BitpackValue<T>
+		class bitunpacked_view<T>::__iterator {
+		private:
+			const bitunpacked_view* parent_ = nullptr;
+			std::ptrdiff_t i_ = 0;
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			constexpr __iterator(const bitunpacked_view& parent, std::ptrdiff_t i) noexcept
+			: parent_{&parent}, i_{i} {}
+
+			T operator*() const noexcept { return parent_->get(i_); }
+			T operator[](difference_type n) const noexcept { return parent_->get(i_ + n); }
+
+			// Writes the values of [*this, last) to out.
+			T* unpack(const __iterator& last, T* out) const noexcept {
+				STL2_EXPECT(parent_ == last.parent_ && i_ <= last.i_);
+				return parent_->unpack(i_, last.i_ - i_, out);
+			}
+
+			constexpr __iterator& operator++() noexcept { ++i_; return *this; }
+			constexpr __iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+			constexpr __iterator& operator--() noexcept { --i_; return *this; }
+			constexpr __iterator operator--(int) noexcept
+			{ auto tmp = *this; --*this; return tmp; }
+			constexpr __iterator& operator+=(difference_type n) noexcept
+			{ i_ += n; return *this; }
+			constexpr __iterator& operator-=(difference_type n) noexcept
+			{ i_ -= n; return *this; }
+
+			friend constexpr __iterator operator+(__iterator i, difference_type n) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator+(difference_type n, __iterator i) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator-(__iterator i, difference_type n) noexcept
+			{ return i -= n; }
+			friend constexpr difference_type
+			operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ - y.i_; }
+
+			friend constexpr bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ == y.i_; }
+			friend constexpr bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend constexpr bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ < y.i_; }
+			friend constexpr bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend constexpr bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend constexpr bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		template<class T>
+		struct __bitunpacked_fn {
+			template<detail::_ByteRange R>
+			constexpr auto operator()(R&& r, int bits, T base = 0) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::bitunpacked_view<T>{r, bits, base}
+			)
+
+			constexpr auto operator()(int bits, T base = 0) const
+			{ return detail::view_closure{*this, static_cast<int>(bits), static_cast<T>(base)}; }
+		};
+
+		template<class T>
+		requires __stl2::detail::_BitpackValue<T>
+		inline constexpr __bitunpacked_fn<T> bitunpacked{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,187 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_BYTES_AS_HPP
+#define STL2_VIEW_BYTES_AS_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// bytes_as_view [Extension]
+//
+// A random-access view of a contiguous range of bytes as a sequence of
+// trivially copyable Ts. Each element is loaded with memcpy, which is
+// defined for any alignment and compiles to a plain load, and is returned
+// by value. Trailing bytes too few to make a whole T are not part of the
+// view.
+//
+// With Endian other than std::endian::native, each element is byte-swapped
+// after loading; Ts are then restricted to scalar types. The load-and-swap
+// has no loop-carried dependence, so loops over contiguous runs of the view
+// vectorize into wide loads and byte shuffles.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class T>
+		T __byteswap(T t) noexcept {
+			if constexpr (sizeof(T) == 1) {
+				return t;
+			} else {
+				using U = meta::if_c<sizeof(T) == 2, std::uint16_t,
+					meta::if_c<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+				static_assert(sizeof(U) == sizeof(T));
+				auto u = std::bit_cast<U>(t);
+				if constexpr (sizeof(T) == 2) u = __builtin_bswap16(u);
+				else if constexpr (sizeof(T) == 4) u = __builtin_bswap32(u);
+				else u = __builtin_bswap64(u);
+				return std::bit_cast<T>(u);
+			}
+		}
+
+		template<class T, std::endian Endian>
+		META_CONCEPT _BytesAsElement = std::is_trivially_copyable_v<T> &&
+			default_initializable<T> &&
+			(Endian == std::endian::native ||
+				((std::is_arithmetic_v<T> || std::is_enum_v<T>) &&
+					(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)));
+
+		// Bytes that outlive the expression naming them.
+		template<class R>
+		META_CONCEPT _ByteRange = contiguous_range<R> && sized_range<R> &&
+			(sizeof(range_value_t<R>) == 1) &&
+			std::is_trivially_copyable_v<range_value_t<R>> &&
+			(std::is_lvalue_reference_v<R> || view<__uncvref<R>>);
+	} // namespace detail
+
+	namespace ext {
+		template<class T, std::endian Endian = std::endian::native>
+		requires detail::_BytesAsElement<T, Endian>
+		class bytes_as_view : public view_interface<bytes_as_view<T, Endian>> {
+		private:
+			class __iterator;
+
+			const unsigned char* data_ = nullptr;
+			std::ptrdiff_t size_ = 0;
+		public:
+			bytes_as_view() = default;
+			constexpr bytes_as_view(const void* data, std::ptrdiff_t bytes) noexcept
+			: data_{static_cast<const unsigned char*>(data)}
+			, size_{bytes / static_cast<std::ptrdiff_t>(sizeof(T))} {}
+
+			template<detail::_ByteRange R>
+			requires (!same_as<__uncvref<R>, bytes_as_view>)
+			explicit constexpr bytes_as_view(R&& r)
+			: bytes_as_view{__stl2::data(r), static_cast<std::ptrdiff_t>(__stl2::size(r))} {}
+
+			constexpr __iterator begin() const noexcept { return __iterator{data_}; }
+			constexpr __iterator end() const noexcept {
+				return __iterator{data_ + size_ * static_cast<std::ptrdiff_t>(sizeof(T))};
+			}
+			constexpr std::ptrdiff_t size() const noexcept { return size_; }
+		};
+
+		template<class T, std::endian Endian>
+		requires detail::_BytesAsElement<T, Endian>
+		class bytes_as_view<T, Endian>::__iterator {
+		private:
+			static constexpr std::ptrdiff_t width = sizeof(T);
+
+			const unsigned char* p_ = nullptr;
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			explicit constexpr __iterator(const unsigned char* p) noexcept : p_{p} {}
+
+			T operator*() const noexcept {
+				T t;
+				std::memcpy(&t, p_, sizeof(T));
+				if constexpr (Endian != std::endian::native) {
+					t = detail::__byteswap(t);
+				}
+				return t;
+			}
+			T operator[](difference_type n) const noexcept
+			{ return *(*this + n); }
+
+			constexpr __iterator& operator++() noexcept { p_ += width; return *this; }
+			constexpr __iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+			constexpr __iterator& operator--() noexcept { p_ -= width; return *this; }
+			constexpr __iterator operator--(int) noexcept
+			{ auto tmp = *this; --*this; return tmp; }
+			constexpr __iterator& operator+=(difference_type n) noexcept
+			{ p_ += n * width; return *this; }
+			constexpr __iterator& operator-=(difference_type n) noexcept
+			{ p_ -= n * width; return *this; }
+
+			friend constexpr __iterator operator+(__iterator i, difference_type n) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator+(difference_type n, __iterator i) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator-(__iterator i, difference_type n) noexcept
+			{ return i -= n; }
+			friend constexpr difference_type
+			operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return (x.p_ - y.p_) / width; }
+
+			friend constexpr bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.p_ == y.p_; }
+			friend constexpr bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend constexpr bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.p_ < y.p_; }
+			friend constexpr bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend constexpr bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend constexpr bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		template<class T, std::endian Endian>
+		struct __bytes_as_fn : detail::__pipeable<__bytes_as_fn<T, Endian>> {
+			template<detail::_ByteRange R>
+			constexpr auto operator()(R&& r) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::bytes_as_view<T, Endian>{r}
+			)
+		};
+
+		template<class T>
+		requires __stl2::detail::_BytesAsElement<T, std::endian::native>
+		inline constexpr __bytes_as_fn<T, std::endian::native> bytes_as{};
+
+		template<class T>
+		requires __stl2::detail::_BytesAsElement<T, std::endian::big>
+		inline constexpr __bytes_as_fn<T, std::endian::big> bytes_as_be{};
+
+		template<class T>
+		requires __stl2::detail::_BytesAsElement<T, std::endian::little>
+		inline constexpr __bytes_as_fn<T, std::endian::little> bytes_as_le{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
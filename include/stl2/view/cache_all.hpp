@@ -0,0 +1,273 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_CACHE_ALL_HPP
+#define STL2_VIEW_CACHE_ALL_HPP
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// cache_all_view [Extension]
+//
+// Traverses the underlying view once, recording each element - by position
+// when the base is a forward range, by value otherwise - so that the result
+// is a sized random-access range however weak the base. With Incremental ==
+// false the first call to begin() (or size()) records everything into a
+// std::vector; for an input base the view is then a contiguous range of the
+// buffered values. With Incremental == true elements are recorded into a
+// std::deque only as far as iterators have been dereferenced or compared,
+// and end() is default_sentinel.
+//
+// Copies of a cache_all_view share a single cache, so copying stays O(1)
+// and an input base is never read twice. The cache is filled on demand
+// without synchronization, so a view and its copies - and their iterators
+// - must not be used on different threads at once unless the cache is
+// already complete, as it is after size() returns.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<input_range V, bool Incremental = false>
+		requires view<V> && (forward_range<V> ||
+			constructible_from<range_value_t<V>, range_reference_t<V>>)
+		class cache_all_view
+		: public view_interface<cache_all_view<V, Incremental>> {
+		private:
+			static constexpr bool by_position = forward_range<V>;
+
+			using cached_t = meta::if_c<by_position, iterator_t<V>, range_value_t<V>>;
+			using buffer_t = meta::if_c<Incremental,
+				std::deque<cached_t>, std::vector<cached_t>>;
+
+			struct __cache {
+				V base_;
+				std::optional<iterator_t<V>> next_;
+				buffer_t buffer_;
+				// next_ still denotes the last recorded element; incrementing
+				// is deferred so that no element is computed before it is needed.
+				bool stale_ = false;
+
+				// Records elements until at least n are cached or the base is
+				// exhausted. Returns true if and only if at least n are cached.
+				bool fill(std::size_t n) {
+					if (buffer_.size() >= n) return true;
+					if (!next_) {
+						if constexpr (!Incremental && sized_range<V>) {
+							buffer_.reserve(static_cast<std::size_t>(__stl2::size(base_)));
+						}
+						next_.emplace(__stl2::begin(base_));
+					}
+					auto& i = *next_;
+					const auto last = __stl2::end(base_);
+					while (buffer_.size() < n) {
+						if (stale_) {
+							++i;
+							stale_ = false;
+						}
+						if (i == last) break;
+						if constexpr (by_position) {
+							buffer_.push_back(i);
+						} else {
+							buffer_.emplace_back(*i);
+						}
+						stale_ = true;
+					}
+					return buffer_.size() >= n;
+				}
+
+				std::size_t fill_all() {
+					(void) fill(static_cast<std::size_t>(-1));
+					return buffer_.size();
+				}
+			};
+
+			class __iterator;
+
+			std::shared_ptr<__cache> cache_;
+
+			__cache& get_() {
+				if (!cache_) cache_ = std::make_shared<__cache>();
+				return *cache_;
+			}
+		public:
+			cache_all_view() = default;
+
+			explicit cache_all_view(V base)
+			: cache_{std::make_shared<__cache>(__cache{std::move(base), {}, {}, false})} {}
+
+			V base() { return get_().base_; }
+
+			auto begin() {
+				auto& c = get_();
+				if constexpr (Incremental) {
+					return __iterator{c, 0};
+				} else if constexpr (by_position) {
+					(void) c.fill_all();
+					return __iterator{c, 0};
+				} else {
+					(void) c.fill_all();
+					return c.buffer_.data();
+				}
+			}
+
+			auto end() {
+				auto& c = get_();
+				if constexpr (Incremental) {
+					return default_sentinel;
+				} else if constexpr (by_position) {
+					return __iterator{c, static_cast<std::ptrdiff_t>(c.fill_all())};
+				} else {
+					return c.buffer_.data() + c.fill_all();
+				}
+			}
+
+			std::size_t size() { return get_().fill_all(); }
+		};
+
+		template<input_range V, bool Incremental>
+		requires view<V> && (forward_range<V> ||
+			constructible_from<range_value_t<V>, range_reference_t<V>>)
+		class cache_all_view<V, Incremental>::__iterator {
+		private:
+			detail::raw_ptr<__cache> cache_ = nullptr;
+			std::ptrdiff_t n_ = 0;
+
+			auto& cached_() const {
+				if constexpr (Incremental) {
+					const bool ok = cache_->fill(static_cast<std::size_t>(n_) + 1);
+					STL2_EXPECT(ok);
+					(void) ok;
+				}
+				return cache_->buffer_[static_cast<std::size_t>(n_)];
+			}
+			bool at_end_() const {
+				return !cache_->fill(static_cast<std::size_t>(n_) + 1);
+			}
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = range_value_t<V>;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			constexpr __iterator(__cache& c, std::ptrdiff_t n) noexcept
+			: cache_{std::addressof(c)}, n_{n} {}
+
+			decltype(auto) operator*() const {
+				if constexpr (by_position) {
+					return *cached_();
+				} else {
+					return cached_();
+				}
+			}
+
+			decltype(auto) operator[](difference_type n) const
+			{ return *(*this + n); }
+
+			__iterator& operator++() noexcept { ++n_; return *this; }
+			__iterator operator++(int) noexcept {
+				auto tmp = *this;
+				++n_;
+				return tmp;
+			}
+			__iterator& operator--() noexcept { --n_; return *this; }
+			__iterator operator--(int) noexcept {
+				auto tmp = *this;
+				--n_;
+				return tmp;
+			}
+			__iterator& operator+=(difference_type n) noexcept { n_ += n; return *this; }
+			__iterator& operator-=(difference_type n) noexcept { n_ -= n; return *this; }
+
+			friend __iterator operator+(__iterator i, difference_type n) noexcept
+			{ return i += n; }
+			friend __iterator operator+(difference_type n, __iterator i) noexcept
+			{ return i += n; }
+			friend __iterator operator-(__iterator i, difference_type n) noexcept
+			{ return i -= n; }
+			friend difference_type operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ - y.n_; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ == y.n_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ < y.n_; }
+			friend bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+
+			friend bool operator==(const __iterator& x, default_sentinel_t)
+			requires Incremental
+			{ return x.at_end_(); }
+			friend bool operator==(default_sentinel_t, const __iterator& x)
+			requires Incremental
+			{ return x.at_end_(); }
+			friend bool operator!=(const __iterator& x, default_sentinel_t)
+			requires Incremental
+			{ return !x.at_end_(); }
+			friend bool operator!=(default_sentinel_t, const __iterator& x)
+			requires Incremental
+			{ return !x.at_end_(); }
+			friend difference_type operator-(default_sentinel_t, const __iterator& x)
+			requires Incremental
+			{ return static_cast<difference_type>(x.cache_->fill_all()) - x.n_; }
+			friend difference_type operator-(const __iterator& x, default_sentinel_t)
+			requires Incremental
+			{ return x.n_ - static_cast<difference_type>(x.cache_->fill_all()); }
+
+			friend decltype(auto) iter_move(const __iterator& i) {
+				if constexpr (by_position) {
+					return __stl2::iter_move(i.cached_());
+				} else {
+					return std::move(i.cached_());
+				}
+			}
+		};
+
+		template<class R>
+		cache_all_view(R&&) -> cache_all_view<all_view<R>>;
+	} // namespace ext
+
+	namespace views::ext {
+		template<bool Incremental>
+		struct __cache_all_fn : detail::__pipeable<__cache_all_fn<Incremental>> {
+			template<input_range R>
+			requires viewable_range<R>
+			constexpr auto operator()(R&& rng) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::cache_all_view<all_view<R>, Incremental>{
+					all(std::forward<R>(rng))}
+			)
+		};
+
+		inline constexpr __cache_all_fn<false> cache_all{};
+		inline constexpr __cache_all_fn<true> cache_incremental{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
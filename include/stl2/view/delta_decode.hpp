@@ -0,0 +1,191 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_DELTA_DECODE_HPP
+#define STL2_VIEW_DELTA_DECODE_HPP
+
+#include <type_traits>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// delta_decode_view [Extension]
+//
+// The running sums of a view of integers: the inverse of ext::delta_encode.
+// Sums wrap modulo 2^N, even for signed integers, so every sequence of
+// values round-trips.
+// Each iterator carries the sum of the elements before it, so dereference
+// is one addition, and reads its element of the base once however often it
+// is dereferenced and advanced. The view composes with varint_decode or
+// streamvbyte_decode without materializing the deltas.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<input_range V>
+		requires view<V> && std::is_integral_v<range_value_t<V>> &&
+			(!same_as<range_value_t<V>, bool>)
+		class delta_decode_view : public view_interface<delta_decode_view<V>> {
+		private:
+			template<bool> class __iterator;
+
+			V base_ = V();
+			range_value_t<V> init_ = 0;
+		public:
+			using value_type = range_value_t<V>;
+
+			delta_decode_view() = default;
+			constexpr explicit delta_decode_view(V base, value_type init = 0)
+			: base_(std::move(base)), init_(init) {}
+
+			constexpr V base() const { return base_; }
+
+			constexpr __iterator<false> begin()
+			{ return {__stl2::begin(base_), init_}; }
+			template<class ConstV = const V>
+			constexpr __iterator<true> begin() const requires input_range<ConstV>
+			{ return {__stl2::begin(base_), init_}; }
+
+			constexpr auto end() {
+				if constexpr (common_range<V>) {
+					return __iterator<false>{__stl2::end(base_), init_};
+				} else {
+					return __stl2::end(base_);
+				}
+			}
+			template<class ConstV = const V>
+			constexpr auto end() const requires input_range<ConstV> {
+				if constexpr (common_range<ConstV>) {
+					return __iterator<true>{__stl2::end(base_), init_};
+				} else {
+					return __stl2::end(base_);
+				}
+			}
+
+			constexpr auto size() requires sized_range<V>
+			{ return __stl2::size(base_); }
+			template<class ConstV = const V>
+			constexpr auto size() const requires sized_range<ConstV>
+			{ return __stl2::size(base_); }
+		};
+
+		template<input_range V>
+		requires view<V> && std::is_integral_v<range_value_t<V>> &&
+			(!same_as<range_value_t<V>, bool>)
+		template<bool Const>
+		class delta_decode_view<V>::__iterator {
+		private:
+			using Base = __maybe_const<Const, V>;
+			using T = range_value_t<V>;
+
+			iterator_t<Base> current_{};
+			T acc_ = 0;
+			// acc_ plus *current_, once dereferenced: advancing reuses it
+			// rather than reading the base again, which may decode.
+			mutable T sum_ = 0;
+			mutable bool cached_ = false;
+
+			static constexpr T add_(T x, T y) noexcept {
+				using U = std::make_unsigned_t<T>;
+				return static_cast<T>(static_cast<U>(static_cast<U>(x) + static_cast<U>(y)));
+			}
+		public:
+			using iterator_category = meta::if_c<forward_range<Base>,
+				__stl2::forward_iterator_tag, __stl2::input_iterator_tag>;
+			using value_type = T;
+			using difference_type = iter_difference_t<iterator_t<Base>>;
+
+			__iterator() = default;
+			constexpr __iterator(iterator_t<Base> current, T acc)
+			: current_(std::move(current)), acc_(acc) {}
+
+			constexpr iterator_t<Base> base() const { return current_; }
+
+			constexpr T operator*() const {
+				if (!cached_) {
+					sum_ = add_(acc_, static_cast<T>(*current_));
+					cached_ = true;
+				}
+				return sum_;
+			}
+
+			constexpr __iterator& operator++() {
+				acc_ = cached_ ? sum_ : add_(acc_, static_cast<T>(*current_));
+				cached_ = false;
+				++current_;
+				return *this;
+			}
+			constexpr void operator++(int) { ++*this; }
+			constexpr __iterator operator++(int) requires forward_range<Base>
+			{ auto tmp = *this; ++*this; return tmp; }
+
+			friend constexpr bool operator==(const __iterator& x, const __iterator& y)
+			requires equality_comparable<iterator_t<Base>>
+			{ return x.current_ == y.current_; }
+			friend constexpr bool operator!=(const __iterator& x, const __iterator& y)
+			requires equality_comparable<iterator_t<Base>>
+			{ return !(x == y); }
+
+			friend constexpr bool operator==(const __iterator& x, const sentinel_t<Base>& y)
+			requires (!common_range<Base>)
+			{ return x.current_ == y; }
+			friend constexpr bool operator==(const sentinel_t<Base>& y, const __iterator& x)
+			requires (!common_range<Base>)
+			{ return x.current_ == y; }
+			friend constexpr bool operator!=(const __iterator& x, const sentinel_t<Base>& y)
+			requires (!common_range<Base>)
+			{ return !(x == y); }
+			friend constexpr bool operator!=(const sentinel_t<Base>& y, const __iterator& x)
+			requires (!common_range<Base>)
+			{ return !(x == y); }
+
+			friend constexpr difference_type
+			operator-(const __iterator& x, const __iterator& y)
+			requires sized_sentinel_for<iterator_t<Base>, iterator_t<Base>>
+			{ return x.current_ - y.current_; }
+			friend constexpr difference_type
+			operator-(const __iterator& x, const sentinel_t<Base>& y)
+			requires (!common_range<Base>) &&
+				sized_sentinel_for<sentinel_t<Base>, iterator_t<Base>>
+			{ return x.current_ - y; }
+			friend constexpr difference_type
+			operator-(const sentinel_t<Base>& y, const __iterator& x)
+			requires (!common_range<Base>) &&
+				sized_sentinel_for<sentinel_t<Base>, iterator_t<Base>>
+			{ return y - x.current_; }
+		};
+
+		template<class R>
+		delta_decode_view(R&&) -> delta_decode_view<all_view<R>>;
+		template<class R, class T>
+		delta_decode_view(R&&, T) -> delta_decode_view<all_view<R>>;
+	} // namespace ext
+
+	namespace views::ext {
+		struct __delta_decode_fn : detail::__pipeable<__delta_decode_fn> {
+			template<viewable_range R>
+			requires std::is_integral_v<range_value_t<R>> &&
+				(!same_as<range_value_t<R>, bool>)
+			constexpr auto operator()(R&& r) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::delta_decode_view{views::all(static_cast<R&&>(r))}
+			)
+		};
+
+		inline constexpr __delta_decode_fn delta_decode{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,485 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_FILE_CHUNKS_HPP
+#define STL2_VIEW_FILE_CHUNKS_HPP
+
+#include <stl2/detail/fwd.hpp>
+
+#ifdef __linux__
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/span.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// file_chunks_view [Extension]
+//
+// An input view of the contents of a regular file as consecutive
+// span<const std::byte> chunks of chunk_size bytes (the last may be
+// shorter). Up to depth reads of the following chunks are kept in flight
+// while the consumer works on the current one, through io_uring when the
+// kernel permits it, and otherwise through a background pread thread.
+//
+// A chunk's bytes remain valid until the iterator is next incremented.
+// Linux only.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		enum class file_chunks_backend {
+			automatic, // io_uring if available, else pread_thread
+			pread_thread
+		};
+	} // namespace ext
+
+	namespace detail {
+		[[noreturn]] inline void __throw_errno(int err, const char* what) {
+			throw std::system_error{err, std::system_category(), what};
+		}
+
+		// Reads len bytes at off, or up to the end of the file. Returns the
+		// number of bytes read, or -errno.
+		inline long __pread_full(int fd, std::byte* buf, std::size_t len, off_t off) noexcept {
+			std::size_t done = 0;
+			while (done < len) {
+				const auto n = ::pread(fd, buf + done, len - done, off + static_cast<off_t>(done));
+				if (n == 0) break;
+				if (n < 0) {
+					if (errno == EINTR) continue;
+					return -errno;
+				}
+				done += static_cast<std::size_t>(n);
+			}
+			return static_cast<long>(done);
+		}
+
+		// The bare minimum of io_uring: a ring of READV submissions, and the
+		// reaping of their completions.
+		class __uring {
+			int fd_ = -1;
+			void* sq_ring_ = MAP_FAILED;
+			std::size_t sq_ring_len_ = 0;
+			void* cq_ring_ = MAP_FAILED;
+			std::size_t cq_ring_len_ = 0;
+			io_uring_sqe* sqes_ = nullptr;
+			std::size_t sqes_len_ = 0;
+
+			unsigned* sq_tail_ = nullptr;
+			unsigned* sq_mask_ = nullptr;
+			unsigned* sq_array_ = nullptr;
+			unsigned* cq_head_ = nullptr;
+			unsigned* cq_tail_ = nullptr;
+			unsigned* cq_mask_ = nullptr;
+			io_uring_cqe* cqes_ = nullptr;
+			unsigned unsubmitted_ = 0;
+
+			static unsigned* at(void* ring, unsigned offset) noexcept {
+				return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+			}
+
+			int enter(unsigned to_submit, unsigned min_complete, unsigned flags) noexcept {
+				int r;
+				do {
+					r = static_cast<int>(::syscall(__NR_io_uring_enter, fd_,
+						to_submit, min_complete, flags, nullptr, 0));
+				} while (r < 0 && errno == EINTR);
+				return r < 0 ? -errno : r;
+			}
+		public:
+			__uring() = default;
+			__uring(const __uring&) = delete;
+			__uring& operator=(const __uring&) = delete;
+
+			~__uring() {
+				if (sqes_) ::munmap(sqes_, sqes_len_);
+				if (cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_ring_len_);
+				if (sq_ring_ != MAP_FAILED) ::munmap(sq_ring_, sq_ring_len_);
+				if (fd_ >= 0) ::close(fd_);
+			}
+
+			// Returns false if io_uring is unavailable, as under seccomp
+			// policies and on older kernels.
+			bool setup(unsigned entries) noexcept {
+				io_uring_params p;
+				std::memset(&p, 0, sizeof(p));
+				fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+				if (fd_ < 0) return false;
+
+				sq_ring_len_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+				cq_ring_len_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+				const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+				if (single) {
+					sq_ring_len_ = cq_ring_len_ =
+						sq_ring_len_ < cq_ring_len_ ? cq_ring_len_ : sq_ring_len_;
+				}
+				sq_ring_ = ::mmap(nullptr, sq_ring_len_, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+				if (sq_ring_ == MAP_FAILED) return false;
+				cq_ring_ = single ? sq_ring_ : ::mmap(nullptr, cq_ring_len_,
+					PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+				if (cq_ring_ == MAP_FAILED) return false;
+				sqes_len_ = p.sq_entries * sizeof(io_uring_sqe);
+				void* sqes = ::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE,
+					MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES);
+				if (sqes == MAP_FAILED) return false;
+				sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+				sq_tail_ = at(sq_ring_, p.sq_off.tail);
+				sq_mask_ = at(sq_ring_, p.sq_off.ring_mask);
+				sq_array_ = at(sq_ring_, p.sq_off.array);
+				cq_head_ = at(cq_ring_, p.cq_off.head);
+				cq_tail_ = at(cq_ring_, p.cq_off.tail);
+				cq_mask_ = at(cq_ring_, p.cq_off.ring_mask);
+				cqes_ = reinterpret_cast<io_uring_cqe*>(
+					static_cast<char*>(cq_ring_) + p.cq_off.cqes);
+				return true;
+			}
+
+			// Queues a read into iov; submit() passes it to the kernel.
+			void push_read(int fd, const iovec* iov, off_t off, std::uint64_t tag) noexcept {
+				const auto tail = *sq_tail_;
+				const auto i = tail & *sq_mask_;
+				auto& sqe = sqes_[i];
+				std::memset(&sqe, 0, sizeof(sqe));
+				sqe.opcode = IORING_OP_READV;
+				sqe.fd = fd;
+				sqe.addr = reinterpret_cast<std::uintptr_t>(iov);
+				sqe.len = 1;
+				sqe.off = static_cast<std::uint64_t>(off);
+				sqe.user_data = tag;
+				sq_array_[i] = i;
+				std::atomic_ref<unsigned>{*sq_tail_}.store(tail + 1, std::memory_order_release);
+				++unsubmitted_;
+			}
+
+			void submit() {
+				while (unsubmitted_ != 0) {
+					const int r = enter(unsubmitted_, 0, 0);
+					if (r < 0) __throw_errno(-r, "io_uring_enter");
+					unsubmitted_ -= static_cast<unsigned>(r);
+				}
+			}
+
+			// Calls f(tag, result) for each completion, first waiting for
+			// one if wait.
+			template<class F>
+			void reap(F&& f, bool wait) {
+				for (;;) {
+					auto head = *cq_head_;
+					const auto tail = std::atomic_ref<unsigned>{*cq_tail_}.load(std::memory_order_acquire);
+					if (head == tail) {
+						if (!wait) return;
+						const int r = enter(0, 1, IORING_ENTER_GETEVENTS);
+						if (r < 0) __throw_errno(-r, "io_uring_enter");
+						continue;
+					}
+					for (; head != tail; ++head) {
+						const auto& cqe = cqes_[head & *cq_mask_];
+						f(cqe.user_data, cqe.res);
+					}
+					std::atomic_ref<unsigned>{*cq_head_}.store(tail, std::memory_order_release);
+					return;
+				}
+			}
+		};
+
+		// Owns a file descriptor.
+		class __file_descriptor {
+			int fd_ = -1;
+		public:
+			__file_descriptor() = default;
+			explicit __file_descriptor(int fd) noexcept : fd_{fd} {}
+			__file_descriptor(__file_descriptor&& that) noexcept
+			: fd_{std::exchange(that.fd_, -1)} {}
+			__file_descriptor& operator=(__file_descriptor&& that) noexcept {
+				std::swap(fd_, that.fd_);
+				return *this;
+			}
+			~__file_descriptor() {
+				if (fd_ >= 0) ::close(fd_);
+			}
+
+			int get() const noexcept { return fd_; }
+		};
+
+		// Reads chunk k of the file into slot k % slots_ of one buffer. The
+		// consumer holds the slot of the chunk made current by advance(), and
+		// the other depth slots are being filled.
+		class __file_chunk_reader {
+			static constexpr long pending = LONG_MIN;
+
+			__file_descriptor fd_;
+			std::size_t chunk_size_;
+			std::size_t slots_;
+			std::size_t size_ = 0;
+			std::size_t chunks_ = 0;
+			std::unique_ptr<std::byte[]> buffer_;
+			// Per slot: bytes read, -errno, or pending.
+			std::vector<long> result_;
+			std::size_t consumed_ = 0;
+			ext::span<const std::byte> current_;
+
+			std::unique_ptr<__uring> uring_;
+			std::vector<iovec> iov_;
+			std::size_t issued_ = 0;
+			std::size_t in_flight_ = 0;
+
+			std::thread thread_;
+			std::mutex mutex_;
+			std::condition_variable cv_;
+			bool stop_ = false;
+
+			std::byte* slot_data(std::size_t k) const noexcept {
+				return buffer_.get() + (k % slots_) * chunk_size_;
+			}
+			std::size_t chunk_length(std::size_t k) const noexcept {
+				const auto off = k * chunk_size_;
+				return size_ - off < chunk_size_ ? size_ - off : chunk_size_;
+			}
+			// Chunks below this bound may be read without clobbering the
+			// chunk the consumer holds.
+			std::size_t read_bound() const noexcept {
+				const auto bound = consumed_ + slots_ - 1;
+				return bound < chunks_ ? bound : chunks_;
+			}
+
+			void reader_thread() noexcept {
+				for (std::size_t k = 0; k < chunks_; ++k) {
+					{
+						std::unique_lock lock{mutex_};
+						cv_.wait(lock, [&] { return stop_ || k < read_bound(); });
+						if (stop_) return;
+					}
+					const auto r = __pread_full(fd_.get(), slot_data(k), chunk_length(k),
+						static_cast<off_t>(k * chunk_size_));
+					{
+						std::lock_guard lock{mutex_};
+						result_[k % slots_] = r;
+					}
+					cv_.notify_all();
+				}
+			}
+
+			void reap(bool wait) {
+				uring_->reap([this](std::uint64_t k, int res) {
+					result_[k % slots_] = res;
+					--in_flight_;
+				}, wait);
+			}
+
+			long wait_uring(std::size_t k) {
+				++consumed_;
+				const auto bound = read_bound();
+				for (; issued_ < bound; ++issued_) {
+					const auto slot = issued_ % slots_;
+					result_[slot] = pending;
+					iov_[slot] = {slot_data(issued_), chunk_length(issued_)};
+					uring_->push_read(fd_.get(), &iov_[slot],
+						static_cast<off_t>(issued_ * chunk_size_), issued_);
+					++in_flight_;
+				}
+				uring_->submit();
+				while (result_[k % slots_] == pending) {
+					reap(true);
+				}
+				return result_[k % slots_];
+			}
+
+			long wait_thread(std::size_t k) {
+				std::unique_lock lock{mutex_};
+				++consumed_;
+				cv_.notify_all(); // read_bound() has grown
+				cv_.wait(lock, [&] { return result_[k % slots_] != pending; });
+				return std::exchange(result_[k % slots_], pending);
+			}
+		public:
+			__file_chunk_reader(const std::filesystem::path& path, std::size_t chunk_size,
+				unsigned depth, ext::file_chunks_backend backend)
+			: chunk_size_{chunk_size}, slots_{std::size_t{depth} + 1}
+			{
+				STL2_EXPECT(chunk_size > 0);
+				STL2_EXPECT(depth > 0);
+				if (slots_ > SIZE_MAX / chunk_size) {
+					__throw_errno(EOVERFLOW, "file_chunks: chunk_size * (depth + 1)");
+				}
+				// fd_ is closed by its own destructor should anything below throw.
+				fd_ = __file_descriptor{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+				if (fd_.get() < 0) __throw_errno(errno, "open");
+				struct ::stat st;
+				if (::fstat(fd_.get(), &st) != 0) __throw_errno(errno, "fstat");
+				size_ = static_cast<std::size_t>(st.st_size);
+				chunks_ = (size_ + chunk_size - 1) / chunk_size;
+				buffer_.reset(new std::byte[slots_ * chunk_size]);
+				result_.assign(slots_, pending);
+				::posix_fadvise(fd_.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+
+				if (backend == ext::file_chunks_backend::automatic) {
+					// The first advance() issues reads into every slot.
+					uring_ = std::make_unique<__uring>();
+					if (uring_->setup(static_cast<unsigned>(slots_))) {
+						iov_.resize(slots_);
+						return;
+					}
+					uring_.reset();
+				}
+				thread_ = std::thread{[this] { reader_thread(); }};
+			}
+
+			__file_chunk_reader(const __file_chunk_reader&) = delete;
+			__file_chunk_reader& operator=(const __file_chunk_reader&) = delete;
+
+			~__file_chunk_reader() {
+				if (uring_) {
+					// The kernel may still be writing into the buffer.
+					try {
+						while (in_flight_ != 0) {
+							reap(true);
+						}
+					} catch (...) {
+						// There is no telling when the reads finish: leak the
+						// buffer rather than have them write to freed memory.
+						(void) buffer_.release();
+					}
+				} else if (thread_.joinable()) {
+					{
+						std::lock_guard lock{mutex_};
+						stop_ = true;
+					}
+					cv_.notify_all();
+					thread_.join();
+				}
+			}
+
+			bool uses_io_uring() const noexcept { return uring_ != nullptr; }
+
+			ext::span<const std::byte> current() const noexcept { return current_; }
+
+			// Releases the current chunk and waits for the next, which is
+			// empty past the end of the file.
+			void advance() {
+				if (consumed_ == chunks_) {
+					current_ = {};
+					return;
+				}
+				const auto k = consumed_;
+				auto r = uring_ ? wait_uring(k) : wait_thread(k);
+				if (r < 0) __throw_errno(static_cast<int>(-r), "read");
+				const auto len = chunk_length(k);
+				if (static_cast<std::size_t>(r) < len) {
+					// A short read: finish it here.
+					const auto rest = __pread_full(fd_.get(), slot_data(k) + r,
+						len - static_cast<std::size_t>(r),
+						static_cast<off_t>(k * chunk_size_) + r);
+					if (rest < 0) __throw_errno(static_cast<int>(-rest), "pread");
+					r += rest;
+				}
+				current_ = {slot_data(k), static_cast<std::ptrdiff_t>(r)};
+			}
+		};
+	} // namespace detail
+
+	namespace ext {
+		class file_chunks_view : public view_interface<file_chunks_view> {
+		private:
+			class __iterator;
+
+			std::shared_ptr<detail::__file_chunk_reader> reader_;
+		public:
+			file_chunks_view() = default;
+			file_chunks_view(const std::filesystem::path& path, std::size_t chunk_size,
+				unsigned depth = 2, file_chunks_backend backend = {})
+			: reader_{std::make_shared<detail::__file_chunk_reader>(
+				path, chunk_size, depth, backend)} {}
+
+			__iterator begin();
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+
+			bool uses_io_uring() const noexcept {
+				STL2_EXPECT(reader_);
+				return reader_->uses_io_uring();
+			}
+		};
+
+		class file_chunks_view::__iterator {
+		private:
+			detail::raw_ptr<detail::__file_chunk_reader> reader_ = nullptr;
+
+			bool at_end() const noexcept { return reader_->current().empty(); }
+		public:
+			using iterator_category = input_iterator_tag;
+			using difference_type = std::ptrdiff_t;
+			using value_type = span<const std::byte>;
+
+			__iterator() = default;
+			explicit __iterator(detail::__file_chunk_reader& reader) noexcept
+			: reader_{std::addressof(reader)} {}
+
+			span<const std::byte> operator*() const noexcept
+			{ return reader_->current(); }
+
+			__iterator& operator++() {
+				reader_->advance();
+				return *this;
+			}
+			void operator++(int) { ++*this; }
+
+			friend bool operator==(const __iterator& x, default_sentinel_t) noexcept
+			{ return x.at_end(); }
+			friend bool operator==(default_sentinel_t, const __iterator& x) noexcept
+			{ return x.at_end(); }
+			friend bool operator!=(const __iterator& x, default_sentinel_t) noexcept
+			{ return !x.at_end(); }
+			friend bool operator!=(default_sentinel_t, const __iterator& x) noexcept
+			{ return !x.at_end(); }
+		};
+
+		inline file_chunks_view::__iterator file_chunks_view::begin() {
+			STL2_EXPECT(reader_);
+			reader_->advance(); // prime the pump
+			return __iterator{*reader_};
+		}
+	} // namespace ext
+
+	namespace views::ext {
+		struct __file_chunks_fn {
+			auto operator()(const std::filesystem::path& path, std::size_t chunk_size,
+				unsigned depth = 2, __stl2::ext::file_chunks_backend backend = {}) const
+			{ return __stl2::ext::file_chunks_view{path, chunk_size, depth, backend}; }
+		};
+
+		inline constexpr __file_chunks_fn file_chunks{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+#endif // __linux__
+
+#endif
@@ -33,7 +33,7 @@ STL2_OPEN_NAMESPACE {
 		class __sentinel;
 
 		V base_;
-		detail::semiregular_box<Pred> pred_;
+		STL2_NO_UNIQUE_ADDRESS detail::semiregular_box<Pred> pred_;
 		detail::cached_position<V> begin_;
 
 	public:
@@ -67,9 +67,43 @@ STL2_OPEN_NAMESPACE {
 	requires view<V>
 	class filter_view<V, Pred>::__iterator {
 	private:
+		// With a stateless Pred and a sentinel no larger than a pointer, the
+		// iterator holds copies of both instead of a pointer to the parent.
+		struct __pred_and_end {
+			STL2_NO_UNIQUE_ADDRESS mutable detail::semiregular_box<Pred> pred_;
+			STL2_NO_UNIQUE_ADDRESS sentinel_t<V> end_;
+		};
+		static constexpr bool __stores_pred = std::is_empty_v<Pred> &&
+			sizeof(sentinel_t<V>) <= sizeof(filter_view*);
+		using __state = meta::if_c<__stores_pred, __pred_and_end, filter_view*>;
+
 		iterator_t<V> current_{};
-		filter_view* parent_ = nullptr;
+		STL2_NO_UNIQUE_ADDRESS __state state_{};
 		friend __sentinel;
+
+		static constexpr __state __get_state(filter_view& parent) {
+			if constexpr (__stores_pred) {
+				return {parent.pred_, __stl2::end(parent.base_)};
+			} else {
+				return &parent;
+			}
+		}
+
+		constexpr Pred& pred() const noexcept {
+			if constexpr (__stores_pred) {
+				return state_.pred_.get();
+			} else {
+				return state_->pred_.get();
+			}
+		}
+
+		constexpr sentinel_t<V> last() const {
+			if constexpr (__stores_pred) {
+				return state_.end_;
+			} else {
+				return __stl2::end(state_->base_);
+			}
+		}
 	public:
 		using iterator_category =
 			meta::if_c<bidirectional_iterator<iterator_t<V>>,
@@ -83,7 +117,7 @@ STL2_OPEN_NAMESPACE {
 		__iterator() = default;
 
 		constexpr __iterator(filter_view& parent, iterator_t<V> current)
-		: current_(current), parent_(&parent) {}
+		: current_(current), state_(__get_state(parent)) {}
 
 		constexpr iterator_t<V> base() const
 		{ return current_; }
@@ -102,9 +136,9 @@ STL2_OPEN_NAMESPACE {
 
 		constexpr __iterator& operator++()
 		{
-			const auto last = __stl2::end(parent_->base_);
+			const auto last = this->last();
 			STL2_ASSERT(current_ != last);
-			current_ = find_if(++current_, last, __stl2::ref(parent_->pred_.get()));
+			current_ = find_if(++current_, last, __stl2::ref(pred()));
 			return *this;
 		}
 
@@ -122,7 +156,7 @@ STL2_OPEN_NAMESPACE {
 		{
 			do
 				--current_;
-			while(!__stl2::invoke(parent_->pred_.get(), *current_));
+			while(!__stl2::invoke(pred(), *current_));
 			return *this;
 		}
 
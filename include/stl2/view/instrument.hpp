@@ -0,0 +1,332 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_INSTRUMENT_HPP
+#define STL2_VIEW_INSTRUMENT_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/meta.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// instrument_view [Extension]
+//
+// views::ext::instrument(tag) passes the elements of the underlying range
+// through unchanged, with the same iterator category, while counting the
+// operations algorithms perform on its iterators: increments, decrements,
+// dereferences (including subscripts and iter_move), comparisons (with
+// other iterators and with the sentinel), advances by += and -=, and
+// calls to begin(). The counts accumulate in ext::instrument_counts<Tag>(),
+// where Tag is the type of tag; each thread has its own counters.
+//
+// Unless STL2_INSTRUMENT_VIEWS is nonzero, instrument(tag) is all() and
+// its result is a ref_view of an lvalue argument, so that instrumented
+// pipelines cost nothing in builds that do not look at the counts.
+//
+#ifndef STL2_INSTRUMENT_VIEWS
+#define STL2_INSTRUMENT_VIEWS 0
+#endif
+
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		struct instrument_counters {
+			std::size_t begins = 0;
+			std::size_t increments = 0;
+			std::size_t decrements = 0;
+			std::size_t dereferences = 0;
+			std::size_t comparisons = 0;
+			std::size_t advances = 0;
+
+			constexpr void reset() noexcept { *this = instrument_counters{}; }
+		};
+
+		template<class Tag>
+		instrument_counters& instrument_counts() noexcept {
+			static thread_local instrument_counters counters;
+			return counters;
+		}
+	} // namespace ext
+
+	namespace detail {
+		template<class Tag>
+		void __instrument_count(std::size_t ext::instrument_counters::* which) noexcept {
+			++(ext::instrument_counts<Tag>().*which);
+		}
+	} // namespace detail
+
+	namespace ext {
+		template<view V, class Tag>
+		class instrument_view : public view_interface<instrument_view<V, Tag>> {
+		private:
+			template<bool> class __iterator;
+			template<bool> class __sentinel;
+
+			V base_ = V();
+		public:
+			instrument_view() = default;
+
+			constexpr explicit instrument_view(V base)
+			noexcept(std::is_nothrow_move_constructible_v<V>)
+			: base_(std::move(base)) {}
+
+			constexpr V base() const { return base_; }
+
+			__iterator<false> begin() {
+				detail::__instrument_count<Tag>(&instrument_counters::begins);
+				return __iterator<false>{__stl2::begin(base_)};
+			}
+
+			template<class ConstV = const V>
+			__iterator<true> begin() const requires range<ConstV> {
+				detail::__instrument_count<Tag>(&instrument_counters::begins);
+				return __iterator<true>{__stl2::begin(base_)};
+			}
+
+			constexpr auto end() {
+				if constexpr (common_range<V>) {
+					return __iterator<false>{__stl2::end(base_)};
+				} else {
+					return __sentinel<false>{__stl2::end(base_)};
+				}
+			}
+
+			template<class ConstV = const V>
+			constexpr auto end() const requires range<ConstV> {
+				if constexpr (common_range<ConstV>) {
+					return __iterator<true>{__stl2::end(base_)};
+				} else {
+					return __sentinel<true>{__stl2::end(base_)};
+				}
+			}
+
+			constexpr auto size() requires sized_range<V>
+			{ return __stl2::size(base_); }
+
+			constexpr auto size() const requires sized_range<const V>
+			{ return __stl2::size(base_); }
+		};
+
+		template<view V, class Tag>
+		template<bool Const>
+		class instrument_view<V, Tag>::__iterator {
+		private:
+			using Base = __maybe_const<Const, V>;
+			using I = iterator_t<Base>;
+
+			I current_{};
+			friend __iterator<!Const>;
+			friend __sentinel<Const>;
+		public:
+			using iterator_category = iterator_category_t<I>;
+			using value_type = iter_value_t<I>;
+			using difference_type = iter_difference_t<I>;
+
+			__iterator() = default;
+
+			constexpr explicit __iterator(I current)
+			: current_(std::move(current)) {}
+
+			constexpr __iterator(__iterator<!Const> i)
+			requires Const && convertible_to<iterator_t<V>, I>
+			: current_(std::move(i.current_)) {}
+
+			constexpr I base() const { return current_; }
+
+			decltype(auto) operator*() const {
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				return *current_;
+			}
+
+			decltype(auto) operator->() const
+			requires std::is_pointer_v<I> || requires(const I& i) { i.operator->(); }
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				if constexpr (std::is_pointer_v<I>) {
+					return current_;
+				} else {
+					return current_.operator->();
+				}
+			}
+
+			__iterator& operator++() {
+				detail::__instrument_count<Tag>(&instrument_counters::increments);
+				++current_;
+				return *this;
+			}
+			void operator++(int) { ++*this; }
+			__iterator operator++(int) requires forward_range<Base> {
+				auto tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			__iterator& operator--() requires bidirectional_range<Base> {
+				detail::__instrument_count<Tag>(&instrument_counters::decrements);
+				--current_;
+				return *this;
+			}
+			__iterator operator--(int) requires bidirectional_range<Base> {
+				auto tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			__iterator& operator+=(difference_type n) requires random_access_range<Base> {
+				detail::__instrument_count<Tag>(&instrument_counters::advances);
+				current_ += n;
+				return *this;
+			}
+			__iterator& operator-=(difference_type n) requires random_access_range<Base> {
+				detail::__instrument_count<Tag>(&instrument_counters::advances);
+				current_ -= n;
+				return *this;
+			}
+			decltype(auto) operator[](difference_type n) const
+			requires random_access_range<Base>
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				return current_[n];
+			}
+
+			friend bool operator==(const __iterator& x, const __iterator& y)
+			requires equality_comparable<I>
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::comparisons);
+				return x.current_ == y.current_;
+			}
+			friend bool operator!=(const __iterator& x, const __iterator& y)
+			requires equality_comparable<I>
+			{ return !(x == y); }
+
+			friend bool operator<(const __iterator& x, const __iterator& y)
+			requires random_access_range<Base>
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::comparisons);
+				return x.current_ < y.current_;
+			}
+			friend bool operator>(const __iterator& x, const __iterator& y)
+			requires random_access_range<Base>
+			{ return y < x; }
+			friend bool operator<=(const __iterator& x, const __iterator& y)
+			requires random_access_range<Base>
+			{ return !(y < x); }
+			friend bool operator>=(const __iterator& x, const __iterator& y)
+			requires random_access_range<Base>
+			{ return !(x < y); }
+
+			friend __iterator operator+(__iterator i, difference_type n)
+			requires random_access_range<Base>
+			{ return i += n; }
+			friend __iterator operator+(difference_type n, __iterator i)
+			requires random_access_range<Base>
+			{ return i += n; }
+			friend __iterator operator-(__iterator i, difference_type n)
+			requires random_access_range<Base>
+			{ return i -= n; }
+			friend constexpr difference_type operator-(const __iterator& x, const __iterator& y)
+			requires sized_sentinel_for<I, I>
+			{ return x.current_ - y.current_; }
+
+			friend decltype(auto) iter_move(const __iterator& i)
+			noexcept(noexcept(__stl2::iter_move(i.current_)))
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				return __stl2::iter_move(i.current_);
+			}
+
+			friend void iter_swap(const __iterator& x, const __iterator& y)
+			noexcept(noexcept(__stl2::iter_swap(x.current_, y.current_)))
+			requires indirectly_swappable<I>
+			{
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				detail::__instrument_count<Tag>(&instrument_counters::dereferences);
+				__stl2::iter_swap(x.current_, y.current_);
+			}
+		};
+
+		template<view V, class Tag>
+		template<bool Const>
+		class instrument_view<V, Tag>::__sentinel {
+		private:
+			using Base = __maybe_const<Const, V>;
+
+			sentinel_t<Base> end_{};
+			friend __sentinel<!Const>;
+
+			bool equal(const __iterator<Const>& i) const {
+				detail::__instrument_count<Tag>(&instrument_counters::comparisons);
+				return i.current_ == end_;
+			}
+		public:
+			__sentinel() = default;
+
+			constexpr explicit __sentinel(sentinel_t<Base> end)
+			: end_(std::move(end)) {}
+
+			constexpr __sentinel(__sentinel<!Const> s)
+			requires Const && convertible_to<sentinel_t<V>, sentinel_t<Base>>
+			: end_(std::move(s.end_)) {}
+
+			constexpr sentinel_t<Base> base() const { return end_; }
+
+			friend bool operator==(const __iterator<Const>& x, const __sentinel& y)
+			{ return y.equal(x); }
+			friend bool operator==(const __sentinel& x, const __iterator<Const>& y)
+			{ return x.equal(y); }
+			friend bool operator!=(const __iterator<Const>& x, const __sentinel& y)
+			{ return !y.equal(x); }
+			friend bool operator!=(const __sentinel& x, const __iterator<Const>& y)
+			{ return !x.equal(y); }
+
+			friend constexpr iter_difference_t<iterator_t<Base>>
+			operator-(const __iterator<Const>& x, const __sentinel& y)
+			requires sized_sentinel_for<sentinel_t<Base>, iterator_t<Base>>
+			{ return x.current_ - y.end_; }
+
+			friend constexpr iter_difference_t<iterator_t<Base>>
+			operator-(const __sentinel& y, const __iterator<Const>& x)
+			requires sized_sentinel_for<sentinel_t<Base>, iterator_t<Base>>
+			{ return y.end_ - x.current_; }
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		struct __instrument_fn : detail::__pipeable<__instrument_fn> {
+			template<viewable_range R, class Tag>
+			constexpr auto operator()(R&& r, Tag) const {
+#if STL2_INSTRUMENT_VIEWS
+				using V = all_view<R>;
+				return __stl2::ext::instrument_view<V, __uncvref<Tag>>{
+					all(std::forward<R>(r))};
+#else
+				return all(std::forward<R>(r));
+#endif
+			}
+
+			template<class Tag>
+			requires (!range<Tag>)
+			constexpr auto operator()(Tag tag) const {
+				return detail::view_closure(*this, std::move(tag));
+			}
+		};
+
+		inline constexpr __instrument_fn instrument{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
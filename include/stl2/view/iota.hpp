@@ -70,7 +70,7 @@ STL2_OPEN_NAMESPACE {
 		struct __sentinel;
 
 		I value_{};
-		Bound bound_{};
+		STL2_NO_UNIQUE_ADDRESS Bound bound_{};
 	public:
 		iota_view() = default;
 		/// \pre: `Bound{}` is reachable from `value`
@@ -217,7 +217,7 @@ STL2_OPEN_NAMESPACE {
 			return i.value_ == bound_;
 		}
 
-		Bound bound_;
+		STL2_NO_UNIQUE_ADDRESS Bound bound_;
 	};
 
 	namespace views {
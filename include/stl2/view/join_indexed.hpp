@@ -0,0 +1,251 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_JOIN_INDEXED_HPP
+#define STL2_VIEW_JOIN_INDEXED_HPP
+
+#include <memory>
+#include <vector>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// join_indexed_view [Extension]
+//
+// Flattens a sized random-access range of lvalue sized random-access ranges
+// into a single random-access range. On construction the view records the
+// prefix sums of the inner sizes; the offsets give O(1) size() and
+// distance, and O(log k) random jumps (k inner ranges) by binary search.
+// Increment and decrement only consult the offsets at segment boundaries.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class R>
+		META_CONCEPT _IndexableJoin = random_access_range<R> && sized_range<R> &&
+			std::is_reference_v<range_reference_t<R>> &&
+			random_access_range<range_reference_t<R>> &&
+			sized_range<range_reference_t<R>>;
+	}
+
+	namespace ext {
+		template<view V>
+		requires detail::_IndexableJoin<V>
+		class join_indexed_view : public view_interface<join_indexed_view<V>> {
+		private:
+			using D = range_difference_t<range_reference_t<V>>;
+			template<bool Const> class __iterator;
+
+			V base_ = V();
+			// offsets_[i] is the position of the first element of the i-th
+			// inner range; offsets_.back() is the total size.
+			std::shared_ptr<const std::vector<D>> offsets_;
+
+			static std::shared_ptr<const std::vector<D>> make_offsets(V& base) {
+				auto offsets = std::make_shared<std::vector<D>>();
+				offsets->reserve(static_cast<std::size_t>(__stl2::size(base)) + 1);
+				D n = 0;
+				offsets->push_back(n);
+				for (auto&& inner : base) {
+					n += static_cast<D>(__stl2::size(inner));
+					offsets->push_back(n);
+				}
+				return offsets;
+			}
+			// Shared by default-constructed views, which are empty.
+			static std::shared_ptr<const std::vector<D>> empty_offsets() {
+				static const auto offsets = std::make_shared<const std::vector<D>>(1, D(0));
+				return offsets;
+			}
+		public:
+			join_indexed_view() : offsets_(empty_offsets()) {}
+			explicit join_indexed_view(V base)
+			: base_(std::move(base)), offsets_(make_offsets(base_)) {}
+
+			V base() const { return base_; }
+
+			auto begin() {
+				STL2_EXPECT(offsets_);
+				return __iterator<ext::simple_view<V>>{*this, 0};
+			}
+			auto begin() const requires detail::_IndexableJoin<const V> {
+				STL2_EXPECT(offsets_);
+				return __iterator<true>{*this, 0};
+			}
+
+			auto end() {
+				STL2_EXPECT(offsets_);
+				return __iterator<ext::simple_view<V>>{*this, offsets_->back()};
+			}
+			auto end() const requires detail::_IndexableJoin<const V> {
+				STL2_EXPECT(offsets_);
+				return __iterator<true>{*this, offsets_->back()};
+			}
+
+			auto size() const {
+				STL2_EXPECT(offsets_);
+				return static_cast<std::make_unsigned_t<D>>(offsets_->back());
+			}
+		};
+
+		template<view V>
+		requires detail::_IndexableJoin<V>
+		template<bool Const>
+		class join_indexed_view<V>::__iterator {
+		private:
+			using Base = __maybe_const<Const, V>;
+			using Inner = range_reference_t<Base>;
+
+			iterator_t<Base> outer_{};
+			detail::raw_ptr<const std::vector<D>> offsets_ = nullptr;
+			D pos_ = 0;
+			// The inner range containing pos_, or the count of inner ranges
+			// when pos_ is the end.
+			D seg_ = 0;
+			iterator_t<Inner> inner_{};
+
+			D segments_() const noexcept
+			{ return static_cast<D>(offsets_->size()) - 1; }
+			D offset_(D seg) const noexcept
+			{ return (*offsets_)[static_cast<std::size_t>(seg)]; }
+
+			// Positions inner_ at pos_ given that seg_ is already correct.
+			void settle_() {
+				if (seg_ < segments_()) {
+					inner_ = __stl2::begin(outer_[seg_]) + (pos_ - offset_(seg_));
+				}
+			}
+			void seek_(D pos) {
+				auto first = offsets_->begin();
+				pos_ = pos;
+				seg_ = static_cast<D>(__stl2::upper_bound(first + 1, offsets_->end(), pos) - first) - 1;
+				settle_();
+			}
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = range_value_t<Inner>;
+			using difference_type = D;
+
+			__iterator() = default;
+			__iterator(__maybe_const<Const, join_indexed_view>& parent, D pos)
+			: outer_{__stl2::begin(parent.base_)}, offsets_{parent.offsets_.get()} {
+				seek_(pos);
+			}
+			__iterator(__iterator<!Const> i)
+			requires Const && convertible_to<iterator_t<V>, iterator_t<Base>> &&
+				convertible_to<iterator_t<range_reference_t<V>>, iterator_t<Inner>>
+			: outer_{std::move(i.outer_)}, offsets_{i.offsets_}, pos_{i.pos_}
+			, seg_{i.seg_}, inner_{std::move(i.inner_)} {}
+
+			// The index of the inner range containing the current element.
+			D segment() const noexcept { return seg_; }
+
+			decltype(auto) operator*() const { return *inner_; }
+			decltype(auto) operator[](D n) const { return *(*this + n); }
+
+			__iterator& operator++() {
+				++pos_;
+				if (pos_ < offset_(seg_ + 1)) {
+					++inner_;
+				} else {
+					do ++seg_; while (seg_ < segments_() && offset_(seg_ + 1) == pos_);
+					settle_();
+				}
+				return *this;
+			}
+			__iterator operator++(int) {
+				auto tmp = *this;
+				++*this;
+				return tmp;
+			}
+
+			__iterator& operator--() {
+				--pos_;
+				if (seg_ < segments_() && offset_(seg_) <= pos_) {
+					--inner_;
+				} else {
+					do --seg_; while (offset_(seg_) > pos_);
+					settle_();
+				}
+				return *this;
+			}
+			__iterator operator--(int) {
+				auto tmp = *this;
+				--*this;
+				return tmp;
+			}
+
+			__iterator& operator+=(D n) {
+				const D pos = pos_ + n;
+				if (seg_ < segments_() && offset_(seg_) <= pos && pos < offset_(seg_ + 1)) {
+					pos_ = pos;
+					inner_ += n;
+				} else {
+					seek_(pos);
+				}
+				return *this;
+			}
+			__iterator& operator-=(D n) { return *this += -n; }
+
+			friend __iterator operator+(__iterator i, D n) { return i += n; }
+			friend __iterator operator+(D n, __iterator i) { return i += n; }
+			friend __iterator operator-(__iterator i, D n) { return i -= n; }
+			friend D operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return x.pos_ - y.pos_; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.pos_ == y.pos_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.pos_ < y.pos_; }
+			friend bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+
+			friend decltype(auto) iter_move(const __iterator& i)
+			noexcept(noexcept(__stl2::iter_move(i.inner_)))
+			{ return __stl2::iter_move(i.inner_); }
+
+			friend void iter_swap(const __iterator& x, const __iterator& y)
+			noexcept(noexcept(__stl2::iter_swap(x.inner_, y.inner_)))
+			requires indirectly_swappable<iterator_t<Inner>>
+			{ __stl2::iter_swap(x.inner_, y.inner_); }
+
+			friend __iterator<!Const>;
+		};
+
+		template<class R>
+		explicit join_indexed_view(R&&) -> join_indexed_view<all_view<R>>;
+	} // namespace ext
+
+	namespace views::ext {
+		struct __join_indexed_fn : detail::__pipeable<__join_indexed_fn> {
+			template<class R>
+			constexpr auto operator()(R&& rng) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::join_indexed_view{all(std::forward<R>(rng))}
+			)
+		};
+
+		inline constexpr __join_indexed_fn join_indexed{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,185 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_RANDOM_PERMUTATION_HPP
+#define STL2_VIEW_RANDOM_PERMUTATION_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/concepts/object.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// random_permutation_view [Extension]
+//
+// A random-access view of a pseudo-random permutation of [0, n), computed
+// element by element in constant space. The permutation is a four-round
+// Feistel network keyed by the seed over the smallest domain of 4^h >= n
+// values; an image outside [0, n) is permuted again ("cycle walking")
+// until it falls inside, which takes fewer than four rounds on average.
+// Equal n and seed always give the same permutation.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		class __feistel_permutation {
+		public:
+			__feistel_permutation() = default;
+			constexpr __feistel_permutation(std::uint64_t n, std::uint64_t seed) noexcept
+			: n_{n} {
+				const int bits = n > 1 ? static_cast<int>(std::bit_width(n - 1)) : 0;
+				half_bits_ = (bits + 1) / 2;
+				half_mask_ = (std::uint64_t{1} << half_bits_) - 1;
+				for (auto& key : keys_) {
+					key = __splitmix64(seed);
+				}
+			}
+
+			constexpr std::uint64_t size() const noexcept { return n_; }
+
+			// The image of i < size().
+			constexpr std::uint64_t operator()(std::uint64_t i) const noexcept {
+				STL2_EXPECT(i < n_);
+				do {
+					i = encrypt(i);
+				} while (i >= n_);
+				return i;
+			}
+
+		private:
+			static constexpr int rounds = 4;
+
+			std::uint64_t n_ = 0;
+			int half_bits_ = 0;
+			std::uint64_t half_mask_ = 0;
+			std::uint64_t keys_[rounds] = {};
+
+			static constexpr std::uint64_t __splitmix64(std::uint64_t& state) noexcept {
+				auto z = (state += 0x9e3779b97f4a7c15u);
+				z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9u;
+				z = (z ^ (z >> 27)) * 0x94d049bb133111ebu;
+				return z ^ (z >> 31);
+			}
+
+			constexpr std::uint64_t round(std::uint64_t x, std::uint64_t key) const noexcept {
+				x = (x ^ key) * 0xbf58476d1ce4e5b9u;
+				x ^= x >> 31;
+				x *= 0x94d049bb133111ebu;
+				return (x ^ (x >> 29)) & half_mask_;
+			}
+
+			constexpr std::uint64_t encrypt(std::uint64_t i) const noexcept {
+				auto left = i >> half_bits_;
+				auto right = i & half_mask_;
+				for (auto key : keys_) {
+					const auto next = left ^ round(right, key);
+					left = right;
+					right = next;
+				}
+				return (left << half_bits_) | right;
+			}
+		};
+	} // namespace detail
+
+	namespace ext {
+		template<integral I>
+		class random_permutation_view
+		: public view_interface<random_permutation_view<I>> {
+		private:
+			class __iterator;
+
+			detail::__feistel_permutation perm_;
+		public:
+			random_permutation_view() = default;
+			constexpr random_permutation_view(I n, std::uint64_t seed) noexcept
+			: perm_{static_cast<std::uint64_t>(n), seed} {
+				if constexpr (std::is_signed_v<I>) {
+					STL2_EXPECT(n >= 0);
+				}
+			}
+
+			constexpr __iterator begin() const noexcept { return {perm_, 0}; }
+			constexpr __iterator end() const noexcept
+			{ return {perm_, static_cast<std::ptrdiff_t>(perm_.size())}; }
+			constexpr I size() const noexcept { return static_cast<I>(perm_.size()); }
+		};
+
+		template<integral I>
+		class random_permutation_view<I>::__iterator {
+		private:
+			const detail::__feistel_permutation* perm_ = nullptr;
+			std::ptrdiff_t i_ = 0;
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = I;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			constexpr __iterator(const detail::__feistel_permutation& perm,
+				std::ptrdiff_t i) noexcept
+			: perm_{&perm}, i_{i} {}
+
+			constexpr I operator*() const noexcept
+			{ return static_cast<I>((*perm_)(static_cast<std::uint64_t>(i_))); }
+			constexpr I operator[](difference_type n) const noexcept
+			{ return *(*this + n); }
+
+			constexpr __iterator& operator++() noexcept { ++i_; return *this; }
+			constexpr __iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+			constexpr __iterator& operator--() noexcept { --i_; return *this; }
+			constexpr __iterator operator--(int) noexcept
+			{ auto tmp = *this; --*this; return tmp; }
+			constexpr __iterator& operator+=(difference_type n) noexcept
+			{ i_ += n; return *this; }
+			constexpr __iterator& operator-=(difference_type n) noexcept
+			{ i_ -= n; return *this; }
+
+			friend constexpr __iterator operator+(__iterator i, difference_type n) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator+(difference_type n, __iterator i) noexcept
+			{ return i += n; }
+			friend constexpr __iterator operator-(__iterator i, difference_type n) noexcept
+			{ return i -= n; }
+			friend constexpr difference_type
+			operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ - y.i_; }
+
+			friend constexpr bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ == y.i_; }
+			friend constexpr bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend constexpr bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ < y.i_; }
+			friend constexpr bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend constexpr bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend constexpr bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		struct __random_permutation_fn {
+			template<integral I>
+			constexpr auto operator()(I n, std::uint64_t seed) const noexcept {
+				return __stl2::ext::random_permutation_view<I>{n, seed};
+			}
+		};
+
+		inline constexpr __random_permutation_fn random_permutation{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
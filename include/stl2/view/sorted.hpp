@@ -0,0 +1,258 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_SORTED_HPP
+#define STL2_VIEW_SORTED_HPP
+
+#include <bit>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <stl2/functional.hpp>
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/raw_ptr.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/all.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// sorted_view [Extension]
+//
+// Presents the elements of a random-access range in sorted order, sorting
+// the underlying range in place only as far as it is read. Reading the
+// element at position k completes the sorted prefix [0, k] by incremental
+// quicksort: the unsorted remainder is kept as a stack of segment
+// boundaries, and only the leftmost segment is ever partitioned. The first
+// k elements then cost O(n + k log k) on average, and a full traversal
+// amounts to one quicksort. As in introsort, a segment partitioned more
+// than 2 log2 n times over is finished by sort instead, so adversarial
+// input degrades to a normal O(n log n) sort rather than O(n^2).
+//
+// Partitioning is three-way, so runs of equivalent elements are placed in
+// one pass. Copies of a sorted_view share its progress. Reading elements
+// through begin() or an iterator sorts the underlying range as a side
+// effect, even through a const view, so a sorted_view and its copies must
+// not be read from more than one thread at a time.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		template<random_access_range V, class Comp, class Proj>
+		requires view<V> && sized_range<V> && sortable<iterator_t<V>, Comp, Proj>
+		class sorted_view : public view_interface<sorted_view<V, Comp, Proj>> {
+		private:
+			using I = iterator_t<V>;
+			using D = iter_difference_t<I>;
+
+			// Segments at most this long are finished by sort instead of
+			// being partitioned further.
+			static constexpr D small_segment = 16;
+
+			// The end of an unsorted segment, and how many times the
+			// segment has been partitioned.
+			struct __bound {
+				D end_;
+				int depth_;
+			};
+
+			struct __state {
+				V base_;
+				Comp comp_;
+				Proj proj_;
+				// Initialized after base_ has reached its final place, since
+				// the iterators of some views point into the view itself.
+				I first_ = __stl2::begin(base_);
+				D size_ = static_cast<D>(__stl2::distance(base_));
+				D sorted_ = 0;
+				int depth_limit_ = 2 * static_cast<int>(std::bit_width(
+					static_cast<std::make_unsigned_t<D>>(size_)));
+				// Each element of [sorted_, b) is ordered before or equivalent
+				// to each element of [b, size_) for every b in bounds_.
+				std::vector<__bound> bounds_{__bound{size_, 0}};
+
+				__state(V base, Comp comp, Proj proj)
+				: base_(std::move(base)), comp_(std::move(comp)), proj_(std::move(proj)) {}
+
+				bool less_(I x, I y) {
+					return __stl2::invoke(comp_,
+						__stl2::invoke(proj_, *x), __stl2::invoke(proj_, *y));
+				}
+
+				// Moves the median of *a, *b, *c into *a.
+				void median_to_front_(I a, I b, I c) {
+					if (less_(b, a)) {
+						if (less_(c, b)) __stl2::iter_swap(a, b); // c < b < a
+						else if (less_(c, a)) __stl2::iter_swap(a, c); // b <= c < a
+					} else if (!less_(c, a)) {
+						if (less_(c, b)) __stl2::iter_swap(a, c); // a <= c < b
+						else __stl2::iter_swap(a, b); // a <= b <= c
+					}
+				}
+
+				// Ensures [0, k) holds the k least elements in order.
+				void sort_to(D k) {
+					while (sorted_ < k) {
+						const auto [b, depth] = bounds_.back();
+						if (b == sorted_) {
+							bounds_.pop_back();
+							continue;
+						}
+						const auto lo = first_ + sorted_;
+						const auto hi = first_ + b;
+						if (b - sorted_ <= small_segment || depth >= depth_limit_) {
+							__stl2::sort(lo, hi, __stl2::ref(comp_), __stl2::ref(proj_));
+							sorted_ = b;
+							bounds_.pop_back();
+							continue;
+						}
+
+						// Three-way partition around the median of three, which
+						// is parked at *lo: [lo, lt) < pivot, [lt, gt) equivalent,
+						// [gt, hi) > pivot.
+						median_to_front_(lo, lo + (b - sorted_) / 2, hi - 1);
+						auto lt = lo + 1;
+						auto gt = hi;
+						for (auto i = lt; i < gt;) {
+							if (less_(i, lo)) {
+								__stl2::iter_swap(lt, i);
+								++lt;
+								++i;
+							} else if (less_(lo, i)) {
+								--gt;
+								__stl2::iter_swap(i, gt);
+							} else {
+								++i;
+							}
+						}
+						--lt;
+						__stl2::iter_swap(lo, lt);
+
+						bounds_.back().depth_ = depth + 1;
+						if (lt == lo) {
+							// The equivalent run is in its final place.
+							sorted_ = gt - first_;
+						} else {
+							bounds_.push_back(__bound{static_cast<D>(gt - first_), depth + 1});
+							bounds_.push_back(__bound{static_cast<D>(lt - first_), depth + 1});
+						}
+					}
+				}
+			};
+
+			class __iterator;
+
+			// Null in a default-constructed view, which is empty.
+			std::shared_ptr<__state> state_;
+		public:
+			sorted_view() = default;
+			sorted_view(V base, Comp comp, Proj proj)
+			: state_{std::make_shared<__state>(
+				std::move(base), std::move(comp), std::move(proj))} {}
+
+			V base() const { return state_ ? state_->base_ : V(); }
+
+			__iterator begin() const
+			{ return state_ ? __iterator{*state_, 0} : __iterator{}; }
+			__iterator end() const
+			{ return state_ ? __iterator{*state_, size()} : __iterator{}; }
+			D size() const { return state_ ? state_->size_ : 0; }
+		};
+
+		template<random_access_range V, class Comp, class Proj>
+		requires view<V> && sized_range<V> && sortable<iterator_t<V>, Comp, Proj>
+		class sorted_view<V, Comp, Proj>::__iterator {
+		private:
+			detail::raw_ptr<__state> state_ = nullptr;
+			D n_ = 0;
+		public:
+			using iterator_category = __stl2::random_access_iterator_tag;
+			using value_type = iter_value_t<I>;
+			using difference_type = D;
+
+			__iterator() = default;
+			constexpr __iterator(__state& s, D n) noexcept
+			: state_{std::addressof(s)}, n_{n} {}
+
+			iter_reference_t<I> operator*() const {
+				state_->sort_to(n_ + 1);
+				return state_->first_[n_];
+			}
+			iter_reference_t<I> operator[](D n) const
+			{ return *(*this + n); }
+
+			__iterator& operator++() noexcept { ++n_; return *this; }
+			__iterator operator++(int) noexcept
+			{ auto tmp = *this; ++n_; return tmp; }
+			__iterator& operator--() noexcept { --n_; return *this; }
+			__iterator operator--(int) noexcept
+			{ auto tmp = *this; --n_; return tmp; }
+			__iterator& operator+=(D n) noexcept { n_ += n; return *this; }
+			__iterator& operator-=(D n) noexcept { n_ -= n; return *this; }
+
+			friend __iterator operator+(__iterator i, D n) noexcept
+			{ return i += n; }
+			friend __iterator operator+(D n, __iterator i) noexcept
+			{ return i += n; }
+			friend __iterator operator-(__iterator i, D n) noexcept
+			{ return i -= n; }
+			friend D operator-(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ - y.n_; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ == y.n_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator<(const __iterator& x, const __iterator& y) noexcept
+			{ return x.n_ < y.n_; }
+			friend bool operator>(const __iterator& x, const __iterator& y) noexcept
+			{ return y < x; }
+			friend bool operator<=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(y < x); }
+			friend bool operator>=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x < y); }
+
+			friend iter_rvalue_reference_t<I> iter_move(const __iterator& i) {
+				i.state_->sort_to(i.n_ + 1);
+				return __stl2::iter_move(i.state_->first_ + i.n_);
+			}
+		};
+
+		template<class R, class Comp, class Proj>
+		sorted_view(R&&, Comp, Proj) -> sorted_view<all_view<R>, Comp, Proj>;
+	} // namespace ext
+
+	namespace views::ext {
+		struct __sorted_fn : detail::__pipeable<__sorted_fn> {
+			template<random_access_range R, class Comp = less, class Proj = identity>
+			requires viewable_range<R> && sized_range<R> &&
+				sortable<iterator_t<R>, Comp, Proj>
+			constexpr auto operator()(R&& rng, Comp comp = {}, Proj proj = {}) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::sorted_view{all(std::forward<R>(rng)),
+					std::move(comp), std::move(proj)}
+			)
+
+			template<class Comp, class Proj = identity>
+			requires (!range<Comp>) && copy_constructible<Comp> &&
+				copy_constructible<Proj>
+			constexpr auto operator()(Comp comp, Proj proj = {}) const {
+				return detail::view_closure{*this, std::move(comp), std::move(proj)};
+			}
+		};
+
+		inline constexpr __sorted_fn sorted{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -0,0 +1,191 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_STREAMVBYTE_DECODE_HPP
+#define STL2_VIEW_STREAMVBYTE_DECODE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/bytes_as.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// streamvbyte_decode_view [Extension]
+//
+// A sized forward view of the count 32-bit unsigned integers encoded in a
+// contiguous range of bytes in the StreamVByte format. (See
+// ext::streamvbyte_encode.)
+//
+// Values are decoded four at a time, one control byte per block. Where
+// SSSE3 is available and sixteen bytes are readable, a block is placed
+// with a single pshufb driven by a table of 256 shuffle masks indexed by
+// the control byte.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		struct __svb_tables {
+			// shuffle[c] moves the data of block c into four 32-bit lanes;
+			// 0x80 zeroes a byte.
+			unsigned char shuffle[256][16] = {};
+			// The data bytes of block c.
+			unsigned char length[256] = {};
+
+			constexpr __svb_tables() noexcept {
+				for (int c = 0; c < 256; ++c) {
+					int offset = 0;
+					for (int j = 0; j < 4; ++j) {
+						const int len = ((c >> (2 * j)) & 3) + 1;
+						for (int b = 0; b < 4; ++b) {
+							shuffle[c][4 * j + b] = static_cast<unsigned char>(
+								b < len ? offset + b : 0x80);
+						}
+						offset += len;
+					}
+					length[c] = static_cast<unsigned char>(offset);
+				}
+			}
+		};
+
+		inline constexpr __svb_tables __svb_table{};
+	} // namespace detail
+
+	namespace ext {
+		class streamvbyte_decode_view : public view_interface<streamvbyte_decode_view> {
+		private:
+			class __iterator;
+
+			const unsigned char* first_ = nullptr;
+			const unsigned char* last_ = nullptr;
+			std::ptrdiff_t count_ = 0;
+		public:
+			streamvbyte_decode_view() = default;
+			constexpr streamvbyte_decode_view(const void* data, std::ptrdiff_t bytes,
+				std::ptrdiff_t count) noexcept
+			: first_{static_cast<const unsigned char*>(data)}, last_{first_ + bytes}
+			, count_{count}
+			{ STL2_EXPECT(count >= 0 && (count + 3) / 4 <= bytes); }
+
+			template<detail::_ByteRange R>
+			requires (!same_as<__uncvref<R>, streamvbyte_decode_view>)
+			constexpr streamvbyte_decode_view(R&& r, std::ptrdiff_t count)
+			: streamvbyte_decode_view{__stl2::data(r),
+				static_cast<std::ptrdiff_t>(__stl2::size(r)), count} {}
+
+			inline __iterator begin() const noexcept;
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+			constexpr std::ptrdiff_t size() const noexcept { return count_; }
+		};
+
+		class streamvbyte_decode_view::__iterator {
+		private:
+			// The control byte and data of the next block.
+			const unsigned char* ctrl_ = nullptr;
+			const unsigned char* data_ = nullptr;
+			const unsigned char* last_ = nullptr;
+			std::ptrdiff_t i_ = 0;
+			std::ptrdiff_t n_ = 0;
+			std::uint32_t block_[4] = {};
+
+			void decode() noexcept {
+				const unsigned c = *ctrl_++;
+#ifdef __SSSE3__
+				if (last_ - data_ >= 16) {
+					const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data_));
+					const auto mask = _mm_loadu_si128(
+						reinterpret_cast<const __m128i*>(detail::__svb_table.shuffle[c]));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(block_),
+						_mm_shuffle_epi8(in, mask));
+					data_ += detail::__svb_table.length[c];
+					return;
+				}
+#endif
+				const auto m = n_ - i_ < 4 ? n_ - i_ : 4;
+				for (std::ptrdiff_t j = 0; j < m; ++j) {
+					const int len = ((c >> (2 * j)) & 3) + 1;
+					std::uint32_t v = 0;
+					for (int b = 0; b < len; ++b) {
+						v |= std::uint32_t{data_[b]} << (8 * b);
+					}
+					block_[j] = v;
+					data_ += len;
+				}
+			}
+		public:
+			using iterator_category = __stl2::forward_iterator_tag;
+			using value_type = std::uint32_t;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			__iterator(const unsigned char* first, const unsigned char* last,
+				std::ptrdiff_t n) noexcept
+			: ctrl_{first}, data_{first + (n + 3) / 4}, last_{last}, n_{n}
+			{ if (n_ != 0) decode(); }
+
+			std::uint32_t operator*() const noexcept { return block_[i_ % 4]; }
+
+			__iterator& operator++() noexcept {
+				if (++i_ % 4 == 0 && i_ != n_) decode();
+				return *this;
+			}
+			__iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.i_ == y.i_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator==(const __iterator& x, default_sentinel_t) noexcept
+			{ return x.i_ == x.n_; }
+			friend bool operator==(default_sentinel_t, const __iterator& x) noexcept
+			{ return x.i_ == x.n_; }
+			friend bool operator!=(const __iterator& x, default_sentinel_t y) noexcept
+			{ return !(x == y); }
+			friend bool operator!=(default_sentinel_t y, const __iterator& x) noexcept
+			{ return !(x == y); }
+
+			friend difference_type operator-(default_sentinel_t, const __iterator& x) noexcept
+			{ return x.n_ - x.i_; }
+			friend difference_type operator-(const __iterator& x, default_sentinel_t) noexcept
+			{ return x.i_ - x.n_; }
+		};
+
+		inline auto streamvbyte_decode_view::begin() const noexcept -> __iterator {
+			return __iterator{first_, last_, count_};
+		}
+	} // namespace ext
+
+	namespace views::ext {
+		struct __streamvbyte_decode_fn {
+			template<detail::_ByteRange R>
+			constexpr auto operator()(R&& r, std::ptrdiff_t count) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::streamvbyte_decode_view{r, count}
+			)
+
+			template<integral D>
+			constexpr auto operator()(D count) const
+			{ return detail::view_closure{*this, static_cast<std::ptrdiff_t>(count)}; }
+		};
+
+		inline constexpr __streamvbyte_decode_fn streamvbyte_decode{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
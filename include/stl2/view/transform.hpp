@@ -13,7 +13,9 @@
 #define STL2_VIEW_TRANSFORM_HPP
 
 #include <functional>
+#include <memory>
 
+#include <stl2/detail/batch.hpp>
 #include <stl2/detail/fwd.hpp>
 #include <stl2/detail/meta.hpp>
 #include <stl2/detail/semiregular_box.hpp>
@@ -36,7 +38,7 @@ STL2_OPEN_NAMESPACE {
 		template<bool> class __sentinel;
 
 		V base_ = V();
-		detail::semiregular_box<F> fun_;
+		STL2_NO_UNIQUE_ADDRESS detail::semiregular_box<F> fun_;
 
 	public:
 		transform_view() = default;
@@ -93,10 +95,32 @@ STL2_OPEN_NAMESPACE {
 	private:
 		using Parent = __maybe_const<Const, transform_view>;
 		using Base = __maybe_const<Const, V>;
+		// A stateless F is copied into the iterator, which is then no larger
+		// than iterator_t<Base>; any other F is reached through the parent.
+		static constexpr bool __stores_fun = std::is_empty_v<F>;
+		using __fun_or_parent = meta::if_c<__stores_fun,
+			detail::semiregular_box<F>, Parent*>;
+
 		iterator_t<Base> current_{};
-		Parent* parent_ = nullptr;
+		STL2_NO_UNIQUE_ADDRESS mutable __fun_or_parent fun_{};
 		friend __iterator<!Const>;
 		friend __sentinel<Const>;
+
+		constexpr __maybe_const<Const, F>& fun() const noexcept {
+			if constexpr (__stores_fun) {
+				return fun_.get();
+			} else {
+				return fun_->fun_.get();
+			}
+		}
+
+		static constexpr __fun_or_parent __get_fun(Parent& parent) noexcept {
+			if constexpr (__stores_fun) {
+				return parent.fun_;
+			} else {
+				return &parent;
+			}
+		}
 	public:
 		using iterator_category = iterator_category_t<iterator_t<Base>>;
 		using value_type =
@@ -106,18 +130,18 @@ STL2_OPEN_NAMESPACE {
 		__iterator() = default;
 
 		constexpr __iterator(Parent& parent, iterator_t<Base> current)
-		: current_(current), parent_(&parent) {}
+		: current_(current), fun_(__get_fun(parent)) {}
 
 		constexpr __iterator(__iterator<!Const> i)
 		requires Const && convertible_to<iterator_t<V>, iterator_t<Base>>
-		: current_(std::move(i.current_)), parent_(i.parent_) {}
+		: current_(std::move(i.current_)), fun_(std::move(i.fun_)) {}
 
 		constexpr iterator_t<Base> base() const
 		{ return current_; }
 
 		constexpr decltype(auto) operator*() const
-		noexcept(noexcept(invoke(parent_->fun_.get(), *current_)))
-		{ return invoke(parent_->fun_.get(), *current_); }
+		noexcept(noexcept(invoke(std::declval<__maybe_const<Const, F>&>(), *current_)))
+		{ return invoke(fun(), *current_); }
 
 		constexpr __iterator& operator++()
 		{
@@ -159,7 +183,32 @@ STL2_OPEN_NAMESPACE {
 		}
 		constexpr decltype(auto) operator[](difference_type n) const
 		requires random_access_range<Base>
-		{ return invoke(parent_->fun_.get(), current_[n]); }
+		{ return invoke(fun(), current_[n]); }
+
+		// Extension: with a contiguous base and a batch or simd overload of
+		// F, [*this, last) unpacks into out with one call to the former, or
+		// one call to the latter per full vector. Not when F returns a
+		// reference, since algorithms would then see copies of the elements.
+		constexpr value_type* unpack(const __iterator& last, value_type* out) const
+		requires (!std::is_reference_v<invoke_result_t<__maybe_const<Const, F>&,
+				range_reference_t<Base>>>) &&
+			_BatchSource<iterator_t<Base>> &&
+			(_BatchInvocable<__maybe_const<Const, F>, value_type, iter_value_t<iterator_t<Base>>> ||
+			_SimdInvocable<__maybe_const<Const, F>, value_type, iter_value_t<iterator_t<Base>>>)
+		{
+			const auto n = static_cast<std::ptrdiff_t>(last.current_ - current_);
+			if (n <= 0) return out;
+			if constexpr (_BatchInvocable<__maybe_const<Const, F>, value_type,
+				iter_value_t<iterator_t<Base>>>)
+			{
+				__invoke_batch(fun(), n, out, std::addressof(*current_));
+			} else {
+				for (auto i = __invoke_simd(fun(), n, out, std::addressof(*current_)); i < n; ++i) {
+					out[i] = invoke(fun(), current_[i]);
+				}
+			}
+			return out + n;
+		}
 
 		friend constexpr bool operator==(const __iterator& x, const __iterator& y)
 		requires equality_comparable<iterator_t<Base>>
@@ -187,15 +236,15 @@ STL2_OPEN_NAMESPACE {
 
 		friend constexpr __iterator operator+(__iterator i, difference_type n)
 		requires random_access_range<Base>
-		{ return __iterator{*i.parent_, i.current_ + n}; }
+		{ return i += n; }
 
 		friend constexpr __iterator operator+(difference_type n, __iterator i)
 		requires random_access_range<Base>
-		{ return __iterator{*i.parent_, i.current_ + n}; }
+		{ return i += n; }
 
 		friend constexpr __iterator operator-(__iterator i, difference_type n)
 		requires random_access_range<Base>
-		{ return __iterator{*i.parent_, i.current_ - n}; }
+		{ return i -= n; }
 
 		friend constexpr difference_type operator-(const __iterator& x, const __iterator& y)
 		requires random_access_range<Base>
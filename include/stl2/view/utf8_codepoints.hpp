@@ -0,0 +1,139 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_UTF8_CODEPOINTS_HPP
+#define STL2_VIEW_UTF8_CODEPOINTS_HPP
+
+#include <cstddef>
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/utf8.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// utf8_codepoints_view [Extension]
+//
+// A forward view of the code points of a contiguous range of UTF-8 code
+// units, as char32_t. Each ill-formed sequence yields one U+FFFD, per
+// Unicode's "substitution of maximal subparts".
+//
+// On reaching ASCII, an iterator finds the end of the run 16 or 32 bytes
+// at a time, and increments through it with no further decoding.
+//
+STL2_OPEN_NAMESPACE {
+	namespace ext {
+		class utf8_codepoints_view : public view_interface<utf8_codepoints_view> {
+		private:
+			class __iterator;
+
+			const unsigned char* first_ = nullptr;
+			const unsigned char* last_ = nullptr;
+		public:
+			static constexpr char32_t replacement = U'\xfffd';
+
+			utf8_codepoints_view() = default;
+			constexpr utf8_codepoints_view(const void* data, std::ptrdiff_t bytes) noexcept
+			: first_{static_cast<const unsigned char*>(data)}, last_{first_ + bytes} {}
+
+			template<detail::_Utf8Range R>
+			requires (!same_as<__uncvref<R>, utf8_codepoints_view>) &&
+				(std::is_lvalue_reference_v<R> || view<__uncvref<R>>)
+			explicit constexpr utf8_codepoints_view(R&& r)
+			: utf8_codepoints_view{__stl2::data(r), static_cast<std::ptrdiff_t>(__stl2::size(r))} {}
+
+			inline __iterator begin() const noexcept;
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		class utf8_codepoints_view::__iterator {
+		private:
+			const unsigned char* p_ = nullptr;
+			const unsigned char* next_ = nullptr;
+			const unsigned char* last_ = nullptr;
+			// [p_, ascii_end_) is known to be ASCII.
+			const unsigned char* ascii_end_ = nullptr;
+			char32_t value_ = 0;
+
+			void decode() noexcept {
+				if (p_ < ascii_end_) {
+					value_ = *p_;
+					next_ = p_ + 1;
+					return;
+				}
+				if (p_ == last_) return;
+				if (*p_ < 0x80) {
+					ascii_end_ = detail::__utf8_ascii_end(p_, last_);
+					value_ = *p_;
+					next_ = p_ + 1;
+					return;
+				}
+				next_ = p_;
+				value_ = detail::__utf8_decode(next_, last_);
+				if (value_ == detail::__utf8_error) value_ = replacement;
+			}
+		public:
+			using iterator_category = __stl2::forward_iterator_tag;
+			using value_type = char32_t;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			__iterator(const unsigned char* p, const unsigned char* last) noexcept
+			: p_{p}, last_{last} { decode(); }
+
+			char32_t operator*() const noexcept { return value_; }
+
+			__iterator& operator++() noexcept {
+				p_ = next_;
+				decode();
+				return *this;
+			}
+			__iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+
+			// The code units of this code point and those after it.
+			const unsigned char* base() const noexcept { return p_; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.p_ == y.p_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator==(const __iterator& x, default_sentinel_t) noexcept
+			{ return x.p_ == x.last_; }
+			friend bool operator==(default_sentinel_t, const __iterator& x) noexcept
+			{ return x.p_ == x.last_; }
+			friend bool operator!=(const __iterator& x, default_sentinel_t y) noexcept
+			{ return !(x == y); }
+			friend bool operator!=(default_sentinel_t y, const __iterator& x) noexcept
+			{ return !(x == y); }
+		};
+
+		inline auto utf8_codepoints_view::begin() const noexcept -> __iterator {
+			return __iterator{first_, last_};
+		}
+	} // namespace ext
+
+	namespace views::ext {
+		struct __utf8_codepoints_fn : detail::__pipeable<__utf8_codepoints_fn> {
+			template<detail::_Utf8Range R>
+			constexpr auto operator()(R&& r) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::utf8_codepoints_view{static_cast<R&&>(r)}
+			)
+		};
+
+		inline constexpr __utf8_codepoints_fn utf8_codepoints{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
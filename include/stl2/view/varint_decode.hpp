@@ -0,0 +1,247 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#ifndef STL2_VIEW_VARINT_DECODE_HPP
+#define STL2_VIEW_VARINT_DECODE_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+#include <stl2/detail/fwd.hpp>
+#include <stl2/detail/iterator/concepts.hpp>
+#include <stl2/detail/iterator/default_sentinel.hpp>
+#include <stl2/detail/range/access.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include <stl2/detail/view/view_closure.hpp>
+#include <stl2/view/bytes_as.hpp>
+#include <stl2/view/view_interface.hpp>
+
+///////////////////////////////////////////////////////////////////////////
+// varint_decode_view [Extension]
+//
+// A forward view of the unsigned integers encoded in a contiguous range of
+// bytes as LEB128 varints: seven bits per byte, least significant group
+// first, with the high bit set on every byte but the last. (See
+// ext::varint_encode.)
+//
+// Values are decoded up to four at a time. Where SSSE3 is available and
+// eight bytes are readable, the high bits of those bytes index a table of
+// 256 shuffle masks, as in Masked VByte: one pshufb moves each varint of up
+// to four bytes that ends among them into a 32-bit lane, where its
+// seven-bit groups are gathered with masks and shifts. A longer value is
+// decoded alone from one unaligned 64-bit load, when it has at most 56
+// bits, with BMI2 pext gathering the groups where available.
+//
+STL2_OPEN_NAMESPACE {
+	namespace detail {
+		template<class T>
+		META_CONCEPT _VarintValue = std::is_integral_v<T> && std::is_unsigned_v<T> &&
+			!same_as<T, bool>;
+
+		struct __varint_tables {
+			// shuffle[m] moves the varints of at most four bytes that begin
+			// eight bytes whose high bits are m into four 32-bit lanes;
+			// 0x80 zeroes a byte.
+			unsigned char shuffle[256][16] = {};
+			// The number of those varints, and the length of each.
+			unsigned char count[256] = {};
+			unsigned char length[256][4] = {};
+
+			constexpr __varint_tables() noexcept {
+				for (int m = 0; m < 256; ++m) {
+					for (auto& b : shuffle[m]) b = 0x80;
+					int pos = 0;
+					int n = 0;
+					for (; n < 4; ++n) {
+						int last = pos;
+						while (last < 8 && (m >> last) & 1) ++last;
+						if (last == 8 || last - pos >= 4) break;
+						const int len = last - pos + 1;
+						for (int b = 0; b < len; ++b) {
+							shuffle[m][4 * n + b] = static_cast<unsigned char>(pos + b);
+						}
+						length[m][n] = static_cast<unsigned char>(len);
+						pos = last + 1;
+					}
+					count[m] = static_cast<unsigned char>(n);
+				}
+			}
+		};
+
+		inline constexpr __varint_tables __varint_table{};
+
+		// Decodes one varint from [p, e), which must not be empty, into out.
+		// Returns the end of the varint.
+		template<class T>
+		const unsigned char*
+		__varint_decode_one(const unsigned char* p, const unsigned char* e, T& out) noexcept {
+			if constexpr (std::endian::native == std::endian::little) {
+				if (e - p >= 8) {
+					std::uint64_t w;
+					std::memcpy(&w, p, 8);
+					if (const auto stops = ~w & 0x8080808080808080u) {
+						const int bytes = std::countr_zero(stops) / 8 + 1;
+						const auto mask = 0x7f7f7f7f7f7f7f7fu >> (64 - 8 * bytes);
+#ifdef __BMI2__
+						out = static_cast<T>(_pext_u64(w, mask));
+#else
+						w &= mask;
+						std::uint64_t v = 0;
+						for (int i = 0; i < bytes; ++i) {
+							v |= ((w >> (8 * i)) & 0x7f) << (7 * i);
+						}
+						out = static_cast<T>(v);
+#endif
+						return p + bytes;
+					}
+				}
+			}
+			std::uint64_t v = 0;
+			int shift = 0;
+			unsigned char b;
+			do {
+				b = *p++;
+				if (shift < 64) v |= std::uint64_t{b & 0x7fu} << shift;
+				shift += 7;
+			} while ((b & 0x80) && p != e);
+			out = static_cast<T>(v);
+			return p;
+		}
+	} // namespace detail
+
+	namespace ext {
+		template<class T>
+		requires detail::_VarintValue<T>
+		class varint_decode_view : public view_interface<varint_decode_view<T>> {
+		private:
+			class __iterator;
+
+			const unsigned char* first_ = nullptr;
+			const unsigned char* last_ = nullptr;
+		public:
+			varint_decode_view() = default;
+			constexpr varint_decode_view(const void* data, std::ptrdiff_t bytes) noexcept
+			: first_{static_cast<const unsigned char*>(data)}, last_{first_ + bytes} {}
+
+			template<detail::_ByteRange R>
+			requires (!same_as<__uncvref<R>, varint_decode_view>)
+			explicit constexpr varint_decode_view(R&& r)
+			: varint_decode_view{__stl2::data(r), static_cast<std::ptrdiff_t>(__stl2::size(r))} {}
+
+			__iterator begin() const noexcept { return __iterator{first_, last_}; }
+			constexpr default_sentinel_t end() const noexcept { return {}; }
+		};
+
+		template<class T>
+		requires detail::_VarintValue<T>
+		class varint_decode_view<T>::__iterator {
+		private:
+			const unsigned char* p_ = nullptr;
+			const unsigned char* last_ = nullptr;
+			// The block of values beginning at p_, and their encoded lengths.
+			int i_ = 0;
+			int n_ = 0;
+			T block_[4] = {};
+			unsigned length_[4] = {};
+
+			void decode() noexcept {
+				i_ = 0;
+				if (p_ == last_) return;
+#ifdef __SSSE3__
+				if (last_ - p_ >= 8) {
+					const auto in = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p_));
+					const unsigned m = static_cast<unsigned>(_mm_movemask_epi8(in)) & 0xff;
+					if (const int n = detail::__varint_table.count[m]) {
+						const auto x = _mm_shuffle_epi8(in, _mm_loadu_si128(
+							reinterpret_cast<const __m128i*>(detail::__varint_table.shuffle[m])));
+						auto v = _mm_and_si128(x, _mm_set1_epi32(0x7f));
+						v = _mm_or_si128(v, _mm_srli_epi32(
+							_mm_and_si128(x, _mm_set1_epi32(0x7f00)), 1));
+						v = _mm_or_si128(v, _mm_srli_epi32(
+							_mm_and_si128(x, _mm_set1_epi32(0x7f0000)), 2));
+						v = _mm_or_si128(v, _mm_srli_epi32(
+							_mm_and_si128(x, _mm_set1_epi32(0x7f000000)), 3));
+						std::uint32_t lanes[4];
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), v);
+						for (int j = 0; j < 4; ++j) {
+							block_[j] = static_cast<T>(lanes[j]);
+							length_[j] = detail::__varint_table.length[m][j];
+						}
+						n_ = n;
+						return;
+					}
+				}
+#endif
+				length_[0] = static_cast<unsigned>(
+					detail::__varint_decode_one(p_, last_, block_[0]) - p_);
+				n_ = 1;
+			}
+		public:
+			using iterator_category = __stl2::forward_iterator_tag;
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+
+			__iterator() = default;
+			__iterator(const unsigned char* p, const unsigned char* last) noexcept
+			: p_{p}, last_{last} { decode(); }
+
+			T operator*() const noexcept { return block_[i_]; }
+
+			__iterator& operator++() noexcept {
+				p_ += length_[i_];
+				if (++i_ == n_) decode();
+				return *this;
+			}
+			__iterator operator++(int) noexcept
+			{ auto tmp = *this; ++*this; return tmp; }
+
+			// The encoded bytes not yet consumed, starting with this value's.
+			const unsigned char* base() const noexcept { return p_; }
+
+			friend bool operator==(const __iterator& x, const __iterator& y) noexcept
+			{ return x.p_ == y.p_; }
+			friend bool operator!=(const __iterator& x, const __iterator& y) noexcept
+			{ return !(x == y); }
+			friend bool operator==(const __iterator& x, default_sentinel_t) noexcept
+			{ return x.p_ == x.last_; }
+			friend bool operator==(default_sentinel_t, const __iterator& x) noexcept
+			{ return x.p_ == x.last_; }
+			friend bool operator!=(const __iterator& x, default_sentinel_t y) noexcept
+			{ return !(x == y); }
+			friend bool operator!=(default_sentinel_t y, const __iterator& x) noexcept
+			{ return !(x == y); }
+		};
+	} // namespace ext
+
+	namespace views::ext {
+		template<class T>
+		struct __varint_decode_fn : detail::__pipeable<__varint_decode_fn<T>> {
+			template<detail::_ByteRange R>
+			constexpr auto operator()(R&& r) const
+			STL2_REQUIRES_RETURN(
+				__stl2::ext::varint_decode_view<T>{r}
+			)
+		};
+
+		template<class T>
+		requires __stl2::detail::_VarintValue<T>
+		inline constexpr __varint_decode_fn<T> varint_decode{};
+	} // namespace views::ext
+} STL2_CLOSE_NAMESPACE
+
+#endif
@@ -64,7 +64,7 @@ STL2_OPEN_NAMESPACE {
 
 	template<class D>
 	requires std::is_class_v<D>
-	class view_interface : public view_base {
+	class view_interface {
 	private:
 		constexpr D& derived() noexcept {
 			static_assert(derived_from<D, view_interface>);
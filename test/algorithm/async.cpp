@@ -0,0 +1,164 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/async.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <functional>
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/iterator/insert_iterators.hpp>
+#include <stl2/view/filter.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace async = ranges::ext::async;
+
+namespace {
+	// An eagerly started coroutine that signals when it finishes.
+	struct fire_and_forget {
+		struct promise_type {
+			fire_and_forget get_return_object() noexcept { return {}; }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+			void unhandled_exception() noexcept { std::terminate(); }
+		};
+	};
+
+	std::vector<int> make_ints(int n) {
+		std::vector<int> v(static_cast<std::size_t>(n));
+		unsigned x = 12345;
+		for (auto& i : v) {
+			x = x * 1103515245u + 12345u;
+			i = static_cast<int>(x >> 8) % 1000;
+		}
+		return v;
+	}
+
+	fire_and_forget sort_and_sum(std::vector<int>& v, std::atomic<long>& sum,
+		std::atomic<bool>& done, std::thread::id& resumed_on)
+	{
+		auto last = co_await async::sort(v, ranges::greater{});
+		CHECK(last == v.end());
+		auto total = co_await async::reduce(v, 0L);
+		resumed_on = std::this_thread::get_id();
+		sum = total;
+		done = true;
+		done.notify_all();
+	}
+
+	// Runs each task on the calling thread.
+	struct inline_executor {
+		int tasks = 0;
+		void execute(async::task t) {
+			++tasks;
+			t();
+		}
+	};
+
+	// Drops every task.
+	struct dropping_executor {
+		void execute(async::task) {}
+	};
+}
+
+static_assert(async::executor<async::thread_pool>);
+static_assert(async::executor<inline_executor>);
+static_assert(!async::executor<int>);
+
+int main() {
+	{
+		// Awaiting resumes the coroutine once the algorithm has finished.
+		auto v = make_ints(100000);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end(), std::greater<>{});
+		std::atomic<long> sum{0};
+		std::atomic<bool> done{false};
+		std::thread::id resumed_on;
+		sort_and_sum(v, sum, done, resumed_on);
+		done.wait(false);
+		CHECK(v == expected);
+		CHECK(sum == std::accumulate(expected.begin(), expected.end(), 0L));
+		CHECK(resumed_on != std::this_thread::get_id());
+	}
+	{
+		// Blocking use, with the synchronous signatures.
+		struct record { int key; int id; };
+		std::vector<record> r;
+		for (int i = 0; i < 1000; ++i) r.push_back({i % 7, i});
+		auto op = async::stable_sort(r.begin(), r.end(), ranges::less{}, &record::key);
+		CHECK(op.get() == r.end());
+		CHECK(ranges::is_sorted(r, ranges::less{}, &record::key));
+		for (std::size_t i = 1; i < r.size(); ++i) {
+			if (r[i - 1].key == r[i].key) CHECK(r[i - 1].id < r[i].id);
+		}
+
+		auto v = make_ints(1000);
+		std::vector<int> evens, doubled(v.size());
+		auto c = async::copy_if(v, ranges::back_inserter(evens),
+			[](int i) { return i % 2 == 0; });
+		auto t = async::transform(v, doubled.begin(), [](int i) { return 2 * i; });
+		CHECK(c.get().in == v.end());
+		CHECK(t.get().out == doubled.end());
+		CHECK(ranges::equal(evens, v | ranges::views::filter([](int i) { return i % 2 == 0; })));
+		for (std::size_t i = 0; i < v.size(); ++i) CHECK(doubled[i] == 2 * v[i]);
+
+		std::vector<std::string> words{"a", "b", "c"};
+		CHECK(async::reduce(words, std::string{}).get() == "abc");
+	}
+	{
+		// A supplied executor, here completing before the call returns.
+		inline_executor ex;
+		std::vector<int> v{3, 1, 2};
+		auto op = async::sort(ex, v);
+		CHECK(ex.tasks == 1);
+		CHECK(op.ready());
+		CHECK(op.get() == v.end());
+		CHECK((v == std::vector<int>{1, 2, 3}));
+
+		async::thread_pool pool{2};
+		CHECK(async::reduce(pool, v, 1, std::multiplies<>{}, [](int i) { return i + 1; }).get() == 24);
+	}
+	{
+		// Exceptions reach the waiter.
+		std::vector<int> v{1, 2, 3};
+		std::vector<int> out(3);
+		auto op = async::transform(v, out.begin(), [](int i) {
+			if (i == 2) throw std::runtime_error{"2"};
+			return i;
+		});
+		try {
+			op.get();
+			CHECK(false);
+		} catch (const std::runtime_error&) {}
+
+		// A task that is never run breaks its promise.
+		dropping_executor ex;
+		auto dropped = async::sort(ex, v);
+		CHECK(dropped.ready());
+		try {
+			dropped.get();
+			CHECK(false);
+		} catch (const std::future_error& e) {
+			CHECK(e.code() == std::future_errc::broken_promise);
+		}
+	}
+
+	return test_result();
+}
@@ -10,6 +10,10 @@
 // Project home: https://github.com/ericniebler/range-v3
 
 #include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
+#include <sstream>
+#include <vector>
+#include <stl2/view/istream.hpp>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -87,5 +91,22 @@ int main()
 		CHECK(count_if(std::move(l), equals(42)) == 0);
 	}
 
+	{
+		// Parallel overloads
+		constexpr __stl2::ext::execution::parallel_policy par4{4, 64, 3};
+		auto odd = [](int i) { return i % 2 != 0; };
+
+		std::ostringstream text;
+		for (int i = 0; i < 10000; ++i) text << i << ' ';
+		std::istringstream in{text.str()};
+		CHECK(count_if(par4, __stl2::views::istream<int>(in), odd) == 5000);
+
+		std::vector<int> v(10001);
+		for (int i = 0; i < 10001; ++i) v[static_cast<std::size_t>(i)] = i;
+		CHECK(count_if(par4, v, odd) == 5000);
+		CHECK(count_if(par4, v.begin(), v.end(), odd, [](int i) { return i + 1; }) == 5001);
+		CHECK(count_if(__stl2::ext::execution::par, v, odd) == 5000);
+	}
+
 	return ::test_result();
 }
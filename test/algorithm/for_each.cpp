@@ -11,7 +11,13 @@
 
 #include <stl2/iterator.hpp>
 #include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
 #include <vector>
+#include <stl2/view/istream.hpp>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -65,5 +71,39 @@ int main() {
 	int matrix[3][4] = {};
 	ranges::for_each(matrix, [](int(&)[4]){});
 
+	{
+		// Parallel overloads
+		constexpr ranges::ext::execution::parallel_policy par4{4, 64, 3};
+		std::atomic<long> total{0};
+		auto add = [&](int i) { total += i; };
+
+		std::ostringstream text;
+		for (int i = 0; i < 10000; ++i) text << i << ' ';
+		std::istringstream in{text.str()};
+		auto ints = ranges::views::istream<int>(in);
+		auto r = ranges::for_each(par4, ints, add);
+		CHECK(r.in == ranges::default_sentinel);
+		CHECK(total == 49995000L);
+
+		std::vector<int> v(10000, 1);
+		CHECK(ranges::for_each(par4, v, [](int& i) { i *= 2; }).in == v.end());
+		CHECK(ranges::count(v, 2) == 10000);
+
+		std::istringstream in2{text.str()};
+		try {
+			ranges::for_each(par4, ranges::views::istream<int>(in2), [](int i) {
+				if (i == 1234) throw std::runtime_error{"1234"};
+			});
+			CHECK(false);
+		} catch (const std::runtime_error&) {}
+
+		// A grain below one means batches of one element.
+		total = 0;
+		std::istringstream in3{"1 2 3 4 5"};
+		ranges::for_each(ranges::ext::execution::parallel_policy{4, 0, 3},
+			ranges::views::istream<int>(in3), add);
+		CHECK(total == 15L);
+	}
+
 	return ::test_result();
 }
@@ -81,6 +81,16 @@ int main() {
 		CHECK(ic[2 * N - 1] == (int)(2 * N - 1));
 		CHECK(std::is_sorted(ic.get(), ic.get() + 2 * N));
 	}
+	{
+		// Stable: equivalent elements come from the first range first.
+		std::pair<int, int> a[] = {{1, 0}, {2, 0}, {2, 0}};
+		std::pair<int, int> b[] = {{1, 1}, {2, 1}, {3, 1}};
+		std::pair<int, int> c[6];
+		ranges::merge(a, b, c, ranges::less{}, &std::pair<int, int>::first,
+			&std::pair<int, int>::first);
+		std::pair<int, int> expected[] = {{1, 0}, {1, 1}, {2, 0}, {2, 0}, {2, 1}, {3, 1}};
+		CHECK(std::equal(c, c + 6, expected));
+	}
 
 	return ::test_result();
 }
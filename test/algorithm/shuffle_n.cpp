@@ -0,0 +1,87 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/shuffle_n.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+int main() {
+	using ranges::ext::shuffle_n;
+
+	{
+		std::vector<int> v(100);
+		std::iota(v.begin(), v.end(), 0);
+		std::mt19937 g{42};
+		CHECK(shuffle_n(v, 10, g) == v.begin() + 10);
+		auto sorted = v;
+		std::sort(sorted.begin(), sorted.end());
+		std::vector<int> orig(100);
+		std::iota(orig.begin(), orig.end(), 0);
+		CHECK(sorted == orig);
+		CHECK(!ranges::equal(v, orig));
+	}
+	{
+		// k is clamped to [0, size].
+		std::vector<int> v{1, 2, 3};
+		std::mt19937 g;
+		CHECK(shuffle_n(v.begin(), v.end(), 5, g) == v.end());
+		CHECK(shuffle_n(v, 0, g) == v.begin());
+		CHECK(shuffle_n(v, -1, g) == v.begin());
+		std::vector<int> empty;
+		CHECK(shuffle_n(empty, 3, g) == empty.end());
+		std::sort(v.begin(), v.end());
+		CHECK(v == (std::vector<int>{1, 2, 3}));
+	}
+	{
+		// Only the first k steps run: with k == 1, one swap at most, which
+		// brings a uniformly chosen element to the front.
+		constexpr int n = 8;
+		constexpr int trials = 80000;
+		int counts[n] = {};
+		std::mt19937 g{7};
+		for (int t = 0; t < trials; ++t) {
+			int a[n];
+			std::iota(a, a + n, 0);
+			shuffle_n(a, 1, g);
+			++counts[a[0]];
+			int moved = 0;
+			for (int i = 0; i < n; ++i) moved += a[i] != i;
+			CHECK((moved == 0 || moved == 2));
+		}
+		for (int c : counts) {
+			CHECK(c > trials / n * 9 / 10);
+			CHECK(c < trials / n * 11 / 10);
+		}
+	}
+	{
+		// O(k): a handful of draws, however long the range.
+		struct counting_engine {
+			using result_type = std::mt19937::result_type;
+			static constexpr result_type min() { return std::mt19937::min(); }
+			static constexpr result_type max() { return std::mt19937::max(); }
+			result_type operator()() { ++calls; return g(); }
+			std::mt19937 g;
+			int calls = 0;
+		} g;
+		std::vector<int> v(100000);
+		std::iota(v.begin(), v.end(), 0);
+		shuffle_n(v, 5, g);
+		CHECK(g.calls < 20);
+	}
+
+	return test_result();
+}
@@ -0,0 +1,240 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
+#include <stl2/detail/algorithm/search.hpp>
+#include <stl2/detail/algorithm/set_difference.hpp>
+#include <stl2/detail/algorithm/set_intersection.hpp>
+#include <stl2/detail/algorithm/set_symmetric_difference.hpp>
+#include <stl2/detail/algorithm/set_union.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <stop_token>
+#include <vector>
+
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/iterator/insert_iterators.hpp>
+#include <stl2/view/istream.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::uint32_t state = 2463534242u;
+	int next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return static_cast<int>(state % 100000);
+	}
+
+	std::vector<int> make_ints(std::size_t n) {
+		std::vector<int> v(n);
+		for (auto& i : v) i = next();
+		return v;
+	}
+
+	// Satisfied on the nth poll and after; counts the polls.
+	struct countdown {
+		mutable long polls = 0;
+		long n;
+		bool stop_requested() const { return ++polls >= n; }
+	};
+
+	const auto never = std::stop_token{};
+	const auto expired = ranges::ext::deadline{std::chrono::steady_clock::now()};
+}
+
+static_assert(ranges::ext::stop_condition<std::stop_token>);
+static_assert(ranges::ext::stop_condition<ranges::ext::deadline<>>);
+static_assert(ranges::ext::stop_condition<countdown>);
+static_assert(!ranges::ext::stop_condition<int>);
+
+int main() {
+	// sort
+	{
+		auto v = make_ints(100000);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+
+		auto w = v;
+		auto r = ranges::sort(never, w);
+		CHECK(!r.stopped);
+		CHECK(r.result == w.end());
+		CHECK(w == expected);
+
+		// Polls are rare: about one per few thousand elements partitioned.
+		w = v;
+		countdown c{0, 1000000};
+		CHECK(!ranges::sort(c, w.begin(), w.end(), ranges::greater{}).stopped);
+		CHECK(ranges::is_sorted(w, ranges::greater{}));
+		CHECK(c.polls < 1000);
+
+		// Stopped: the same elements, in some order.
+		w = v;
+		countdown soon{0, 3};
+		r = ranges::sort(soon, w);
+		CHECK(r.stopped);
+		CHECK(!ranges::is_sorted(w));
+		std::sort(w.begin(), w.end());
+		CHECK(w == expected);
+
+		w = v;
+		CHECK(ranges::sort(expired, w).stopped);
+		std::stop_source source;
+		source.request_stop();
+		CHECK(ranges::sort(source.get_token(), w).stopped);
+	}
+
+	// search
+	{
+		std::vector<int> haystack(100000, 0);
+		haystack[90000] = 1;
+		std::vector<int> needle{0, 1};
+		auto r = ranges::search(never, haystack, needle);
+		CHECK(!r.stopped);
+		CHECK(r.result.begin() == haystack.begin() + 89999);
+		CHECK(r.result.end() == haystack.begin() + 90001);
+
+		// Stopped: resumable from the first position not tried.
+		countdown c{0, 3};
+		auto s = ranges::search(c, haystack.begin(), haystack.end(),
+			needle.begin(), needle.end());
+		CHECK(s.stopped);
+		CHECK(s.result.empty());
+		CHECK(s.result.begin() == haystack.begin() + 2 * ranges::detail::__stop_poll_interval);
+		auto rest = ranges::search(never, s.result.begin(), haystack.end(),
+			needle.begin(), needle.end());
+		CHECK(rest.result.begin() == haystack.begin() + 89999);
+		CHECK(ranges::search(expired, haystack, needle).stopped);
+	}
+
+	// merge and set operations
+	{
+		auto a = make_ints(50000);
+		auto b = make_ints(50000);
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+
+		std::vector<int> expected, out;
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		auto m = ranges::merge(never, a, b, ranges::back_inserter(out));
+		CHECK(!m.stopped);
+		CHECK(m.result.in1 == a.end());
+		CHECK(m.result.in2 == b.end());
+		CHECK(out == expected);
+
+		// Stopped, then resumed where it left off.
+		out.clear();
+		countdown c{0, 4};
+		auto part = ranges::merge(c, a, b, ranges::back_inserter(out));
+		CHECK(part.stopped);
+		CHECK(out.size() == static_cast<std::size_t>(3 * ranges::detail::__stop_poll_interval));
+		ranges::merge(part.result.in1, a.end(), part.result.in2, b.end(),
+			ranges::back_inserter(out));
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		countdown c2{0, 2};
+		auto u = ranges::set_union(c2, a.begin(), a.end(), b.begin(), b.end(),
+			ranges::back_inserter(out));
+		CHECK(u.stopped);
+		ranges::set_union(u.result.in1, a.end(), u.result.in2, b.end(),
+			ranges::back_inserter(out));
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(),
+			std::back_inserter(expected));
+		auto i = ranges::set_intersection(never, a, b, ranges::back_inserter(out));
+		CHECK(!i.stopped);
+		CHECK(out == expected);
+		out.clear();
+		CHECK(ranges::set_intersection(expired, a, b, ranges::back_inserter(out)).stopped);
+		CHECK(out.empty());
+
+		expected.clear(); out.clear();
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+			std::back_inserter(expected));
+		countdown c3{0, 2};
+		auto d = ranges::set_difference(c3, a, b, ranges::back_inserter(out));
+		CHECK(d.stopped);
+		ranges::set_difference(d.result.in1, a.end(), d.result.in2, b.end(),
+			ranges::back_inserter(out));
+		CHECK(out == expected);
+		out.clear();
+		auto d2 = ranges::set_difference(never, a, b, ranges::back_inserter(out));
+		CHECK(!d2.stopped);
+		CHECK(d2.result.in1 == a.end());
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+			std::back_inserter(expected));
+		countdown c4{0, 2};
+		auto sd = ranges::set_symmetric_difference(c4, a.begin(), a.end(), b.begin(),
+			b.end(), ranges::back_inserter(out));
+		CHECK(sd.stopped);
+		ranges::set_symmetric_difference(sd.result.in1, a.end(), sd.result.in2, b.end(),
+			ranges::back_inserter(out));
+		CHECK(out == expected);
+		out.clear();
+		CHECK(ranges::set_symmetric_difference(expired, a, b,
+			ranges::back_inserter(out)).stopped);
+		CHECK(out.empty());
+	}
+
+	// Parallel algorithms poll per chunk or batch.
+	{
+		constexpr ranges::ext::execution::parallel_policy par4{4, 64, 3};
+		std::vector<int> v(100000, 1);
+
+		std::atomic<long> sum{0};
+		auto add = [&](int i) { sum += i; };
+		auto f = ranges::for_each(never, par4, v, add);
+		CHECK(!f.stopped);
+		CHECK(f.result.in == v.end());
+		CHECK(sum == 100000);
+
+		sum = 0;
+		CHECK(ranges::for_each(expired, par4, v, add).stopped);
+		CHECK(sum == 0);
+
+		std::ostringstream text;
+		for (int k = 0; k < 10000; ++k) text << k << ' ';
+		std::istringstream in{text.str()};
+		auto ints = ranges::views::istream<int>(in);
+		countdown c{0, 10};
+		std::vector<int> out;
+		auto t = ranges::transform(c, par4, ints, ranges::back_inserter(out),
+			[](int k) { return k; });
+		CHECK(t.stopped);
+		// Exactly the batches read before the stop were written, in order.
+		CHECK(out.size() == 9u * 64u);
+		for (std::size_t k = 0; k < out.size(); ++k) CHECK(out[k] == static_cast<int>(k));
+
+		auto n = ranges::count_if(never, par4, v.begin(), v.end(),
+			[](int k) { return k == 1; });
+		CHECK(!n.stopped);
+		CHECK(n.result == 100000);
+		CHECK(ranges::count_if(expired, par4, v, [](int k) { return k == 1; }).result == 0);
+	}
+
+	return test_result();
+}
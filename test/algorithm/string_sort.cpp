@@ -0,0 +1,121 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/string_sort.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::uint32_t state = 2463534242u;
+	std::uint32_t next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	// URL-like strings: long shared prefixes, duplicates, lengths on either
+	// side of every eight-byte boundary, and bytes >= 0x80 and == 0.
+	std::vector<std::string> make_strings(std::size_t n) {
+		const std::string prefixes[] = {"", "https://", "https://example.com/",
+			"https://example.com/a/b/c/", std::string("x\0y", 3)};
+		std::vector<std::string> v;
+		for (std::size_t i = 0; i < n; ++i) {
+			std::string s = prefixes[next() % 5];
+			for (auto k = next() % 20; k > 0; --k) {
+				const auto r = next() % 10;
+				s += r == 0 ? '\0' : r == 1 ? static_cast<char>(0xe9) : static_cast<char>('a' + r % 3);
+			}
+			v.push_back(std::move(s));
+			if (next() % 8 == 0) v.push_back(v[next() % v.size()]);
+		}
+		return v;
+	}
+
+	struct record {
+		std::string url;
+		int id;
+	};
+}
+
+int main() {
+	using ranges::ext::string_sort;
+	using ranges::ext::string_stable_sort;
+
+	for (std::size_t n : {0, 1, 2, 15, 17, 100, 5000}) {
+		auto v = make_strings(n);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+
+		auto w = v;
+		CHECK(string_sort(w) == w.end());
+		CHECK(w == expected);
+
+		w = v;
+		CHECK(string_stable_sort(w.begin(), w.end()) == w.end());
+		CHECK(w == expected);
+
+		// Views of the strings sort as the strings do.
+		std::vector<std::string_view> views(v.begin(), v.end());
+		string_sort(views);
+		CHECK(ranges::equal(views, expected));
+	}
+	{
+		std::vector<const char*> v = {"pear", "apple", "", "apples", "app"};
+		string_sort(v);
+		CHECK(ranges::equal(v, std::vector<std::string_view>{"", "app", "apple", "apples", "pear"}));
+	}
+	{
+		// Stability, through a projection.
+		auto urls = make_strings(3000);
+		std::vector<record> records;
+		for (std::size_t i = 0; i < urls.size(); ++i) {
+			records.push_back({urls[i % 300], static_cast<int>(i)});
+		}
+		auto expected = records;
+		std::stable_sort(expected.begin(), expected.end(),
+			[](const record& x, const record& y) { return x.url < y.url; });
+
+		string_stable_sort(records, &record::url);
+		CHECK(records.size() == expected.size());
+		bool same = true;
+		for (std::size_t i = 0; i < records.size(); ++i) {
+			same = same && records[i].url == expected[i].url && records[i].id == expected[i].id;
+		}
+		CHECK(same);
+
+		string_sort(records, &record::url);
+		CHECK(ranges::is_sorted(records, ranges::less{}, &record::url));
+	}
+	{
+		// Organ-pipe keys defeat median-of-three; without a depth bound
+		// the recursion would be about n deep.
+		constexpr std::uint32_t n = 1 << 20;
+		std::vector<std::string> v(n);
+		for (std::uint32_t i = 0; i < n; ++i) {
+			const auto k = i < n / 2 ? i : n - i;
+			v[i] = {static_cast<char>(k >> 24), static_cast<char>(k >> 16),
+				static_cast<char>(k >> 8), static_cast<char>(k)};
+		}
+		string_sort(v);
+		CHECK(std::is_sorted(v.begin(), v.end()));
+	}
+
+	return test_result();
+}
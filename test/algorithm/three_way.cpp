@@ -0,0 +1,218 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/binary_search.hpp>
+#include <stl2/detail/algorithm/equal_range.hpp>
+#include <stl2/detail/algorithm/includes.hpp>
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/merge.hpp>
+#include <stl2/detail/algorithm/set_difference.hpp>
+#include <stl2/detail/algorithm/set_intersection.hpp>
+#include <stl2/detail/algorithm/set_symmetric_difference.hpp>
+#include <stl2/detail/algorithm/set_union.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/upper_bound.hpp>
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/iterator/insert_iterators.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	std::uint32_t state = 2463534242u;
+	std::uint32_t next() {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	std::vector<int> make_ints(std::size_t n, std::uint32_t distinct) {
+		std::vector<int> v(n);
+		for (auto& i : v) i = static_cast<int>(next() % distinct);
+		return v;
+	}
+
+	// A three-way comparator that counts its calls.
+	struct counting_compare {
+		long* calls;
+
+		template<class T, class U>
+		std::strong_ordering operator()(const T& t, const U& u) const {
+			++*calls;
+			return t <=> u;
+		}
+	};
+
+	struct record {
+		int key;
+		int id;
+	};
+
+	// Not a total order: accepted by neither kind of overload.
+	struct partial_compare {
+		std::partial_ordering operator()(double x, double y) const { return x <=> y; }
+	};
+}
+
+static_assert(ranges::ext::three_way_sortable<int*>);
+static_assert(ranges::ext::three_way_sortable<int*, counting_compare>);
+static_assert(!ranges::ext::three_way_sortable<int*, ranges::less>);
+static_assert(!ranges::sortable<int*, std::compare_three_way>);
+static_assert(!ranges::ext::three_way_sortable<double*, partial_compare>);
+static_assert(!ranges::sortable<double*, partial_compare>);
+
+int main() {
+	constexpr std::compare_three_way cmp3{};
+
+	// sort
+	for (auto distinct : {1u, 2u, 10u, 1000u, 1u << 30}) {
+		for (std::size_t n : {0u, 1u, 2u, 15u, 17u, 100u, 10000u}) {
+			auto v = make_ints(n, distinct);
+			auto expected = v;
+			std::sort(expected.begin(), expected.end());
+			CHECK(ranges::sort(v, cmp3) == v.end());
+			CHECK(v == expected);
+
+			auto w = make_ints(n, distinct);
+			expected = w;
+			std::sort(expected.begin(), expected.end(), std::greater<>{});
+			CHECK(ranges::sort(w.begin(), w.end(), std::compare_three_way{},
+				[](int i) { return -i; }) == w.end());
+			CHECK(w == expected);
+		}
+	}
+	{
+		// Many duplicates: each partition removes every element equivalent
+		// to its pivot, so the calls stay far below n log n.
+		auto v = make_ints(100000, 4);
+		long calls = 0;
+		ranges::sort(v, counting_compare{&calls});
+		CHECK(ranges::is_sorted(v));
+		CHECK(calls < 4 * 100000);
+	}
+	{
+		// Sorted and reversed inputs.
+		std::vector<int> v(5000);
+		for (int i = 0; i < 5000; ++i) v[static_cast<std::size_t>(i)] = i;
+		auto expected = v;
+		ranges::sort(v, cmp3);
+		CHECK(v == expected);
+		std::reverse(v.begin(), v.end());
+		ranges::sort(v, cmp3);
+		CHECK(v == expected);
+	}
+	{
+		std::vector<std::string> v;
+		for (int i = 0; i < 1000; ++i) {
+			v.push_back("key" + std::to_string(next() % 300));
+		}
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+		ranges::sort(v, cmp3);
+		CHECK(v == expected);
+	}
+
+	// Binary searches
+	{
+		auto v = make_ints(2000, 100);
+		std::sort(v.begin(), v.end());
+		for (int value = -1; value <= 101; ++value) {
+			auto [lo, hi] = std::equal_range(v.begin(), v.end(), value);
+			auto r = ranges::equal_range(v, value, cmp3);
+			CHECK(r.begin() == lo);
+			CHECK(r.end() == hi);
+			auto r2 = ranges::equal_range(v.begin(), v.end(), value, cmp3);
+			CHECK(r2.begin() == lo);
+			CHECK(r2.end() == hi);
+			CHECK(ranges::lower_bound(v, value, cmp3) == lo);
+			CHECK(ranges::upper_bound(v.begin(), v.end(), value, cmp3) == hi);
+			CHECK(ranges::binary_search(v, value, cmp3) == (lo != hi));
+		}
+
+		// One call per probe: no more than a boolean lower_bound makes.
+		long calls = 0;
+		CHECK(ranges::binary_search(v, 50, counting_compare{&calls}));
+		CHECK(calls <= 12);
+	}
+	{
+		std::vector<record> v{{1, 0}, {3, 1}, {3, 2}, {3, 3}, {7, 4}};
+		auto r = ranges::equal_range(v, 3, cmp3, &record::key);
+		CHECK(r.begin() == v.begin() + 1);
+		CHECK(r.end() == v.begin() + 4);
+		CHECK(!ranges::binary_search(v, 4, cmp3, &record::key));
+	}
+
+	// merge and the set algorithms
+	for (int i = 0; i < 50; ++i) {
+		auto a = make_ints(next() % 200, 50);
+		auto b = make_ints(next() % 200, 50);
+		std::sort(a.begin(), a.end());
+		std::sort(b.begin(), b.end());
+
+		std::vector<int> expected, out;
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		auto m = ranges::merge(a, b, ranges::back_inserter(out), cmp3);
+		CHECK(m.in1 == a.end());
+		CHECK(m.in2 == b.end());
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		ranges::set_union(a, b, ranges::back_inserter(out), cmp3);
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		long calls = 0;
+		ranges::set_intersection(a, b, ranges::back_inserter(out), counting_compare{&calls});
+		CHECK(out == expected);
+		CHECK(calls <= static_cast<long>(a.size() + b.size()));
+
+		expected.clear(); out.clear();
+		std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+		auto d = ranges::set_difference(a.begin(), a.end(), b.begin(), b.end(),
+			ranges::back_inserter(out), cmp3);
+		CHECK(d.in == a.end());
+		CHECK(out == expected);
+
+		expected.clear(); out.clear();
+		std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(),
+			std::back_inserter(expected));
+		ranges::set_symmetric_difference(a, b, ranges::back_inserter(out), cmp3);
+		CHECK(out == expected);
+
+		CHECK(ranges::includes(a, b, cmp3) ==
+			std::includes(a.begin(), a.end(), b.begin(), b.end()));
+		CHECK(ranges::includes(a, expected, cmp3) ==
+			std::includes(a.begin(), a.end(), expected.begin(), expected.end()));
+	}
+	{
+		std::vector<record> a{{1, 0}, {2, 1}, {4, 2}};
+		std::vector<record> b{{2, 10}, {3, 11}, {4, 12}};
+		std::vector<record> out;
+		ranges::set_intersection(a, b, ranges::back_inserter(out), cmp3,
+			&record::key, &record::key);
+		CHECK(out.size() == 2u);
+		CHECK(out[0].id == 1);
+		CHECK(out[1].id == 2);
+		CHECK(ranges::includes(a, std::vector<int>{1, 4}, cmp3, &record::key));
+	}
+
+	return test_result();
+}
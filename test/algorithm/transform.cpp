@@ -10,11 +10,70 @@
 // Project home: https://github.com/caseycarter/cmcstl2
 //
 #include <stl2/detail/algorithm/transform.hpp>
+#include <stl2/detail/algorithm/parallel.hpp>
 
+#include <algorithm>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <stl2/simd.hpp>
+#include <stl2/detail/iterator/insert_iterators.hpp>
+#include <stl2/view/istream.hpp>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
 
+namespace {
+	// Element-wise and batch overloads; counts the batch calls.
+	struct twice {
+		int* batches;
+		int operator()(int i) const { return 2 * i; }
+		void operator()(ranges::ext::span<const int> in, ranges::ext::span<int> out) const {
+			++*batches;
+			CHECK(in.size() == out.size());
+			for (std::ptrdiff_t i = 0; i < in.size(); ++i) out[i] = 2 * in[i];
+		}
+	};
+
+	// Element-wise and simd overloads; counts the simd calls.
+	struct plus_one {
+		using is_vectorized = void;
+		int* vectors;
+		double operator()(float x) const { return x + 1.0; }
+		template<int N>
+		ranges::ext::simd<double, N> operator()(ranges::ext::simd<float, N> x) const {
+			++*vectors;
+			ranges::ext::simd<double, N> r{[&](int i) { return x[i] + 1.0; }};
+			return r;
+		}
+	};
+
+	struct product {
+		using is_vectorized = void;
+		int* vectors;
+		int operator()(int x, int y) const { return x * y; }
+		template<int N>
+		ranges::ext::simd<int, N> operator()(ranges::ext::simd<int, N> x,
+			ranges::ext::simd<int, N> y) const
+		{
+			++*vectors;
+			return x * y;
+		}
+	};
+
+	struct sum {
+		int* batches;
+		int operator()(int x, int y) const { return x + y; }
+		void operator()(ranges::ext::span<const int> x, ranges::ext::span<const int> y,
+			ranges::ext::span<int> out) const
+		{
+			++*batches;
+			for (std::ptrdiff_t i = 0; i < out.size(); ++i) out[i] = x[i] + y[i];
+		}
+	};
+}
+
 int main() {
 	int rgi[]{1,2,3,4,5};
 	ranges::transform(rgi, rgi+5, rgi, [](int i){ return i * 2; });
@@ -49,5 +108,140 @@ int main() {
 		}
 	}
 
+	{
+		// Parallel, over an input-only range: small batches, few in flight.
+		constexpr ranges::ext::execution::parallel_policy par4{4, 64, 3};
+		auto unordered = par4;
+		unordered.ordered = false;
+
+		std::ostringstream text;
+		std::vector<long> expected;
+		for (int i = 0; i < 10000; ++i) {
+			text << i << ' ';
+			expected.push_back(3L * i);
+		}
+		auto triple = [](int i) { return 3L * i; };
+
+		std::istringstream in{text.str()};
+		auto ints = ranges::views::istream<int>(in);
+		std::vector<long> out;
+		auto r = ranges::transform(par4, ints, ranges::back_inserter(out), triple);
+		CHECK(out == expected);
+		CHECK(r.in == ranges::default_sentinel);
+
+		std::istringstream in2{text.str()};
+		out.clear();
+		ranges::transform(unordered, ranges::views::istream<int>(in2),
+			ranges::back_inserter(out), triple);
+		std::sort(out.begin(), out.end());
+		CHECK(out == expected);
+
+		// Forward ranges are buffered as iterators.
+		std::list<int> l(1000);
+		int n = 0;
+		for (auto& i : l) i = n++;
+		out.assign(1000, 0);
+		auto lr = ranges::transform(par4, l, out.begin(), triple);
+		CHECK(lr.in == l.end());
+		CHECK(lr.out == out.end());
+		CHECK(std::equal(out.begin(), out.end(), expected.begin()));
+
+		// Random access input and output: chunked, written in place.
+		std::vector<int> v(5000);
+		for (int i = 0; i < 5000; ++i) v[static_cast<std::size_t>(i)] = i;
+		std::vector<long> w(5000);
+		auto vr = ranges::transform(par4, v, w.begin(), triple);
+		CHECK(vr.in == v.end());
+		CHECK(vr.out == w.end());
+		CHECK(std::equal(w.begin(), w.end(), expected.begin()));
+
+		// An exception stops the pipeline; the batches before it are written.
+		std::istringstream in3{text.str()};
+		out.clear();
+		try {
+			ranges::transform(par4, ranges::views::istream<int>(in3),
+				ranges::back_inserter(out), [](int i) {
+					if (i == 5000) throw std::runtime_error{"5000"};
+					return 3L * i;
+				});
+			CHECK(false);
+		} catch (const std::runtime_error&) {
+			CHECK(out.size() <= 5000u);
+			CHECK((out.size() % 64) == 0u);
+			CHECK(std::equal(out.begin(), out.end(), expected.begin()));
+		}
+	}
+
+	{
+		// Batch overloads take whole contiguous ranges.
+		int batches = 0;
+		std::vector<int> v{1, 2, 3, 4, 5};
+		std::vector<int> out(5);
+		auto r = ranges::transform(v, out.begin(), twice{&batches});
+		CHECK(batches == 1);
+		CHECK(r.in == v.end());
+		CHECK(r.out == out.end());
+		CHECK((out == std::vector<int>{2, 4, 6, 8, 10}));
+
+		// In place.
+		ranges::transform(v, v.begin(), twice{&batches});
+		CHECK(batches == 2);
+		CHECK(v == out);
+
+		// Empty, projected, or not contiguous: element-wise.
+		ranges::transform(v.begin(), v.begin(), out.begin(), twice{&batches});
+		ranges::transform(v, out.begin(), twice{&batches}, [](int i) { return i + 1; });
+		CHECK((out == std::vector<int>{6, 10, 14, 18, 22}));
+		std::list<int> l{1, 2};
+		std::vector<int> lout;
+		ranges::transform(l, ranges::back_inserter(lout), twice{&batches});
+		CHECK(batches == 2);
+		CHECK((lout == std::vector<int>{2, 4}));
+
+		// Binary: up to the end of the shorter input.
+		int a[] = {1, 2, 3, 4};
+		int b[] = {10, 20, 30};
+		int c[4] = {};
+		auto br = ranges::transform(a, b, c, sum{&batches});
+		CHECK(batches == 3);
+		CHECK(br.in1 == a + 3);
+		CHECK(br.in2 == b + 3);
+		CHECK(br.out == c + 3);
+		CHECK(c[0] == 11);
+		CHECK(c[2] == 33);
+		CHECK(c[3] == 0);
+	}
+
+	{
+		// Simd overloads take full vectors; the tail is element-wise.
+		int vectors = 0;
+		constexpr int lanes = ranges::__simd_batch_lanes<double, float>();
+		std::vector<float> v(5 * lanes + 3);
+		for (std::size_t i = 0; i < v.size(); ++i) v[i] = static_cast<float>(i);
+		std::vector<double> out(v.size());
+		auto r = ranges::transform(v, out.begin(), plus_one{&vectors});
+		CHECK(vectors == 5);
+		CHECK(r.in == v.end());
+		CHECK(r.out == out.end());
+		for (std::size_t i = 0; i < v.size(); ++i) CHECK(out[i] == i + 1.0);
+
+		// Without is_vectorized, a generic lambda is only called element-wise.
+		std::vector<int> a(100), b(90), c(100);
+		for (int i = 0; i < 100; ++i) a[static_cast<std::size_t>(i)] = i;
+		for (int i = 0; i < 90; ++i) b[static_cast<std::size_t>(i)] = 2;
+		ranges::transform(a, b, c.begin(), [](auto x, auto y) {
+			static_assert(std::is_same_v<decltype(x), int>);
+			return x + y;
+		});
+		CHECK(c[89] == 91);
+
+		vectors = 0;
+		auto br = ranges::transform(a, b, c.begin(), product{&vectors});
+		CHECK(vectors == 90 / ranges::ext::simd_native_lanes<int>);
+		CHECK(br.in1 == a.begin() + 90);
+		CHECK(br.out == c.begin() + 90);
+		for (std::size_t i = 0; i < 90; ++i) CHECK(c[i] == 2 * a[i]);
+	}
+
 	return ::test_result();
 }
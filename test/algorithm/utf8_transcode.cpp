@@ -0,0 +1,71 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/utf8_transcode.hpp>
+
+#include <string>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+int main() {
+	using ranges::ext::utf8_transcode;
+
+	const std::u8string text = u8"ASCII only, long enough for a vector step. "
+		u8"héllo ∑ \U0001F600 ࠀ￿\U00010000\U0010FFFF!";
+	const std::u16string text16 = u"ASCII only, long enough for a vector step. "
+		u"héllo ∑ \U0001F600 ࠀ￿\U00010000\U0010FFFF!";
+	const std::u32string text32 = U"ASCII only, long enough for a vector step. "
+		U"héllo ∑ \U0001F600 ࠀ￿\U00010000\U0010FFFF!";
+	{
+		std::u32string out(text.size(), U'\0');
+		auto [in, o] = utf8_transcode(text, out.begin());
+		CHECK(in == text.end());
+		CHECK(ranges::equal(out.begin(), o, text32.begin(), text32.end()));
+	}
+	{
+		std::u16string out(text.size(), u'\0');
+		auto [in, o] = utf8_transcode(text, out.data());
+		CHECK(in == text.end());
+		CHECK(ranges::equal(out.data(), o, text16.begin(), text16.end()));
+	}
+	{
+		// Every prefix, through the vector and scalar paths.
+		for (std::size_t n = 0; n <= 50; ++n) {
+			std::u8string s(n, u8'x');
+			std::u32string out(n, U'\0');
+			auto r = utf8_transcode(s, out.begin());
+			CHECK(r.in == s.end());
+			CHECK(r.out == out.end());
+			CHECK(ranges::equal(out, std::u32string(n, U'x')));
+		}
+	}
+	{
+		// Stops at the first ill-formed sequence.
+		const std::string bad = std::string(40, 'a') + "\xc3\xa9" "b\xed\xa0\x80" "c";
+		std::vector<char32_t> out(bad.size());
+		auto [in, o] = utf8_transcode(bad, out.begin());
+		CHECK((in - bad.begin()) == 43);
+		CHECK((o - out.begin()) == 42);
+		CHECK(out[40] == U'é');
+		CHECK(out[41] == U'b');
+	}
+	{
+		std::string empty;
+		std::vector<char16_t> out;
+		auto [in, o] = utf8_transcode(empty, out.begin());
+		CHECK(in == empty.end());
+		CHECK(o == out.end());
+	}
+
+	return test_result();
+}
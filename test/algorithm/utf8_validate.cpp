@@ -0,0 +1,107 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/algorithm/utf8_validate.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <stl2/detail/span.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	const std::u8string sample = u8"héllo wörld ∑ \U0001F600 ࠀ￿\U00010000\U0010FFFF";
+
+	std::ptrdiff_t find_invalid(const std::string& s) {
+		return ranges::ext::utf8_find_invalid(s) - s.begin();
+	}
+
+	std::ptrdiff_t reference(const std::string& s) {
+		auto p = reinterpret_cast<const unsigned char*>(s.data());
+		return ranges::detail::__utf8_find_invalid_scalar(p, p + s.size()) - p;
+	}
+}
+
+int main() {
+	using ranges::ext::utf8_validate;
+	{
+		CHECK(utf8_validate(std::string{}));
+		CHECK(utf8_validate(sample));
+		CHECK(utf8_validate(ranges::ext::span<const char8_t>{sample.data(),
+			static_cast<std::ptrdiff_t>(sample.size())}));
+		std::u8string long_text;
+		for (int i = 0; i < 50; ++i) {
+			long_text += sample;
+		}
+		CHECK(utf8_validate(long_text));
+		for (std::size_t n = 0; n < 200; ++n) {
+			// Every split of the sequences across block boundaries.
+			std::u8string s = long_text.substr(0, n);
+			const bool whole = n == s.size() &&
+				(n == long_text.size() || (long_text[n] & 0xc0) != 0x80);
+			CHECK(utf8_validate(s) == whole);
+		}
+	}
+
+	const std::vector<std::string> invalid = {
+		"\x80",             // lone continuation
+		"\xbf\x80",
+		"\xc0\x80",         // overlong
+		"\xc1\xbf",
+		"\xe0\x80\x80",
+		"\xe0\x9f\xbf",
+		"\xf0\x80\x80\x80",
+		"\xf0\x8f\xbf\xbf",
+		"\xed\xa0\x80",     // surrogate
+		"\xed\xbf\xbf",
+		"\xf4\x90\x80\x80", // > U+10FFFF
+		"\xf5\x80\x80\x80",
+		"\xff",
+		"\xc3",             // truncated
+		"\xe2\x82",
+		"\xf0\x9f\x98",
+		"\xe2\x82" "a",
+		"\xc3\xa9\x80",     // too long
+	};
+	const std::string ascii(100, 'a');
+	const std::string text(reinterpret_cast<const char*>(sample.data()), sample.size());
+	for (auto& bad : invalid) {
+		const auto bad_offset = bad == "\xc3\xa9\x80" ? 2 : 0;
+		for (std::size_t at : {0, 1, 15, 16, 17, 31, 61, 62, 63, 64, 65, 70, 100}) {
+			std::string s = ascii.substr(0, at) + bad + ascii;
+			CHECK(!utf8_validate(s));
+			CHECK(find_invalid(s) == static_cast<std::ptrdiff_t>(at) + bad_offset);
+
+			// At the end, and among multibyte sequences.
+			s = ascii.substr(0, at) + bad;
+			CHECK(find_invalid(s) == static_cast<std::ptrdiff_t>(at) + bad_offset);
+			s = text + ascii.substr(0, at) + bad + text;
+			CHECK(find_invalid(s) == static_cast<std::ptrdiff_t>(text.size() + at) + bad_offset);
+		}
+	}
+	{
+		// Mutated text agrees with the scalar validator.
+		std::string base;
+		for (int i = 0; i < 8; ++i) base += text + ascii.substr(0, i * 5);
+		std::uint32_t x = 12345;
+		auto next = [&] { x ^= x << 13; x ^= x >> 17; x ^= x << 5; return x; };
+		for (int trial = 0; trial < 4000; ++trial) {
+			std::string s = base;
+			for (int k = next() % 3; k >= 0; --k) {
+				s[next() % s.size()] = static_cast<char>(next());
+			}
+			CHECK(find_invalid(s) == reference(s));
+		}
+	}
+
+	return test_result();
+}
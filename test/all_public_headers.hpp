@@ -22,12 +22,17 @@
 #include <experimental/ranges/type_traits>
 #include <experimental/ranges/utility>
 #include <stl2/algorithm.hpp>
+#include <stl2/buffered_writer.hpp>
 #include <stl2/concepts.hpp>
 #include <stl2/functional.hpp>
 #include <stl2/iterator.hpp>
 #include <stl2/memory.hpp>
+#include <stl2/ragged_vector.hpp>
 #include <stl2/random.hpp>
 #include <stl2/ranges.hpp>
+#include <stl2/simd.hpp>
+#include <stl2/soa_vector.hpp>
+#include <stl2/static_map.hpp>
 #include <stl2/type_traits.hpp>
 #include <stl2/utility.hpp>
 
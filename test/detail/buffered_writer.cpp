@@ -0,0 +1,156 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/buffered_writer.hpp>
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
+#include <stl2/iterator.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	struct temporary_path {
+		std::string path;
+
+		temporary_path() {
+			char name[] = "/tmp/stl2_buffered_writerXXXXXX";
+			const int fd = ::mkstemp(name);
+			CHECK(fd >= 0);
+			::close(fd);
+			path = name;
+		}
+		~temporary_path() { std::remove(path.c_str()); }
+
+		std::string contents() const {
+			std::ifstream in{path, std::ios::binary};
+			return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+		}
+	};
+
+	std::string make_text(std::size_t n) {
+		std::string s(n, '\0');
+		for (std::size_t i = 0; i < n; ++i) {
+			s[i] = static_cast<char>('a' + (i * 7 + i / 26) % 26);
+		}
+		return s;
+	}
+
+	void test_writer(bool direct) {
+		const temporary_path file;
+		const auto text = make_text(100000);
+		std::string expected;
+		{
+			ranges::ext::buffered_writer w{file.path, 8192, direct};
+			CHECK(w.capacity() == 8192u);
+
+			// Element by element through the output iterator.
+			auto out = ranges::copy(text.begin(), text.begin() + 5000,
+				ranges::ext::fd_output_iterator<char>{w}).out;
+			CHECK(out.writer() == &w);
+			expected.append(text, 0, 5000);
+
+			// In place, through the span prepare returns.
+			for (int i = 0; i < 1000; ++i) {
+				auto s = w.prepare(16);
+				auto first = reinterpret_cast<char*>(s.data());
+				auto r = std::to_chars(first, first + 16, i);
+				*r.ptr++ = '\n';
+				w.commit(static_cast<std::size_t>(r.ptr - first));
+				expected.append(first, r.ptr);
+			}
+			auto s = w.prepare(26);
+			auto first = reinterpret_cast<char*>(s.data());
+			ranges::transform(text.begin(), text.begin() + 26, first,
+				[](char c) { return static_cast<char>(c - 'a' + 'A'); });
+			w.commit(26);
+			expected.append(first, first + 26);
+
+			// Larger than the buffer.
+			w.write(ranges::ext::span<const char>{text});
+			expected += text;
+			w.put(std::byte{'!'});
+			expected += '!';
+
+			ranges::ext::buffered_writer moved = std::move(w);
+			CHECK(w.fd() == -1);
+			moved.write(text.data(), 3);
+			expected.append(text, 0, 3);
+			moved.close();
+		}
+		CHECK(file.contents() == expected);
+	}
+}
+
+int main() {
+	static_assert(ranges::output_iterator<ranges::ext::fd_output_iterator<char>, char>);
+	static_assert(ranges::output_iterator<ranges::ext::fd_output_iterator<int>, int>);
+
+	test_writer(false);
+	test_writer(true);
+
+	{
+		// Values of wider types are written as their object representation.
+		const temporary_path file;
+		const std::vector<int> v = {1, 2, 3, 0x01020304};
+		{
+			ranges::ext::buffered_writer w{file.path};
+			ranges::copy(v, ranges::ext::fd_output_iterator<int>{w});
+		}
+		const auto bytes = file.contents();
+		CHECK(bytes.size() == v.size() * sizeof(int));
+		std::vector<int> back(v.size());
+		std::memcpy(back.data(), bytes.data(), bytes.size());
+		CHECK(back == v);
+	}
+
+	try {
+		ranges::ext::buffered_writer w{"/nonexistent/stl2/file"};
+		CHECK(false);
+	} catch (const std::system_error& e) {
+		CHECK(e.code() == std::errc::no_such_file_or_directory);
+	}
+
+	{
+		// A failed flush still closes the file.
+		const int before = ::dup(0);
+		::close(before);
+		{
+			ranges::ext::buffered_writer w{"/dev/full"};
+			w.put(std::byte{1});
+			try {
+				w.close();
+				CHECK(false);
+			} catch (const std::system_error& e) {
+				CHECK(e.code() == std::errc::no_space_on_device);
+			}
+			CHECK(w.fd() == -1);
+		}
+		{
+			ranges::ext::buffered_writer w{"/dev/full"};
+			w.put(std::byte{1});
+		}
+		const int after = ::dup(0);
+		::close(after);
+		CHECK(after == before);
+	}
+
+	return test_result();
+}
@@ -0,0 +1,125 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/ragged_vector.hpp>
+
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/find_if.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/view/istream.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+int main() {
+	using ranges::ext::ragged_vector;
+	{
+		ragged_vector<int> rv;
+		CHECK(rv.empty());
+		CHECK(rv.size() == 0);
+		CHECK(rv.value_count() == 0);
+		CHECK(rv.rows().empty());
+
+		auto r0 = rv.push_back(std::vector<int>{3, 1, 2});
+		CHECK_EQUAL(r0, {3, 1, 2});
+		rv.push_back(std::list<int>{});
+		std::istringstream ss{"7 5 6 4"};
+		rv.push_back(ranges::views::istream<int>(ss));
+		auto r3 = rv.emplace_back(2);
+		CHECK_EQUAL(r3, {0, 0});
+		r3[1] = 9;
+
+		CHECK(rv.size() == 4);
+		CHECK(rv.value_count() == 9);
+		CHECK_EQUAL(rv[0], {3, 1, 2});
+		CHECK(rv[1].empty());
+		CHECK_EQUAL(rv[2], {7, 5, 6, 4});
+		CHECK_EQUAL(rv.back(), {0, 9});
+		CHECK_EQUAL(rv.values(), {3, 1, 2, 7, 5, 6, 4, 0, 9});
+		CHECK_EQUAL(rv.offsets(), {0, 3, 3, 7, 9});
+
+		using Rows = decltype(rv.rows());
+		static_assert(ranges::view<Rows>);
+		static_assert(ranges::random_access_range<Rows>);
+		static_assert(ranges::sized_range<Rows>);
+		static_assert(ranges::common_range<Rows>);
+		static_assert(ranges::same_as<ranges::range_reference_t<Rows>, ranges::ext::span<int>>);
+		static_assert(ranges::contiguous_range<decltype(rv.values())>);
+
+		for (auto row : rv.rows()) {
+			ranges::sort(row);
+		}
+		CHECK_EQUAL(rv.values(), {1, 2, 3, 4, 5, 6, 7, 0, 9});
+		CHECK(ranges::count(rv.values(), 0) == 1);
+
+		auto rows = rv.rows();
+		CHECK(rows.size() == 4);
+		CHECK_EQUAL(rows[2], {4, 5, 6, 7});
+		CHECK((rows.end() - rows.begin()) == 4);
+		auto it = ranges::find_if(rows, [](auto r) { return r.size() == 4; });
+		CHECK((it - rows.begin()) == 2);
+
+		auto tail = rv.rows(2, 4);
+		CHECK(tail.size() == 2);
+		CHECK_EQUAL(tail[0], {4, 5, 6, 7});
+
+		CHECK(rv.row_of(0) == 0);
+		CHECK(rv.row_of(2) == 0);
+		CHECK(rv.row_of(3) == 2);
+		CHECK(rv.row_of(6) == 2);
+		CHECK(rv.row_of(8) == 3);
+
+		const auto& crv = rv;
+		static_assert(ranges::same_as<decltype(crv[0]), ranges::ext::span<const int>>);
+		CHECK_EQUAL(crv.rows()[0], {1, 2, 3});
+
+		rv.pop_back();
+		CHECK(rv.size() == 3);
+		CHECK(rv.value_count() == 7);
+		rv.clear();
+		CHECK(rv.empty());
+		CHECK(rv.value_count() == 0);
+	}
+	{
+		std::vector<std::vector<std::string>> adj{{"b", "c"}, {"c"}, {}};
+		ragged_vector<std::string> rv{adj};
+		CHECK(rv.size() == 3);
+		CHECK(rv.value_count() == 3);
+		CHECK(rv[0][1] == "c");
+		CHECK(rv[2].empty());
+
+		auto copy = rv;
+		CHECK(copy == rv);
+		copy.push_back(std::vector<std::string>{"a"});
+		CHECK(copy != rv);
+	}
+	{
+		// Rows of the vector itself, appended as it grows.
+		ragged_vector<std::string> rv;
+		std::vector<std::vector<std::string>> expected{{"a", "bb", "ccc"}};
+		rv.push_back(expected[0]);
+		for (std::size_t i = 0; i < 10; ++i) {
+			rv.push_back(rv[static_cast<std::ptrdiff_t>(i)]);
+			expected.push_back(expected[i]);
+			rv.push_back(rv.back().subspan(1));
+			expected.emplace_back(expected.back().begin() + 1, expected.back().end());
+		}
+		auto all = std::vector<std::string>(rv.values().begin(), rv.values().end());
+		rv.push_back(rv.values());
+		expected.push_back(all);
+		CHECK(rv.size() == static_cast<std::ptrdiff_t>(expected.size()));
+		CHECK(rv == ragged_vector<std::string>{expected});
+	}
+	return test_result();
+}
@@ -0,0 +1,164 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/detail/simd.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+using ranges::ext::simd;
+using ranges::ext::simd_mask;
+
+static_assert(ranges::ext::simd_element<float>);
+static_assert(ranges::ext::simd_element<std::uint8_t>);
+static_assert(!ranges::ext::simd_element<bool>);
+static_assert(!ranges::ext::simd_element<long double>);
+static_assert(simd<int>::size() == ranges::ext::simd_native_lanes<int>);
+static_assert(sizeof(simd<float, 8>) == 8 * sizeof(float));
+static_assert(std::is_trivially_copyable_v<simd<double, 4>>);
+
+namespace {
+	// Exercises every operation on simd<T, N> against a scalar model.
+	template<class T, int N>
+	void check() {
+		using V = simd<T, N>;
+		alignas(sizeof(V)) T a[N];
+		T b[N];
+		for (int i = 0; i < N; ++i) {
+			a[i] = static_cast<T>(i % 7 + 1);
+			b[i] = static_cast<T>(i % 3 == 0 ? 2 : 1);
+		}
+		const auto x = V::load_aligned(a);
+		const auto y = V::load(b);
+
+		T out[N] = {};
+		(x + y * T(2) - T(1)).store(out);
+		for (int i = 0; i < N; ++i) CHECK(out[i] == static_cast<T>(a[i] + b[i] * 2 - 1));
+		alignas(sizeof(V)) T aligned_out[N];
+		(x / y).store_aligned(aligned_out);
+		for (int i = 0; i < N; ++i) CHECK(aligned_out[i] == static_cast<T>(a[i] / b[i]));
+
+		// Compare to mask.
+		const auto lt = x < y;
+		std::uint64_t expected_bits = 0;
+		for (int i = 0; i < N; ++i) {
+			CHECK(lt[i] == (a[i] < b[i]));
+			if (a[i] < b[i]) expected_bits |= std::uint64_t{1} << i;
+		}
+		CHECK(lt.bits() == expected_bits);
+		CHECK(lt.count() == std::popcount(expected_bits));
+		CHECK(lt.any());
+		CHECK(!lt.all());
+		CHECK((x == x).all());
+		CHECK((x != x).none());
+		CHECK((lt | !lt).all());
+		CHECK((lt & !lt).none());
+		CHECK((lt ^ lt).none());
+		CHECK(simd_mask<T, N>{true}.all());
+		CHECK(simd_mask<T, N>{false}.none());
+
+		// Blend.
+		const auto m = blend(lt, x, y);
+		for (int i = 0; i < N; ++i) CHECK(m[i] == (a[i] < b[i] ? a[i] : b[i]));
+
+		// Reduce.
+		T sum = 0;
+		for (int i = 0; i < N; ++i) sum = static_cast<T>(sum + a[i]);
+		CHECK(x.reduce() == sum);
+		CHECK(V{T(1)}.reduce(std::multiplies<>{}) == T(1));
+
+		// Compress.
+		T packed[N] = {};
+		T* end = x.compress_store(lt, packed);
+		CHECK((end - packed) == lt.count());
+		for (int i = 0, j = 0; i < N; ++i) {
+			if (a[i] < b[i]) CHECK(packed[j++] == a[i]);
+		}
+		CHECK(x.compress_store(simd_mask<T, N>{false}, packed) == packed);
+
+		// Gather and shuffle by table, reversing.
+		using I = ranges::detail::__simd_mask_element_t<T>;
+		const simd<I, N> reversed{[](int i) { return N - 1 - i; }};
+		const auto g = V::gather(a, reversed);
+		const auto s = x.shuffle(reversed);
+		for (int i = 0; i < N; ++i) {
+			CHECK(g[i] == a[N - 1 - i]);
+			CHECK(s[i] == a[N - 1 - i]);
+		}
+		if constexpr (sizeof(T) <= 4) {
+			const simd<std::int32_t, N> wide{[](int i) { return i / 2; }};
+			const auto h = V::gather(a, wide);
+			for (int i = 0; i < N; ++i) CHECK(h[i] == a[i / 2]);
+		}
+
+		if constexpr (std::is_integral_v<T>) {
+			const auto bitwise = ((x & y) | (x ^ T(1))) << 1;
+			for (int i = 0; i < N; ++i) {
+				CHECK(bitwise[i] == static_cast<T>(((a[i] & b[i]) | (a[i] ^ 1)) << 1));
+			}
+			CHECK(((x % y)[N - 1]) == static_cast<T>(a[N - 1] % b[N - 1]));
+		}
+	}
+
+	template<class T>
+	void check_all() {
+		check<T, 2>();
+		check<T, 4>();
+		check<T, 8>();
+		check<T, 16>();
+		if constexpr (sizeof(T) <= 2) {
+			check<T, 32>();
+		}
+		if constexpr (sizeof(T) == 1) {
+			check<T, 64>();
+		}
+	}
+}
+
+int main() {
+	check_all<std::int8_t>();
+	check_all<std::uint8_t>();
+	check_all<std::int16_t>();
+	check_all<std::int32_t>();
+	check_all<std::uint32_t>();
+	check_all<std::int64_t>();
+	check_all<float>();
+	check_all<double>();
+
+	{
+		// Generator construction and compound assignment.
+		simd<int, 8> v{[](int i) { return i; }};
+		v += 10;
+		v *= 2;
+		v >>= 1;
+		CHECK(v[0] == 10);
+		CHECK(v[7] == 17);
+		CHECK(v.reduce() == 108);
+		CHECK((-v)[1] == -11);
+	}
+	{
+		// A kernel written once over the native width.
+		std::vector<float> in(1003), out(1003);
+		for (std::size_t i = 0; i < in.size(); ++i) in[i] = static_cast<float>(i) - 500;
+		using V = simd<float>;
+		std::size_t i = 0;
+		for (; i + V::size() <= in.size(); i += V::size()) {
+			const auto x = V::load(in.data() + i);
+			blend(x < 0.0f, -x, x).store(out.data() + i);
+		}
+		for (; i < in.size(); ++i) out[i] = in[i] < 0 ? -in[i] : in[i];
+		for (std::size_t j = 0; j < in.size(); ++j) CHECK(out[j] == (in[j] < 0 ? -in[j] : in[j]));
+	}
+
+	return test_result();
+}
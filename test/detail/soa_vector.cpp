@@ -0,0 +1,179 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/soa_vector.hpp>
+
+#include <memory>
+#include <new>
+#include <string>
+#include <tuple>
+
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/partition.hpp>
+#include <stl2/detail/algorithm/remove_if.hpp>
+#include <stl2/detail/algorithm/reverse.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/detail/algorithm/stable_partition.hpp>
+#include <stl2/detail/algorithm/unique.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	constexpr auto key = [](auto&& r) { return std::get<0>(r); };
+
+	// Default construction throws once the budget runs out.
+	struct fragile {
+		static inline int budget = -1;
+		int value = 0;
+		fragile() {
+			if (budget == 0) throw std::bad_alloc{};
+			if (budget > 0) --budget;
+		}
+	};
+}
+
+int main() {
+	using ranges::ext::soa_vector;
+	using I = soa_vector<int, std::string>::iterator;
+	static_assert(ranges::random_access_iterator<I>);
+	static_assert(ranges::permutable<I>);
+	static_assert(ranges::sortable<I>);
+	static_assert(ranges::random_access_iterator<soa_vector<int, std::string>::const_iterator>);
+	static_assert(ranges::random_access_range<soa_vector<int, std::string>>);
+	static_assert(ranges::sized_range<soa_vector<int, std::string>>);
+	static_assert(ranges::same_as<ranges::iter_common_reference_t<I>,
+		ranges::ext::soa_reference<const int&, const std::string&>>);
+	{
+		soa_vector<int, std::string> sv;
+		CHECK(sv.empty());
+		sv.emplace_back(3, "three");
+		sv.emplace_back(1, "one");
+		sv.push_back({4, "four"});
+		sv.emplace_back(1, "uno");
+		sv.emplace_back(5, "five");
+		CHECK(sv.size() == 5);
+		CHECK_EQUAL(sv.column<0>(), {3, 1, 4, 1, 5});
+		static_assert(ranges::contiguous_range<decltype(sv.column<0>())>);
+		CHECK(std::get<1>(sv[2]) == "four");
+
+		auto front = sv.front();
+		std::get<1>(front) = "THREE";
+		CHECK(sv.column<1>()[0] == "THREE");
+
+		ranges::sort(sv, ranges::less{}, key);
+		CHECK_EQUAL(sv.column<0>(), {1, 1, 3, 4, 5});
+		CHECK(sv.column<1>()[2] == "THREE");
+		CHECK(sv.column<1>()[4] == "five");
+		CHECK(ranges::is_sorted(sv));
+
+		ranges::reverse(sv);
+		CHECK_EQUAL(sv.column<0>(), {5, 4, 3, 1, 1});
+		CHECK(sv.column<1>()[0] == "five");
+
+		auto u = ranges::unique(sv, ranges::equal_to{}, key);
+		sv.erase(u, sv.end());
+		CHECK_EQUAL(sv.column<0>(), {5, 4, 3, 1});
+		CHECK(sv.column<1>().size() == 4);
+
+		auto odd = [](auto&& r) { return std::get<0>(r) % 2 != 0; };
+		auto p = ranges::partition(sv, odd);
+		CHECK((p - sv.begin()) == 3);
+		CHECK(std::get<0>(sv[3]) == 4);
+		CHECK(std::get<1>(sv[3]) == "four");
+
+		auto r = ranges::remove_if(sv, [](auto&& r) { return std::get<0>(r) == 3; });
+		sv.erase(r, sv.end());
+		CHECK(sv.size() == 3);
+		for (auto&& [i, s] : sv) {
+			CHECK(i != 3);
+			CHECK(s != "THREE");
+		}
+
+		const auto& csv = sv;
+		std::tuple<int, std::string> v = *csv.begin();
+		CHECK(std::get<0>(v) == std::get<0>(sv[0]));
+	}
+	{
+		// Move-only members are moved, not copied, by the algorithms.
+		soa_vector<std::unique_ptr<int>, int> sv;
+		for (int i : {2, 0, 1}) {
+			sv.emplace_back(std::make_unique<int>(i), i);
+		}
+		ranges::sort(sv, ranges::less{}, [](auto&& r) { return std::get<1>(r); });
+		for (int i = 0; i < 3; ++i) {
+			CHECK(*sv.column<0>()[i] == i);
+		}
+		sv.pop_back();
+		CHECK(sv.size() == 2);
+	}
+	{
+		// bool members are stored unpacked, in a contiguous column.
+		soa_vector<int, bool> sv;
+		for (int i = 0; i < 20; ++i) {
+			sv.emplace_back(i, i % 3 == 0);
+		}
+		static_assert(ranges::same_as<decltype(sv.column<1>()), ranges::ext::span<bool>>);
+		CHECK(sv.column<1>()[9]);
+		CHECK(!sv.column<1>()[10]);
+		auto p = ranges::stable_partition(sv, [](auto&& r) { return std::get<1>(r); });
+		CHECK((p - sv.begin()) == 7);
+		CHECK_EQUAL(sv.column<0>(), {0, 3, 6, 9, 12, 15, 18,
+			1, 2, 4, 5, 7, 8, 10, 11, 13, 14, 16, 17, 19});
+		CHECK(ranges::count(sv.column<1>(), true) == 7);
+		sv.push_back({20, std::get<1>(sv[0])});
+		CHECK(std::get<1>(sv.back()));
+		auto copy = sv;
+		CHECK(copy == sv);
+		std::get<1>(copy.back()) = false;
+		CHECK(copy != sv);
+		sv.erase(sv.begin() + 7, sv.end());
+		sv.resize(9);
+		CHECK_EQUAL(sv.column<1>(), {true, true, true, true, true, true, true, false, false});
+		sv.shrink_to_fit();
+		CHECK(sv.capacity() == 9);
+	}
+	{
+		// A resize that throws part way leaves every column as it was.
+		soa_vector<int, fragile, std::string> sv(3);
+		std::get<0>(sv[2]) = 42;
+		fragile::budget = 5;
+		try {
+			sv.resize(10);
+			CHECK(false);
+		} catch (const std::bad_alloc&) {}
+		fragile::budget = -1;
+		CHECK(sv.size() == 3);
+		CHECK(sv.column<0>().size() == 3);
+		CHECK(sv.column<1>().size() == 3);
+		CHECK(sv.column<2>().size() == 3);
+		CHECK(std::get<0>(sv.back()) == 42);
+		sv.resize(10);
+		CHECK(sv.column<2>().size() == 10);
+	}
+	{
+		// stable_partition moves whole rows through its buffer and its
+		// rotations, which go by way of iter_move on every column.
+		soa_vector<int, std::unique_ptr<int>, std::string> sv;
+		for (int i = 0; i < 100; ++i) {
+			sv.emplace_back(i, std::make_unique<int>(i), std::to_string(i));
+		}
+		auto p = ranges::stable_partition(sv, [](auto&& r) { return std::get<0>(r) % 3 == 0; });
+		CHECK((p - sv.begin()) == 34);
+		bool ok = true;
+		for (int k = 0; k < 100; ++k) {
+			const int i = k < 34 ? 3 * k : (k - 34) / 2 * 3 + 1 + (k - 34) % 2;
+			ok = ok && sv.column<0>()[k] == i && sv.column<1>()[k] &&
+				*sv.column<1>()[k] == i && sv.column<2>()[k] == std::to_string(i);
+		}
+		CHECK(ok);
+	}
+	return test_result();
+}
@@ -0,0 +1,82 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/static_map.hpp>
+
+#include <string>
+#include <string_view>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+using namespace std::literals;
+
+namespace {
+	enum class color { red, green, blue, cyan, magenta, yellow };
+
+	constexpr auto keywords = ranges::ext::make_static_map<std::string_view, int>({
+		{"if", 1}, {"else", 2}, {"while", 3}, {"for", 4}, {"do", 5},
+		{"return", 6}, {"break", 7}, {"continue", 8}, {"switch", 9},
+		{"case", 10}, {"default", 11}, {"goto", 12}, {"", 13},
+	});
+	static_assert(decltype(keywords)::hashed);
+	static_assert(keywords.size() == 13);
+	static_assert(keywords["while"] == 3);
+	static_assert(keywords[""] == 13);
+	static_assert(keywords.contains("goto"));
+	static_assert(!keywords.contains("whilst"));
+	static_assert(!keywords.contains("If"));
+
+	constexpr auto names = ranges::ext::make_static_map<color, std::string_view>({
+		{color::blue, "blue"}, {color::red, "red"}, {color::yellow, "yellow"},
+	});
+	static_assert(names[color::red] == "red");
+	static_assert(!names.contains(color::cyan));
+
+	constexpr auto squares = [] {
+		std::pair<int, int> entries[5000]{};
+		for (int i = 0; i < 5000; ++i) entries[i] = {i * 7, i * i};
+		return ranges::ext::make_static_map(entries);
+	}();
+	static_assert(!decltype(squares)::hashed);
+	static_assert(squares[70] == 100);
+	static_assert(!squares.contains(71));
+
+	constexpr auto ints = [] {
+		std::pair<int, int> entries[1000]{};
+		for (int i = 0; i < 1000; ++i) entries[i] = {i * 1000003, -i};
+		return ranges::ext::make_static_map(entries);
+	}();
+	static_assert(decltype(ints)::hashed);
+	static_assert(ints[999 * 1000003] == -999);
+}
+
+int main() {
+	// Lookups with runtime keys.
+	std::string s = "continue";
+	CHECK(keywords[s] == 8);
+	s += "d";
+	CHECK(keywords.find(s) == keywords.end());
+	CHECK(!keywords.contains("els"sv));
+	int sum = 0;
+	for (auto&& [k, v] : keywords) {
+		CHECK(keywords[k] == v);
+		sum += v;
+	}
+	CHECK(sum == 91);
+
+	for (int i = 0; i < 1000; ++i) {
+		CHECK(ints[i * 1000003] == -i);
+		CHECK(!ints.contains(i * 1000003 + 1));
+	}
+	for (int i = 0; i < 5000; i += 7) {
+		CHECK(squares[i * 7] == i * i);
+	}
+	CHECK(names.find(color::magenta) == names.end());
+	return test_result();
+}
@@ -1,4 +1,6 @@
+#define STL2_HUGE_PAGE_TEMPORARY_BUFFERS 1
 #include <stl2/detail/temporary_vector.hpp>
+#include <cstdint>
 #include "../simple_test.hpp"
 
 namespace ranges = __stl2;
@@ -29,9 +31,27 @@ namespace {
 	void test_alignments() {
 		(test_single_alignment<Alignments>(), ...);
 	}
+
+	void test_huge_pages() {
+		// Large requests are rounded up to whole 2 MB pages.
+		constexpr std::ptrdiff_t n = (3 << 20) / sizeof(double);
+		auto buf = temporary_buffer<double>{n};
+		CHECK(buf.size() >= n);
+		if (STL2_HAVE_HUGE_PAGES && buf.size() > n) {
+			CHECK(buf.size() == (4 << 20) / static_cast<std::ptrdiff_t>(sizeof(double)));
+			CHECK((reinterpret_cast<std::uintptr_t>(buf.data()) % ranges::detail::huge_page_size) == 0u);
+		}
+		buf.data()[0] = 1.0;
+		buf.data()[n - 1] = 2.0;
+		CHECK(buf.data()[n - 1] == 2.0);
+
+		auto small = temporary_buffer<int>{10};
+		CHECK(small.size() == 10);
+	}
 }
 
 int main() {
 	test_alignments<1, 2, 4, 8, 16, 32, 64, 128>();
+	test_huge_pages();
 	return ::test_result();
 }
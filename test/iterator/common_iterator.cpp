@@ -12,6 +12,7 @@
 //
 #include <algorithm>
 #include <numeric>
+#include <variant>
 #include <stl2/iterator.hpp>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
@@ -103,6 +104,48 @@ namespace {
 		constexpr CCI baz{foo};
 		constexpr CCI bang{bar};
 	}
+
+	void test_compact() {
+		using ranges::common_iterator;
+		using ranges::counted_iterator;
+		using ranges::default_sentinel_t, ranges::default_sentinel;
+
+		// Stateless sentinels are stored as a flag beside the iterator.
+		using CI = common_iterator<counted_iterator<int*>, default_sentinel_t>;
+		static_assert(sizeof(CI) <=
+			sizeof(std::variant<counted_iterator<int*>, default_sentinel_t>));
+		static_assert(ranges::forward_iterator<CI>);
+		static_assert(ranges::sized_sentinel_for<CI, CI>);
+
+		int rg[] = {0,1,2,3,4};
+		CI first{counted_iterator{rg, 5}};
+		CI last{default_sentinel};
+		CHECK(first != last);
+		CHECK((last - first) == 5);
+		CHECK((first - last) == -5);
+		CHECK((last - last) == 0);
+
+		CI i = first;
+		CHECK(i == first);
+		i = last;
+		CHECK(i == last);
+		i = first;
+		CHECK(*i == 0);
+		++i;
+		CHECK(*i == 1);
+		CHECK(i != first);
+
+		CHECK(ranges::ext::peelable(first, last));
+		CHECK(!ranges::ext::peelable(last, last));
+		CHECK(!ranges::ext::peelable(first, first));
+		CHECK(ranges::ext::peel_iterator(first).count() == 5);
+
+		using CCI = common_iterator<counted_iterator<const int*>, default_sentinel_t>;
+		CCI ci = first;
+		CHECK(ci == first);
+		ci = last;
+		CHECK(ci == last);
+	}
 }
 
 int main() {
@@ -181,6 +224,7 @@ int main() {
 	}
 	test_operator_arrow();
 	test_constexpr();
+	test_compact();
 
 	return test_result();
 }
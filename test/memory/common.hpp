@@ -18,6 +18,7 @@
 #include <string>
 #include <stl2/memory.hpp>
 #include <stl2/utility.hpp>
+#include <stl2/detail/execution.hpp>
 
 template<typename T>
 class raw_buffer {
@@ -121,4 +122,8 @@ private:
 template<typename T>
 using Array = std::array<T, 8>;
 
+// For the parallel overloads: chunks small enough that the test inputs are
+// really split among the threads.
+inline constexpr __stl2::ext::execution::parallel_policy par4{4, 16};
+
 #endif // COMMON_HPP
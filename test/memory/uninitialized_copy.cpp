@@ -48,6 +48,9 @@ namespace {
 
 			test(in, out, ranges::uninitialized_copy_n(in.begin(), in.size(), out.begin(), out.end()));
 			test(in, out, ranges::uninitialized_copy_n(in.cbegin(), in.size(), out.cbegin(), out.cend()));
+
+			test(in, out, ranges::uninitialized_copy(par4, in.begin(), in.end(), out.begin(), out.end()));
+			test(in, out, ranges::uninitialized_copy(par4, in, out));
 		};
 
 		// check range-based when distance(rng1) == distance(rng2)
@@ -49,6 +49,8 @@ namespace {
 		test(independent, ranges::uninitialized_default_construct(std::as_const(independent)));
 		test(independent, ranges::uninitialized_default_construct_n(independent.begin(), independent.size()));
 		test(independent, ranges::uninitialized_default_construct_n(independent.cbegin(), independent.size()));
+		test(independent, ranges::uninitialized_default_construct(par4, independent.begin(), independent.end()));
+		test(independent, ranges::uninitialized_default_construct(par4, independent));
 	}
 
 	template<typename T>
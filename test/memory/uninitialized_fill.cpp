@@ -12,6 +12,7 @@
 //
 #include <stl2/detail/memory/uninitialized_fill.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <vector>
 #include <stl2/concepts.hpp>
@@ -40,6 +41,8 @@ namespace {
 		test(ranges::uninitialized_fill(independent, x));
 		test(ranges::uninitialized_fill_n(independent.begin(), independent.size(), x));
 		test(ranges::uninitialized_fill_n(independent.cbegin(), independent.size(), x));
+		test(ranges::uninitialized_fill(par4, independent.begin(), independent.end(), x));
+		test(ranges::uninitialized_fill(par4, independent, x));
 	}
 
 	struct S {
@@ -86,6 +89,34 @@ namespace {
 			CHECK(S::count == S::throw_after);
 		}
 	}
+
+	// Counts live objects, and throws from one copy.
+	struct P {
+		static std::atomic<int> live;
+		static std::atomic<int> copies;
+		static constexpr int throw_on = 700;
+
+		P() { ++live; }
+		P(const P&) {
+			if (++copies == throw_on) throw 42;
+			++live;
+		}
+		~P() { --live; }
+	};
+	std::atomic<int> P::live;
+	std::atomic<int> P::copies;
+
+	void parallel_throw_test() {
+		const auto p = P{};
+		auto independent = make_buffer<P>(test_size);
+		try {
+			ranges::uninitialized_fill(par4, independent, p);
+			CHECK(false);
+		} catch(int) {
+			// Every chunk, complete or not, has been destroyed.
+			CHECK(P::live == 1);
+		}
+	}
 }
 
 int main() {
@@ -97,6 +128,7 @@ int main() {
 	uninitialized_fill_test(Book{});
 
 	throw_test();
+	parallel_throw_test();
 
 	return ::test_result();
 }
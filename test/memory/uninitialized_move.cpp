@@ -96,6 +96,10 @@ namespace {
 			test(to_move, out,
 				ranges::uninitialized_move_n(to_move.begin(), to_move.size(),
 				out.cbegin(), out.cend()));
+
+			to_move = in;
+			test(to_move, out,
+				ranges::uninitialized_move(par4, to_move, out));
 		};
 
 		// check range-based when distance(rng1) == distance(rng2)
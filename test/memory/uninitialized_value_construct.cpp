@@ -47,6 +47,8 @@ namespace {
 		test(ranges::uninitialized_value_construct(independent));
 		test(ranges::uninitialized_value_construct_n(independent.begin(), independent.size()));
 		test(ranges::uninitialized_value_construct_n(independent.cbegin(), independent.size()));
+		test(ranges::uninitialized_value_construct(par4, independent.begin(), independent.end()));
+		test(ranges::uninitialized_value_construct(par4, independent));
 	}
 
 	struct S {
@@ -0,0 +1,121 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/bitunpacked.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <vector>
+
+#include <stl2/detail/algorithm/bitpack.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+namespace {
+	template<class T>
+	void round_trip(int bits, std::size_t n, T base) {
+		using U = std::make_unsigned_t<T>;
+		const auto mask = bits == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+		std::vector<T> values;
+		std::uint64_t x = 0x9e3779b97f4a7c15u;
+		for (std::size_t i = 0; i < n; ++i) {
+			x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+			values.push_back(static_cast<T>(static_cast<U>(base) + static_cast<U>(x & mask)));
+		}
+		std::vector<unsigned char> bytes(
+			static_cast<std::size_t>(ranges::ext::bitpack_bytes(static_cast<std::ptrdiff_t>(n), bits)));
+		auto [in, out] = ranges::ext::bitpack(values, bits, bytes.begin(), base);
+		CHECK(in == values.end());
+		CHECK(out == bytes.end());
+
+		ranges::ext::bitunpacked_view<T> v{bytes, bits, static_cast<std::ptrdiff_t>(n), base};
+		CHECK(v.size() == static_cast<std::ptrdiff_t>(n));
+		CHECK(ranges::equal(v, values));
+
+		// Block-wise, into contiguous and other outputs, from any offset.
+		for (std::ptrdiff_t first : {0, 1, 31, 32, 33}) {
+			if (first > static_cast<std::ptrdiff_t>(n)) break;
+			std::vector<T> copied(n - static_cast<std::size_t>(first));
+			auto r = ranges::copy(v.begin() + first, v.end(), copied.begin());
+			CHECK(r.in == v.end());
+			CHECK(r.out == copied.end());
+			CHECK(ranges::equal(copied.begin(), copied.end(), values.begin() + first, values.end()));
+
+			std::deque<T> d(copied.size());
+			ranges::copy(v.begin() + first, v.end(), d.begin());
+			CHECK(ranges::equal(d, copied));
+		}
+
+		T sum = 0;
+		ranges::for_each(v, [&](T t) { sum = static_cast<T>(static_cast<U>(sum) + static_cast<U>(t)); });
+		T expected = 0;
+		for (auto t : values) expected = static_cast<T>(static_cast<U>(expected) + static_cast<U>(t));
+		CHECK(sum == expected);
+
+		auto odd = [](T t) { return (t & 1) != 0; };
+		CHECK(ranges::count_if(v, odd) == ranges::count_if(values, odd));
+		CHECK(ranges::count(v, values[n / 2]) == ranges::count(values, values[n / 2]));
+	}
+}
+
+int main() {
+	using ranges::ext::bitunpacked_view;
+	using V = bitunpacked_view<std::uint32_t>;
+	static_assert(ranges::view<V>);
+	static_assert(ranges::random_access_range<V>);
+	static_assert(ranges::sized_range<V>);
+	static_assert(ranges::common_range<V>);
+	static_assert(ranges::same_as<ranges::range_reference_t<V>, std::uint32_t>);
+	static_assert(ranges::_BlockUnpackable<ranges::iterator_t<V>, ranges::iterator_t<V>>);
+	static_assert(V::max_bits == 32);
+	static_assert(bitunpacked_view<std::int16_t>::max_bits == 16);
+
+	{
+		// Three-bit fields, low bits first.
+		const unsigned char bytes[] = {0b10'001'000, 0b1'100'011'0, 0b111'110'10};
+		auto v = bytes | views::ext::bitunpacked<unsigned>(3);
+		CHECK(v.size() == 8);
+		CHECK(ranges::equal(v, std::vector<unsigned>{0, 1, 2, 3, 4, 5, 6, 7}));
+		CHECK(v[5] == 5u);
+		CHECK(*(v.end() - 1) == 7u);
+
+		unsigned char packed[3];
+		ranges::ext::bitpack(v, 3, packed);
+		CHECK(ranges::equal(packed, bytes));
+	}
+	{
+		// Frame of reference: values less base.
+		const std::vector<std::int32_t> values = {-1000, -998, -1000, -993};
+		std::vector<unsigned char> bytes(2);
+		ranges::ext::bitpack(values, 3, bytes.begin(), -1000);
+		auto v = bytes | views::ext::bitunpacked<std::int32_t>(3, -1000);
+		CHECK(ranges::equal(v.begin(), v.begin() + 4, values.begin(), values.end()));
+	}
+
+	for (int bits : {0, 1, 5, 7, 8, 13, 16, 31, 32}) {
+		for (std::size_t n : {0, 1, 31, 32, 33, 200, 1000}) {
+			round_trip<std::uint32_t>(bits, n, 0);
+		}
+	}
+	for (int bits : {1, 17, 33, 56, 57, 63, 64}) {
+		round_trip<std::uint64_t>(bits, 300, 0);
+	}
+	round_trip<std::int16_t>(9, 500, -300);
+	round_trip<std::int64_t>(40, 500, std::numeric_limits<std::int64_t>::min());
+
+	return test_result();
+}
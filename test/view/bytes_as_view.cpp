@@ -0,0 +1,119 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/bytes_as.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/span.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+namespace {
+	struct record {
+		std::uint16_t id;
+		std::uint8_t flags;
+		double value;
+
+		friend bool operator==(const record& x, const record& y) {
+			return x.id == y.id && x.flags == y.flags && x.value == y.value;
+		}
+		friend bool operator!=(const record& x, const record& y) { return !(x == y); }
+	};
+
+	enum class tag : std::uint32_t { a = 1, b = 0x01020304 };
+}
+
+int main() {
+	using ranges::ext::bytes_as_view;
+	using V = bytes_as_view<record>;
+	static_assert(ranges::view<V>);
+	static_assert(ranges::random_access_range<V>);
+	static_assert(ranges::sized_range<V>);
+	static_assert(ranges::common_range<V>);
+	static_assert(ranges::same_as<ranges::range_reference_t<V>, record>);
+
+	// Rvalue containers would dangle.
+	static_assert(!ranges::invocable<decltype(views::ext::bytes_as<int>), std::vector<char>>);
+	static_assert(ranges::invocable<decltype(views::ext::bytes_as<int>), std::vector<char>&>);
+
+	{
+		// Records at an odd offset in the buffer, as in a packet.
+		const std::vector<record> records = {{1, 2, 3.5}, {4, 5, -6.25}, {7, 8, 1e100}};
+		std::vector<unsigned char> buffer(1 + records.size() * sizeof(record) + 3);
+		std::memcpy(buffer.data() + 1, records.data(), records.size() * sizeof(record));
+
+		auto bytes = ranges::ext::span<const unsigned char>{buffer}.subspan(1);
+		auto x = bytes | views::ext::bytes_as<record>;
+		CHECK(x.size() == 3);
+		CHECK(ranges::equal(x, records));
+		CHECK(x[1].value == -6.25);
+		CHECK((x.end() - 1)[0].value == 1e100);
+	}
+	{
+		// Big-endian integers and floating-point.
+		const std::vector<std::byte> be = {
+			std::byte{0x00}, std::byte{0x00}, std::byte{0x01}, std::byte{0x02},
+			std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04},
+			std::byte{0xff}, std::byte{0xff}, std::byte{0xff}, std::byte{0xfe},
+		};
+		CHECK_EQUAL(be | views::ext::bytes_as_be<std::uint32_t>,
+			{0x0102u, 0x01020304u, 0xfffffffeu});
+		CHECK_EQUAL(be | views::ext::bytes_as_be<std::int32_t>,
+			{0x0102, 0x01020304, -2});
+		CHECK_EQUAL(be | views::ext::bytes_as_be<std::uint16_t>,
+			{0, 0x0102, 0x0102, 0x0304, 0xffff, 0xfffe});
+		CHECK((be | views::ext::bytes_as_be<tag>)[1] == tag::b);
+		CHECK_EQUAL(be | views::ext::bytes_as_le<std::uint32_t>,
+			{0x02010000u, 0x04030201u, 0xfeffffffu});
+
+		const double d = 3.0;
+		unsigned char raw[sizeof(double)];
+		std::memcpy(raw, &d, sizeof(double));
+		if constexpr (std::endian::native == std::endian::little) {
+			for (std::size_t i = 0; i < sizeof(double) / 2; ++i) {
+				std::swap(raw[i], raw[sizeof(double) - 1 - i]);
+			}
+		}
+		CHECK(*views::ext::bytes_as_be<double>(raw).begin() == 3.0);
+	}
+	{
+		// A long run, converted through an algorithm loop.
+		std::vector<std::uint32_t> values(1000);
+		std::vector<unsigned char> buffer(values.size() * 4 + 2);
+		for (std::size_t i = 0; i < values.size(); ++i) {
+			values[i] = static_cast<std::uint32_t>(i * 2654435761u);
+			for (int b = 0; b < 4; ++b) {
+				buffer[i * 4 + static_cast<std::size_t>(b)] =
+					static_cast<unsigned char>(values[i] >> (24 - 8 * b));
+			}
+		}
+		auto x = buffer | views::ext::bytes_as_be<std::uint32_t>;
+		CHECK(x.size() == 1000);
+		std::vector<std::uint32_t> out(values.size());
+		ranges::copy(x, out.begin());
+		CHECK(out == values);
+	}
+	{
+		V empty;
+		CHECK(empty.size() == 0);
+		CHECK(empty.begin() == empty.end());
+		char few[3] = {};
+		CHECK(views::ext::bytes_as<std::uint32_t>(few).empty());
+	}
+
+	return test_result();
+}
@@ -0,0 +1,111 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/cache_all.hpp>
+
+#include <sstream>
+
+#include <stl2/detail/algorithm/binary_search.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/view/filter.hpp>
+#include <stl2/view/istream.hpp>
+#include "../simple_test.hpp"
+#include "../test_iterators.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+int main() {
+	using ranges::view, ranges::sized_range, ranges::common_range;
+	using ranges::random_access_range, ranges::contiguous_range;
+	{
+		// Forward base: positions are cached, the predicate runs once per element.
+		int rg[] = {0,1,2,3,4,5,6,7,8,9};
+		int calls = 0;
+		auto even = [&calls](int i) { ++calls; return i % 2 == 0; };
+		auto x = ranges::subrange{forward_iterator(rg), forward_iterator(rg + 10)}
+			| views::filter(even) | views::ext::cache_all;
+		using X = decltype(x);
+		static_assert(view<X>);
+		static_assert(random_access_range<X>);
+		static_assert(sized_range<X>);
+		static_assert(common_range<X>);
+		static_assert(!contiguous_range<X>);
+		static_assert(std::is_same_v<ranges::range_reference_t<X>, int&>);
+
+		CHECK(calls == 0);
+		CHECK(x.size() == 5u);
+		CHECK(calls == 10);
+		CHECK_EQUAL(x, {0,2,4,6,8});
+		CHECK(ranges::count(x, 4) == 1);
+		CHECK(ranges::binary_search(x, 6));
+		CHECK(!ranges::binary_search(x, 7));
+		CHECK(x[3] == 6);
+		CHECK(calls == 10);
+
+		// Copies share the cache, and writes go through to the base.
+		auto y = x;
+		y[0] = 42;
+		CHECK(rg[0] == 42);
+		CHECK(x[0] == 42);
+		CHECK(calls == 10);
+	}
+	{
+		// Input base: values are buffered contiguously.
+		std::istringstream ss{"5 3 8 1 9"};
+		auto x = views::istream<int>(ss) | views::ext::cache_all;
+		using X = decltype(x);
+		static_assert(view<X>);
+		static_assert(contiguous_range<X>);
+		static_assert(sized_range<X>);
+		CHECK_EQUAL(x, {5,3,8,1,9});
+		CHECK_EQUAL(x, {5,3,8,1,9});
+		CHECK(x.size() == 5u);
+		CHECK(x.data()[2] == 8);
+	}
+	{
+		// Incremental: elements are recorded only as far as they are consumed.
+		int rg[] = {0,1,2,3,4,5,6,7,8,9};
+		int calls = 0;
+		auto odd = [&calls](int i) { ++calls; return i % 2 != 0; };
+		auto x = views::filter(rg, odd) | views::ext::cache_incremental;
+		using X = decltype(x);
+		static_assert(view<X>);
+		static_assert(random_access_range<X>);
+		static_assert(sized_range<X>);
+		static_assert(!common_range<X>);
+
+		auto it = x.begin();
+		CHECK(calls == 0);
+		CHECK(*it == 1);
+		CHECK(calls == 2);
+		CHECK(it[1] == 3);
+		CHECK(calls == 4);
+		CHECK(it != x.end());
+		CHECK(calls == 4);
+		CHECK((it + 2) != x.end());
+		CHECK(calls == 6);
+		CHECK(x.size() == 5u);
+		CHECK(calls == 10);
+		CHECK((x.end() - it) == 5);
+		CHECK((it + 5) == x.end());
+		CHECK_EQUAL(x, {1,3,5,7,9});
+		CHECK(calls == 10);
+	}
+	{
+		std::istringstream ss{"1 2 3"};
+		auto x = views::istream<int>(ss) | views::ext::cache_incremental;
+		auto it = x.begin();
+		CHECK(*it == 1);
+		CHECK(it[2] == 3);
+		CHECK((it + 3) == x.end());
+		CHECK_EQUAL(x, {1,2,3});
+	}
+	return test_result();
+}
@@ -9,6 +9,14 @@
 //
 // Project home: https://github.com/caseycarter/cmcstl2
 //
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/count_if.hpp>
+#include <stl2/detail/algorithm/fill.hpp>
+#include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/find_if_not.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
 #include <stl2/view/common.hpp>
 #include <stl2/view/counted.hpp>
 #include "../simple_test.hpp"
@@ -41,5 +49,35 @@ int main() {
 		static_assert(!bidirectional_range<decltype(x)>);
 		static_assert(same_as<decltype(x), decltype(views::common(x))>);
 	}
+	{
+		// Algorithms peel [common_iterator(i), common_iterator(s)) ranges.
+		int rg[] = {0,1,2,3,4,5,6,7,8,9};
+		auto x = views::counted(forward_iterator(rg), 7) | views::common;
+		auto is_odd = [](int i) { return i % 2 == 1; };
+		CHECK(ranges::count_if(x, is_odd) == 3);
+		CHECK(ranges::count(x, 4) == 1);
+		CHECK(*ranges::find(x, 4) == 4);
+		CHECK(ranges::find(x, 8) == ranges::end(x));
+		CHECK(*ranges::find_if_not(x, is_odd) == 0);
+
+		int sum = 0;
+		auto [i, f] = ranges::for_each(x, [&sum](int j) { sum += j; });
+		CHECK(i == ranges::end(x));
+		CHECK(sum == 21);
+
+		int out[7] = {};
+		auto [in, o] = ranges::copy(x, out);
+		CHECK(in == ranges::end(x));
+		CHECK(o == out + 7);
+		CHECK_EQUAL(out, {0,1,2,3,4,5,6});
+
+		auto [in2, o2] = ranges::transform(x, out, [](int j) { return j * 2; });
+		CHECK(in2 == ranges::end(x));
+		CHECK(o2 == out + 7);
+		CHECK_EQUAL(out, {0,2,4,6,8,10,12});
+
+		CHECK(ranges::fill(x, 42) == ranges::end(x));
+		CHECK_EQUAL(rg, {42,42,42,42,42,42,42,7,8,9});
+	}
 	return test_result();
 }
@@ -10,6 +10,13 @@
 // Project home: https://github.com/caseycarter/cmcstl2
 //
 #include <stl2/view/counted.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
+#include <stl2/detail/algorithm/copy_n.hpp>
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/fill.hpp>
+#include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
+#include <stl2/detail/algorithm/transform.hpp>
 #include "../simple_test.hpp"
 #include "../test_iterators.hpp"
 
@@ -38,5 +45,44 @@ int main() {
 		static_assert(forward_range<decltype(x)>);
 		static_assert(!bidirectional_range<decltype(x)>);
 	}
+	{
+		// Contiguous counted ranges are processed as [i, i + n).
+		int rg[] = {0,1,2,3,4,5,6,7,8,9,0,1,2,3,4,5,6,7,8,9};
+		auto first = ranges::counted_iterator{rg + 2, 10};
+		auto last = ranges::default_sentinel;
+
+		auto f = ranges::find(first, last, 5);
+		CHECK(f.base() == rg + 5);
+		CHECK(f.count() == 7);
+		f = ranges::find(first, last, 42);
+		CHECK(f == last);
+		CHECK(f.base() == rg + 12);
+		CHECK(ranges::count(first, last, 2) == 1);
+
+		int sum = 0;
+		auto fe = ranges::for_each(first, last, [&](int i) { sum += i; });
+		CHECK(fe.in == last);
+		CHECK(sum == 2+3+4+5+6+7+8+9+0+1);
+
+		int out[10] = {};
+		auto c = ranges::copy(first, last, out);
+		CHECK(c.in.base() == rg + 12);
+		CHECK(c.out == out + 10);
+		CHECK_EQUAL(out, {2,3,4,5,6,7,8,9,0,1});
+
+		auto t = ranges::transform(first, last, out, [](int i) { return i * 2; });
+		CHECK(t.in.count() == 0);
+		CHECK_EQUAL(out, {4,6,8,10,12,14,16,18,0,2});
+
+		auto cn = ranges::copy_n(first, 4, out);
+		CHECK(cn.in.base() == rg + 6);
+		CHECK(cn.in.count() == 6);
+		CHECK(cn.out == out + 4);
+		CHECK_EQUAL(out, {2,3,4,5,12,14,16,18,0,2});
+
+		auto fi = ranges::fill(ranges::counted_iterator{out, 3}, last, 7);
+		CHECK(fi.base() == out + 3);
+		CHECK_EQUAL(out, {7,7,7,5,12,14,16,18,0,2});
+	}
 	return test_result();
 }
@@ -0,0 +1,115 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/delta_decode.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <stl2/detail/algorithm/delta_encode.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/view/iota.hpp>
+#include <stl2/view/take_while.hpp>
+#include <stl2/view/transform.hpp>
+#include <stl2/view/varint_decode.hpp>
+#include <stl2/detail/algorithm/varint_encode.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+int main() {
+	using ranges::ext::delta_decode_view;
+	{
+		using V = delta_decode_view<ranges::ref_view<std::vector<int>>>;
+		static_assert(ranges::view<V>);
+		static_assert(ranges::forward_range<V>);
+		static_assert(ranges::sized_range<V>);
+		static_assert(ranges::common_range<V>);
+		static_assert(ranges::same_as<ranges::range_reference_t<V>, int>);
+	}
+	{
+		std::vector<int> values = {3, 7, 7, 12, 4, -2, 100};
+		std::vector<int> deltas(values.size());
+		ranges::ext::delta_encode(values, deltas.begin());
+		CHECK(ranges::equal(deltas, std::vector<int>{3, 4, 0, 5, -8, -6, 102}));
+
+		auto v = deltas | views::ext::delta_decode;
+		CHECK(v.size() == values.size());
+		CHECK(ranges::equal(v, values));
+
+		// In place, and with a starting value.
+		ranges::ext::delta_encode(values, values.begin(), 1);
+		CHECK(ranges::equal(values, std::vector<int>{2, 4, 0, 5, -8, -6, 102}));
+		CHECK(ranges::equal(delta_decode_view{values, 1},
+			std::vector<int>{3, 7, 7, 12, 4, -2, 100}));
+	}
+	{
+		// Unsigned deltas wrap.
+		const std::uint32_t values[] = {10, 5, 4000000000u};
+		std::uint32_t deltas[3];
+		ranges::ext::delta_encode(values, deltas);
+		CHECK(ranges::equal(deltas | views::ext::delta_decode, values));
+	}
+	{
+		// Signed extremes: the differences overflow, and wrap.
+		using L = std::numeric_limits<int>;
+		const int values[] = {L::min(), L::max(), L::min(), 0, L::max(), -1, L::min()};
+		int deltas[7];
+		ranges::ext::delta_encode(values, deltas);
+		CHECK(deltas[1] == -1);
+		CHECK(deltas[2] == 1);
+		CHECK(ranges::equal(deltas | views::ext::delta_decode, values));
+
+		const std::int8_t small[] = {-128, 127, -128, 127};
+		std::int8_t small_deltas[4];
+		ranges::ext::delta_encode(small, small_deltas, std::int8_t{1});
+		CHECK(ranges::equal(delta_decode_view{small_deltas, std::int8_t{1}}, small));
+	}
+	{
+		// A sorted posting list as delta-varints.
+		std::vector<std::uint32_t> postings;
+		for (std::uint32_t i = 0, d = 1; i < 1000000; i += d, d = d * 3 % 1009 + 1) {
+			postings.push_back(i);
+		}
+		std::vector<std::uint32_t> deltas(postings.size());
+		ranges::ext::delta_encode(postings, deltas.begin());
+		std::vector<unsigned char> bytes(postings.size() * 5);
+		auto out = ranges::ext::varint_encode(deltas, bytes.data()).out;
+		bytes.resize(static_cast<std::size_t>(out - bytes.data()));
+
+		auto v = bytes | views::ext::varint_decode<std::uint32_t> | views::ext::delta_decode;
+		static_assert(ranges::forward_range<decltype(v)>);
+		static_assert(!ranges::common_range<decltype(v)>);
+		CHECK(ranges::equal(v, postings));
+	}
+	{
+		// Each delta is read once, by dereference and increment together.
+		std::vector<int> deltas(100, 2);
+		int reads = 0;
+		auto v = deltas | views::transform([&](int d) { ++reads; return d; })
+			| views::ext::delta_decode;
+		int last = 0;
+		for (auto it = v.begin(); it != v.end(); ++it) {
+			last = *it;
+			CHECK(*it == last);
+		}
+		CHECK(last == 200);
+		CHECK(reads == 100);
+	}
+	{
+		// Not common.
+		auto v = views::iota(1) | views::take_while([](int i) { return i <= 4; })
+			| views::ext::delta_decode;
+		CHECK(ranges::equal(v, std::vector<int>{1, 3, 6, 10}));
+	}
+
+	return test_result();
+}
@@ -0,0 +1,145 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/file_chunks.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <unistd.h>
+
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+namespace {
+	struct temporary_file {
+		std::string path;
+
+		explicit temporary_file(const std::vector<std::byte>& contents) {
+			char name[] = "/tmp/stl2_file_chunksXXXXXX";
+			const int fd = ::mkstemp(name);
+			CHECK(fd >= 0);
+			path = name;
+			std::size_t done = 0;
+			while (done < contents.size()) {
+				const auto n = ::write(fd, contents.data() + done, contents.size() - done);
+				CHECK(n > 0);
+				if (n <= 0) break;
+				done += static_cast<std::size_t>(n);
+			}
+			::close(fd);
+		}
+		~temporary_file() { std::remove(path.c_str()); }
+	};
+
+	std::vector<std::byte> make_contents(std::size_t n) {
+		std::vector<std::byte> v(n);
+		for (std::size_t i = 0; i < n; ++i) {
+			v[i] = static_cast<std::byte>((i * 131 + i / 251) & 0xff);
+		}
+		return v;
+	}
+
+	void test_file(std::size_t size, std::size_t chunk_size, unsigned depth,
+		ranges::ext::file_chunks_backend backend)
+	{
+		const auto contents = make_contents(size);
+		const temporary_file file{contents};
+
+		auto chunks = views::ext::file_chunks(file.path, chunk_size, depth, backend);
+		if (backend == ranges::ext::file_chunks_backend::pread_thread) {
+			CHECK(!chunks.uses_io_uring());
+		}
+
+		std::size_t offset = 0;
+		std::size_t count = 0;
+		bool ok = true;
+		for (auto chunk : chunks) {
+			const auto n = static_cast<std::size_t>(chunk.size());
+			ok = ok && (n == chunk_size || offset + n == size);
+			// Checked chunk by chunk: a buffer overwritten by a read in
+			// flight would show here.
+			for (std::size_t i = 0; ok && i < n; ++i) {
+				ok = chunk[static_cast<std::ptrdiff_t>(i)] == contents[offset + i];
+			}
+			offset += n;
+			++count;
+		}
+		CHECK(ok);
+		CHECK(offset == size);
+		CHECK(count == (size + chunk_size - 1) / chunk_size);
+	}
+}
+
+int main() {
+	using ranges::ext::file_chunks_view;
+	using ranges::ext::file_chunks_backend;
+	static_assert(ranges::view<file_chunks_view>);
+	static_assert(ranges::input_range<file_chunks_view>);
+	static_assert(!ranges::forward_range<file_chunks_view>);
+	static_assert(ranges::same_as<ranges::range_value_t<file_chunks_view>,
+		ranges::ext::span<const std::byte>>);
+
+	for (auto backend : {file_chunks_backend::automatic, file_chunks_backend::pread_thread}) {
+		test_file(0, 4096, 2, backend);
+		test_file(100, 4096, 2, backend);
+		test_file(4096 * 8, 4096, 3, backend);
+		test_file(1000003, 4096, 4, backend);
+		test_file(65537, 1000, 1, backend);
+		test_file(12345, 7, 16, backend);
+	}
+
+	{
+		// Abandoning a view with reads in flight.
+		const auto contents = make_contents(1 << 20);
+		const temporary_file file{contents};
+		auto chunks = views::ext::file_chunks(file.path, 4096, 8);
+		auto it = chunks.begin();
+		CHECK(it != ranges::default_sentinel);
+		CHECK((*it).size() == 4096);
+		CHECK((*it)[5] == contents[5]);
+	}
+
+	try {
+		views::ext::file_chunks("/nonexistent/stl2/file", 4096);
+		CHECK(false);
+	} catch (const std::system_error& e) {
+		CHECK(e.code() == std::errc::no_such_file_or_directory);
+	}
+
+	{
+		const temporary_file file{make_contents(100)};
+		try {
+			views::ext::file_chunks(file.path, SIZE_MAX / 2, 2);
+			CHECK(false);
+		} catch (const std::system_error& e) {
+			CHECK(e.code() == std::errc::value_too_large);
+		}
+
+		// The file is closed when the buffer cannot be allocated.
+		const int before = ::dup(0);
+		::close(before);
+		try {
+			views::ext::file_chunks(file.path, SIZE_MAX / 4, 1);
+			CHECK(false);
+		} catch (const std::bad_alloc&) {}
+		const int after = ::dup(0);
+		::close(after);
+		CHECK(after == before);
+	}
+
+	return test_result();
+}
@@ -0,0 +1,117 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#define STL2_INSTRUMENT_VIEWS 1
+#include <stl2/view/instrument.hpp>
+
+#include <list>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <stl2/detail/algorithm/find.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/view/istream.hpp>
+#include <stl2/view/iota.hpp>
+#include <stl2/view/take.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	struct loop {};
+	struct sorting {};
+	struct other {};
+
+	template<class Tag>
+	ranges::ext::instrument_counters& counts() {
+		return ranges::ext::instrument_counts<Tag>();
+	}
+}
+
+int main() {
+	using namespace ranges;
+
+	{
+		std::vector<int> v{1, 2, 3, 4};
+		auto rng = v | views::ext::instrument(loop{});
+		static_assert(view<decltype(rng)>);
+		static_assert(contiguous_range<decltype(rng)>);
+		static_assert(sized_range<decltype(rng)>);
+		static_assert(common_range<decltype(rng)>);
+		static_assert(same_as<range_reference_t<decltype(rng)>, int&>);
+
+		int sum = 0;
+		for (auto i = rng.begin(); i != rng.end(); ++i) sum += *i;
+		CHECK(sum == 10);
+		CHECK(counts<loop>().begins == 1u);
+		CHECK(counts<loop>().increments == 4u);
+		CHECK(counts<loop>().dereferences == 4u);
+		CHECK(counts<loop>().comparisons == 5u);
+		CHECK(counts<loop>().decrements == 0u);
+		CHECK(counts<loop>().advances == 0u);
+		CHECK(counts<other>().begins == 0u);
+
+		counts<loop>().reset();
+		auto i = rng.begin();
+		i += 3;
+		--i;
+		CHECK(*i == 3);
+		CHECK((rng.end() - i) == 2);
+		CHECK(counts<loop>().advances == 1u);
+		CHECK(counts<loop>().decrements == 1u);
+	}
+	{
+		// Counters are per thread.
+		counts<loop>().reset();
+		std::list<int> l{3, 1, 2};
+		auto rng = views::ext::instrument(l, loop{});
+		static_assert(bidirectional_range<decltype(rng)>);
+		static_assert(!random_access_range<decltype(rng)>);
+		std::thread{[&] { CHECK(find(rng, 2) != rng.end()); }}.join();
+		CHECK(counts<loop>().begins == 0u);
+		CHECK(find(rng, 2) != rng.end());
+		CHECK(counts<loop>().begins == 1u);
+		CHECK(counts<loop>().dereferences == 3u);
+	}
+	{
+		// Algorithms see the underlying category.
+		std::vector<int> v;
+		for (int i = 0; i < 1000; ++i) v.push_back((i * 7919) % 1000);
+		auto rng = views::ext::instrument(v, sorting{});
+		sort(rng);
+		CHECK(is_sorted(v));
+		CHECK(counts<sorting>().dereferences > 0u);
+		CHECK(counts<sorting>().comparisons > 0u);
+		CHECK(counts<loop>().begins == 1u);
+	}
+	{
+		// Non-common and input ranges.
+		auto rng = views::iota(0) | views::take(5) | views::ext::instrument(other{});
+		static_assert(!common_range<decltype(rng)>);
+		int n = 0;
+		for (int i : rng) n += i;
+		CHECK(n == 10);
+		CHECK(counts<other>().comparisons == 6u);
+
+		std::istringstream in{"1 2 3"};
+		auto ints = views::istream<int>(in);
+		auto irng = ints | views::ext::instrument(other{});
+		static_assert(input_range<decltype(irng)>);
+		static_assert(!forward_range<decltype(irng)>);
+		counts<other>().reset();
+		n = 0;
+		for (int i : irng) n += i;
+		CHECK(n == 6);
+		CHECK(counts<other>().increments == 3u);
+	}
+
+	return test_result();
+}
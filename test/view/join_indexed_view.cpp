@@ -0,0 +1,91 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/join_indexed.hpp>
+
+#include <string>
+#include <vector>
+
+#include <stl2/detail/algorithm/lower_bound.hpp>
+#include <stl2/detail/algorithm/sort.hpp>
+#include <stl2/view/reverse.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+int main() {
+	using ranges::view, ranges::sized_range, ranges::common_range, ranges::random_access_range;
+	{
+		std::vector<std::vector<int>> vv{{5, 3}, {}, {9, 1, 7}, {}, {}, {2}, {8, 4, 6, 0}, {}};
+		auto x = vv | views::ext::join_indexed;
+		using X = decltype(x);
+		static_assert(view<X>);
+		static_assert(random_access_range<X>);
+		static_assert(random_access_range<const X>);
+		static_assert(sized_range<X>);
+		static_assert(common_range<X>);
+
+		CHECK(x.size() == 10u);
+		CHECK(ranges::distance(x) == 10);
+		CHECK_EQUAL(x, {5,3,9,1,7,2,8,4,6,0});
+		CHECK_EQUAL(x | views::reverse, {0,6,4,8,2,7,1,9,3,5});
+
+		auto it = x.begin();
+		CHECK(it[5] == 2);
+		CHECK(it[9] == 0);
+		it += 4;
+		CHECK(*it == 7);
+		CHECK(it.segment() == 2);
+		++it;
+		CHECK(*it == 2);
+		CHECK(it.segment() == 5);
+		--it;
+		CHECK(*it == 7);
+		it -= 3;
+		CHECK(*it == 3);
+		CHECK((x.end() - it) == 9);
+		CHECK((it + 9) == x.end());
+		CHECK((x.end() - 1)[0] == 0);
+
+		ranges::sort(x);
+		CHECK_EQUAL(x, {0,1,2,3,4,5,6,7,8,9});
+		CHECK_EQUAL(vv[2], {2,3,4});
+		CHECK_EQUAL(vv[6], {6,7,8,9});
+		auto lb = ranges::lower_bound(x, 6);
+		CHECK((lb - x.begin()) == 6);
+		CHECK(lb.segment() == 6);
+
+		const auto& cx = x;
+		CHECK(cx.begin()[3] == 3);
+		decltype(cx.begin()) ci = x.begin() + 7;
+		CHECK(*ci == 7);
+	}
+	{
+		std::vector<std::string> vs{"this","is","his","face"};
+		auto x = views::ext::join_indexed(vs);
+		CHECK_EQUAL(x, {'t','h','i','s','i','s','h','i','s','f','a','c','e'});
+		CHECK(x.size() == 13u);
+	}
+	{
+		std::vector<std::vector<int>> vv{{}, {}};
+		auto x = vv | views::ext::join_indexed;
+		CHECK(x.empty());
+		CHECK(x.begin() == x.end());
+	}
+	{
+		// Default-constructed.
+		ranges::ext::join_indexed_view<ranges::subrange<std::vector<int>*>> x;
+		CHECK(x.size() == 0u);
+		CHECK(x.begin() == x.end());
+		const auto& cx = x;
+		CHECK(cx.begin() == cx.end());
+	}
+	return test_result();
+}
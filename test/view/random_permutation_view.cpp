@@ -0,0 +1,87 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/random_permutation.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/range/concepts.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	// Whether r enumerates each of [0, n) exactly once.
+	template<class R>
+	bool is_permutation_of_iota(R&& r, std::uint64_t n) {
+		std::vector<bool> seen(n);
+		std::uint64_t count = 0;
+		for (auto x : r) {
+			const auto u = static_cast<std::uint64_t>(x);
+			if (u >= n || seen[u]) return false;
+			seen[u] = true;
+			++count;
+		}
+		return count == n;
+	}
+}
+
+int main() {
+	using ranges::views::ext::random_permutation;
+	using V = ranges::ext::random_permutation_view<int>;
+	static_assert(ranges::view<V>);
+	static_assert(ranges::random_access_range<V>);
+	static_assert(ranges::sized_range<V>);
+	static_assert(ranges::common_range<V>);
+	static_assert(ranges::same_as<ranges::range_value_t<V>, int>);
+
+	for (std::uint64_t n : {0u, 1u, 2u, 3u, 4u, 5u, 17u, 1000u, 4096u, 65539u}) {
+		for (std::uint64_t seed : {0u, 1u, 12345u}) {
+			auto p = random_permutation(n, seed);
+			CHECK(p.size() == n);
+			CHECK(is_permutation_of_iota(p, n));
+		}
+	}
+
+	{
+		// Deterministic in (n, seed); seeds give different orders.
+		auto a = random_permutation(1000, 1);
+		auto b = random_permutation(1000, 1);
+		auto c = random_permutation(1000, 2);
+		CHECK(ranges::equal(a, b));
+		CHECK(!ranges::equal(a, c));
+
+		// Not the identity, nor close to it.
+		int fixed = 0;
+		for (int i = 0; i < 1000; ++i) fixed += a[i] == i;
+		CHECK(fixed < 20);
+	}
+	{
+		// Random access agrees with sequential enumeration.
+		auto p = random_permutation(std::int64_t{5000}, 99);
+		auto it = p.begin();
+		for (std::int64_t i = 0; i < 5000; ++i, ++it) {
+			CHECK(*it == p.begin()[i]);
+		}
+		CHECK(it == p.end());
+		CHECK((p.end() - p.begin()) == 5000);
+	}
+	{
+		// Huge domains cost nothing up front.
+		auto p = random_permutation(std::uint64_t{1} << 40, 5);
+		auto x = p[123456789];
+		CHECK(x < (std::uint64_t{1} << 40));
+		CHECK(p[123456789] == x);
+		CHECK(p[0] != p[1]);
+	}
+
+	return test_result();
+}
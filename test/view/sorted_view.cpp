@@ -0,0 +1,116 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/sorted.hpp>
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/is_sorted.hpp>
+#include <stl2/view/single.hpp>
+#include <stl2/view/take.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+int main() {
+	using ranges::view, ranges::sized_range, ranges::common_range, ranges::random_access_range;
+	std::mt19937 gen{42};
+	{
+		constexpr int n = 100000;
+		std::vector<int> v(n);
+		for (auto& i : v) i = static_cast<int>(gen() % 1000000);
+		auto expected = v;
+		std::sort(expected.begin(), expected.end());
+
+		long comparisons = 0;
+		auto counting_less = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+		auto x = v | views::ext::sorted(counting_less);
+		using X = decltype(x);
+		static_assert(view<X>);
+		static_assert(random_access_range<X>);
+		static_assert(sized_range<X>);
+		static_assert(common_range<X>);
+		CHECK(x.size() == n);
+		CHECK(comparisons == 0);
+
+		// The first k elements cost about O(n + k log k): far fewer
+		// comparisons than a full sort's n log n.
+		CHECK(ranges::equal(x | views::take(100),
+			std::vector<int>(expected.begin(), expected.begin() + 100)));
+		CHECK(comparisons < 6 * n);
+
+		CHECK(x.begin()[1000] == expected[1000]);
+		CHECK(ranges::equal(x, expected));
+		CHECK(ranges::is_sorted(v));
+
+		// Progress is shared and complete: no further comparisons.
+		const auto total = comparisons;
+		auto y = x;
+		CHECK(ranges::equal(y, expected));
+		CHECK(comparisons == total);
+	}
+	{
+		// Many equivalent elements.
+		std::vector<int> v(50000);
+		for (auto& i : v) i = static_cast<int>(gen() % 3);
+		auto x = views::ext::sorted(v);
+		const auto zeros = std::count(v.begin(), v.end(), 0);
+		CHECK(x.begin()[zeros - 1] == 0);
+		CHECK(x.begin()[zeros] == 1);
+		CHECK(ranges::is_sorted(x));
+		CHECK(ranges::is_sorted(v));
+	}
+	{
+		// Comparator and projection, descending by second member.
+		std::vector<std::pair<int, int>> v;
+		for (int i = 0; i < 200; ++i) v.emplace_back(i, (i * 37) % 200);
+		auto x = v | views::ext::sorted(ranges::greater{}, &std::pair<int, int>::second);
+		auto it = x.begin();
+		CHECK((*it).second == 199);
+		CHECK(it[1].second == 198);
+		CHECK(x.begin()[199].second == 0);
+		CHECK(ranges::is_sorted(x, ranges::greater{}, &std::pair<int, int>::second));
+	}
+	{
+		// Iterators into the view itself stay valid.
+		auto x = views::ext::sorted(ranges::single_view<int>{42});
+		CHECK(*x.begin() == 42);
+		CHECK(x.size() == 1);
+	}
+	{
+		// Organ-pipe input defeats median-of-three; the depth limit keeps
+		// it to O(n log n) comparisons.
+		constexpr int n = 1 << 16;
+		std::vector<int> v(n);
+		for (int i = 0; i < n; ++i) v[i] = i < n / 2 ? i : n - i;
+		long comparisons = 0;
+		auto counting_less = [&comparisons](int x, int y) { ++comparisons; return x < y; };
+		auto x = views::ext::sorted(v, counting_less);
+		CHECK(ranges::is_sorted(x));
+		CHECK(comparisons < 8L * n * 16);
+	}
+	{
+		std::vector<int> v;
+		auto x = v | views::ext::sorted;
+		CHECK(x.empty());
+		CHECK(x.begin() == x.end());
+
+		// Default-constructed.
+		decltype(x) y;
+		CHECK(y.empty());
+		CHECK(y.size() == 0);
+		CHECK(ranges::distance(y) == 0);
+	}
+	return test_result();
+}
@@ -0,0 +1,75 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/streamvbyte_decode.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/streamvbyte_encode.hpp>
+#include <stl2/detail/range/primitives.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+namespace {
+	void round_trip(const std::vector<std::uint32_t>& values) {
+		const auto n = static_cast<std::ptrdiff_t>(values.size());
+		std::vector<unsigned char> bytes(
+			static_cast<std::size_t>(ranges::ext::streamvbyte_max_bytes(n)));
+		auto [in, out] = ranges::ext::streamvbyte_encode(values, bytes.begin());
+		CHECK(in == values.end());
+		bytes.resize(static_cast<std::size_t>(out - bytes.begin()));
+
+		auto v = bytes | views::ext::streamvbyte_decode(n);
+		CHECK(v.size() == n);
+		CHECK(ranges::distance(v) == n);
+		CHECK(ranges::equal(v, values));
+	}
+}
+
+int main() {
+	using ranges::ext::streamvbyte_decode_view;
+	using V = streamvbyte_decode_view;
+	static_assert(ranges::view<V>);
+	static_assert(ranges::forward_range<V>);
+	static_assert(ranges::sized_range<V>);
+	static_assert(ranges::same_as<ranges::range_reference_t<V>, std::uint32_t>);
+
+	{
+		// One block: lengths 1, 2, 3, 4.
+		const std::uint32_t values[] = {0x11, 0x2233, 0x445566, 0x778899aa};
+		unsigned char bytes[ranges::ext::streamvbyte_max_bytes(4)];
+		auto out = ranges::ext::streamvbyte_encode(values, bytes).out;
+		CHECK((out - bytes) == 11);
+		CHECK(bytes[0] == 0xe4);
+		CHECK(bytes[1] == 0x11);
+		CHECK(bytes[2] == 0x33);
+		CHECK(bytes[3] == 0x22);
+		CHECK(bytes[10] == 0x77);
+		CHECK(ranges::equal(streamvbyte_decode_view{bytes, out - bytes, 4}, values));
+	}
+	round_trip({});
+	round_trip({42});
+	{
+		// Every count modulo four, every length, long enough for the
+		// shuffle kernel.
+		for (std::uint32_t n : {2u, 3u, 5u, 6u, 7u, 8u, 9u, 17u, 18u, 19u, 1000u, 1001u, 1002u, 1003u}) {
+			std::vector<std::uint32_t> values;
+			for (std::uint32_t i = 0; i < n; ++i) {
+				values.push_back((i * 2654435761u) >> (i * 7 % 32));
+			}
+			round_trip(values);
+		}
+	}
+
+	return test_result();
+}
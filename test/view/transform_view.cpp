@@ -14,7 +14,10 @@
 #include <memory>
 #include <vector>
 
+#include <stl2/simd.hpp>
+#include <stl2/detail/algorithm/copy.hpp>
 #include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/for_each.hpp>
 #include <stl2/detail/algorithm/transform.hpp>
 #include <stl2/detail/iterator/insert_iterators.hpp>
 #include <stl2/view/filter.hpp>
@@ -30,6 +33,52 @@ namespace {
 			return (i % 2) == 1;
 		}
 	};
+
+	// Element-wise and simd overloads; counts the simd calls.
+	struct halved {
+		using is_vectorized = void;
+		int* vectors;
+		int operator()(int i) const { return i / 2; }
+		template<int N>
+		ranges::ext::simd<int, N> operator()(ranges::ext::simd<int, N> x) const {
+			++*vectors;
+			return x >> 1;
+		}
+	};
+
+	// Element-wise and batch overloads; counts the batch calls.
+	struct squared {
+		int* batches;
+		long operator()(int i) const { return 1L * i * i; }
+		void operator()(ranges::ext::span<const int> in, ranges::ext::span<long> out) const {
+			++*batches;
+			for (std::ptrdiff_t i = 0; i < in.size(); ++i) out[i] = 1L * in[i] * in[i];
+		}
+	};
+
+	// Returns a reference, so must not be unpacked into copies.
+	struct element {
+		int& operator()(int& i) const { return i; }
+		void operator()(ranges::ext::span<const int> in, ranges::ext::span<int> out) const {
+			for (std::ptrdiff_t i = 0; i < in.size(); ++i) out[i] = in[i];
+		}
+	};
+
+	struct doubled {
+		constexpr int operator()(int i) const { return 2 * i; }
+		void operator()(ranges::ext::span<const int> in, ranges::ext::span<int> out) const {
+			for (std::ptrdiff_t i = 0; i < in.size(); ++i) out[i] = 2 * in[i];
+		}
+	};
+
+	constexpr int constexpr_sum() {
+		int a[] = {1, 2, 3, 4};
+		int sum = 0;
+		auto r = a | ranges::views::transform(doubled{});
+		ranges::for_each(r.begin(), r.end(), [&](int i) { sum += i; });
+		return sum;
+	}
+	static_assert(constexpr_sum() == 20);
 }
 
 int main() {
@@ -65,5 +114,42 @@ int main() {
 		views::iota(0) | views::filter(id) | views::transform(id);
 	}
 
+	{
+		// A contiguous base and a batch overload: unpacked in blocks.
+		int batches = 0;
+		std::vector<int> v(300);
+		for (int i = 0; i < 300; ++i) v[static_cast<std::size_t>(i)] = i;
+		auto sq = v | views::transform(squared{&batches});
+		std::vector<long> out(300);
+		ranges::copy(sq, out.begin());
+		CHECK(batches == 1);
+		for (int i = 0; i < 300; ++i) CHECK(out[static_cast<std::size_t>(i)] == 1L * i * i);
+		CHECK(ranges::count(sq, 100L) == 1);
+		CHECK(batches == 4);
+		CHECK(*(sq.begin() + 7) == 49);
+		CHECK(batches == 4);
+	}
+
+	{
+		// F returning a reference: algorithms see the elements themselves.
+		std::vector<int> v(300, 1);
+		auto refs = v | views::transform(element{});
+		static_assert(!_BlockUnpackable<iterator_t<decltype(refs)>, iterator_t<decltype(refs)>>);
+		ranges::for_each(refs, [](int& i) { i = 2; });
+		CHECK(ranges::count(v, 2) == 300);
+	}
+
+	{
+		// A simd overload: full vectors of each unpacked block.
+		int vectors = 0;
+		std::vector<int> v(1000);
+		for (int i = 0; i < 1000; ++i) v[static_cast<std::size_t>(i)] = i;
+		auto half = v | views::transform(halved{&vectors});
+		std::vector<int> out(1000);
+		ranges::copy(half, out.begin());
+		CHECK(vectors == 1000 / ext::simd_native_lanes<int>);
+		for (int i = 0; i < 1000; ++i) CHECK(out[static_cast<std::size_t>(i)] == i / 2);
+	}
+
 	return ::test_result();
 }
@@ -0,0 +1,70 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/utf8_codepoints.hpp>
+
+#include <string>
+#include <vector>
+
+#include <stl2/detail/algorithm/count.hpp>
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/span.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+int main() {
+	using ranges::ext::utf8_codepoints_view;
+	static_assert(ranges::view<utf8_codepoints_view>);
+	static_assert(ranges::forward_range<utf8_codepoints_view>);
+	static_assert(!ranges::bidirectional_range<utf8_codepoints_view>);
+	static_assert(ranges::same_as<ranges::range_reference_t<utf8_codepoints_view>, char32_t>);
+
+	// Rvalue containers would dangle.
+	static_assert(!ranges::invocable<decltype(views::ext::utf8_codepoints), std::string>);
+
+	{
+		const std::u8string s = u8"Plain ASCII text that spans several vector steps, then "
+			u8"héllo ∑ \U0001F600 and ASCII again.";
+		const std::u32string expected = U"Plain ASCII text that spans several vector steps, then "
+			U"héllo ∑ \U0001F600 and ASCII again.";
+		CHECK(ranges::equal(s | views::ext::utf8_codepoints, expected));
+
+		auto sp = ranges::ext::span<const char8_t>{s.data(), static_cast<std::ptrdiff_t>(s.size())};
+		CHECK(ranges::equal(sp | views::ext::utf8_codepoints, expected));
+	}
+	{
+		// One U+FFFD per maximal subpart.
+		const std::string s = "a\x80" "b\xe2\x82" "c\xf0\x9f\x98\xed\xa0\x80\xff" "d";
+		const std::u32string expected = U"a�" "b�" "c�����" "d";
+		CHECK(ranges::equal(s | views::ext::utf8_codepoints, expected));
+		CHECK(ranges::count(s | views::ext::utf8_codepoints, U'�') == 7);
+	}
+	{
+		// base() locates each code point's code units.
+		const std::string s = "x\xc3\xa9y";
+		auto v = s | views::ext::utf8_codepoints;
+		auto i = v.begin();
+		++i;
+		CHECK(i.base() == reinterpret_cast<const unsigned char*>(s.data() + 1));
+		++i;
+		CHECK(*i == U'y');
+		CHECK(i.base() == reinterpret_cast<const unsigned char*>(s.data() + 3));
+		++i;
+		CHECK(i == v.end());
+	}
+	{
+		std::string empty;
+		auto v = empty | views::ext::utf8_codepoints;
+		CHECK(v.begin() == v.end());
+	}
+
+	return test_result();
+}
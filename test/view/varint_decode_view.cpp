@@ -0,0 +1,118 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+#include <stl2/view/varint_decode.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/algorithm/varint_encode.hpp>
+#include <stl2/detail/span.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+namespace views = ranges::views;
+
+namespace {
+	template<class T>
+	void round_trip(const std::vector<T>& values) {
+		std::vector<unsigned char> bytes(values.size() * ranges::ext::varint_max_bytes<T>);
+		auto [in, out] = ranges::ext::varint_encode(values, bytes.data());
+		CHECK(in == values.end());
+		bytes.resize(static_cast<std::size_t>(out - bytes.data()));
+
+		auto v = bytes | views::ext::varint_decode<T>;
+		CHECK(ranges::equal(v, values));
+	}
+}
+
+int main() {
+	using ranges::ext::varint_decode_view;
+	using V = varint_decode_view<std::uint32_t>;
+	static_assert(ranges::view<V>);
+	static_assert(ranges::forward_range<V>);
+	static_assert(!ranges::bidirectional_range<V>);
+	static_assert(ranges::same_as<ranges::range_reference_t<V>, std::uint32_t>);
+	static_assert(ranges::ext::varint_max_bytes<std::uint32_t> == 5);
+	static_assert(ranges::ext::varint_max_bytes<std::uint64_t> == 10);
+
+	{
+		// The LEB128 examples.
+		const unsigned char bytes[] = {0x02, 0x7f, 0x80, 0x01, 0xe5, 0x8e, 0x26};
+		const std::uint32_t expected[] = {2, 127, 128, 624485};
+		CHECK(ranges::equal(bytes | views::ext::varint_decode<std::uint32_t>, expected));
+
+		unsigned char out[sizeof(bytes)];
+		auto r = ranges::ext::varint_encode(expected, out);
+		CHECK(r.out == out + sizeof(out));
+		CHECK(ranges::equal(out, bytes));
+	}
+	{
+		// Empty input.
+		std::vector<unsigned char> bytes;
+		auto v = bytes | views::ext::varint_decode<std::uint64_t>;
+		CHECK(v.begin() == v.end());
+	}
+	{
+		// Every length, through both the eight-byte and the bytewise paths.
+		std::vector<std::uint64_t> values;
+		for (int shift = 0; shift < 64; ++shift) {
+			values.push_back(std::uint64_t{1} << shift);
+			values.push_back((std::uint64_t{1} << shift) - 1);
+		}
+		values.push_back(std::numeric_limits<std::uint64_t>::max());
+		round_trip(values);
+	}
+	{
+		std::vector<std::uint16_t> values;
+		for (unsigned i = 0; i < 70000; i += 37) {
+			values.push_back(static_cast<std::uint16_t>(i));
+		}
+		round_trip(values);
+	}
+	{
+		// Runs of short values, decoded by the block, broken by long ones.
+		std::vector<std::uint32_t> values;
+		std::uint32_t x = 2463534242u;
+		for (int i = 0; i < 5000; ++i) {
+			x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+			values.push_back(x >> (x % 32));
+		}
+		round_trip(values);
+
+		std::vector<unsigned char> bytes(values.size() * 5);
+		bytes.resize(static_cast<std::size_t>(
+			ranges::ext::varint_encode(values, bytes.data()).out - bytes.data()));
+		auto i = varint_decode_view<std::uint32_t>{bytes}.begin();
+		const unsigned char* p = bytes.data();
+		bool ok = true;
+		for (auto v : values) {
+			ok = ok && i.base() == p && *i == v;
+			unsigned char one[5];
+			p += ranges::ext::varint_encode(ranges::ext::span<const std::uint32_t>{&v, 1}, one).out - one;
+			++i;
+		}
+		CHECK(ok);
+		CHECK(i == ranges::default_sentinel);
+	}
+	{
+		// base() locates the encoded bytes of each value.
+		const unsigned char bytes[] = {0x81, 0x01, 0x05};
+		auto v = ranges::ext::varint_decode_view<std::uint8_t>{bytes, 3};
+		auto i = v.begin();
+		CHECK(i.base() == bytes);
+		++i;
+		CHECK(i.base() == bytes + 2);
+		CHECK(*i == 5);
+	}
+
+	return test_result();
+}
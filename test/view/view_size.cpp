@@ -0,0 +1,117 @@
+// cmcstl2 - A concept-enabled C++ standard library
+//
+//  Use, modification and distribution is subject to the
+//  Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//
+// Project home: https://github.com/caseycarter/cmcstl2
+//
+// Size budgets for views and their iterators: adaptor pipelines should
+// cost no more than the state they actually need.
+//
+#include <vector>
+
+#include <stl2/detail/algorithm/equal.hpp>
+#include <stl2/detail/semiregular_box.hpp>
+#include <stl2/view/filter.hpp>
+#include <stl2/view/iota.hpp>
+#include <stl2/view/ref.hpp>
+#include <stl2/view/take_exactly.hpp>
+#include <stl2/view/transform.hpp>
+#include "../simple_test.hpp"
+
+namespace ranges = __stl2;
+
+namespace {
+	struct is_even {
+		bool operator()(int i) const { return i % 2 == 0; }
+	};
+	struct twice {
+		int operator()(int i) const { return 2 * i; }
+	};
+	struct negate {
+		int operator()(int i) const { return -i; }
+	};
+	struct add {
+		int k;
+		int operator()(int i) const { return i + k; }
+	};
+
+	constexpr auto ptr = sizeof(void*);
+
+	using Ref = ranges::ref_view<std::vector<int>>;
+	using Iota = ranges::iota_view<int>;
+
+	template<class R>
+	constexpr auto iter_size = sizeof(ranges::iterator_t<R>);
+}
+
+// Views nest without padding.
+static_assert(sizeof(Ref) == ptr);
+static_assert(sizeof(ranges::transform_view<Ref, twice>) == ptr);
+static_assert(sizeof(ranges::transform_view<
+	ranges::transform_view<Ref, twice>, negate>) == ptr);
+static_assert(sizeof(ranges::filter_view<Ref, is_even>) == 2 * ptr);
+
+// A stateless function lives in the iterator, not behind a parent pointer.
+static_assert(iter_size<ranges::transform_view<Ref, twice>> == ptr);
+static_assert(iter_size<ranges::transform_view<
+	ranges::transform_view<Ref, twice>, negate>> == ptr);
+static_assert(iter_size<ranges::transform_view<Ref, add>> == 2 * ptr);
+
+// So does a stateless predicate, with an end that fits in a pointer.
+static_assert(iter_size<ranges::filter_view<Ref, is_even>> == 2 * ptr);
+static_assert(iter_size<ranges::filter_view<Iota, is_even>> == iter_size<Iota>);
+
+// Capturing lambdas are boxed without an engaged flag.
+inline constexpr auto capture_int = [k = 1](int i) { return i + k; };
+static_assert(sizeof(ranges::detail::semiregular_box<
+	decltype(capture_int)>) == sizeof(int));
+
+// A four-adaptor pipeline.
+using Pipeline = ranges::transform_view<
+	ranges::filter_view<
+		ranges::transform_view<ranges::filter_view<Ref, is_even>, add>,
+		is_even>,
+	twice>;
+static_assert(sizeof(Pipeline) <= 8 * ptr);
+static_assert(iter_size<Pipeline> <= 4 * ptr);
+
+int main() {
+	using namespace ranges;
+
+	std::vector<int> v{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+	{
+		auto p = v | views::filter(is_even{}) | views::transform(add{2}) |
+			views::filter(is_even{}) | views::transform(twice{});
+		static_assert(same_as<decltype(p), Pipeline>);
+		int expected[] = {4, 8, 12, 16, 20};
+		CHECK(equal(p, expected));
+	}
+	{
+		// Boxes of capturing lambdas: default constructed, then assigned.
+		int k = 10;
+		auto f = [k](int i) { return i + k; };
+		using T = transform_view<Ref, decltype(f)>;
+		T t;
+		t = T{v, f};
+		int expected[] = {10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
+		CHECK(equal(t, expected));
+
+		auto i = t.begin();
+		decltype(i) j;
+		j = i;
+		CHECK(*j == 10);
+	}
+	{
+		auto evens = views::iota(0) | views::filter(is_even{});
+		auto i = evens.begin();
+		CHECK(*i == 0);
+		CHECK(*++i == 2);
+		CHECK(*++i == 4);
+		CHECK(*--i == 2);
+	}
+
+	return test_result();
+}